@@ -1,4 +1,5 @@
 #include "PokemonGo.h"
+#include "intern.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -12,10 +13,19 @@
 #define PRIZE_30 30
 
 struct pokemon_go_t {
+    // The trainers, pokedex and locations maps are allocated in the arena,
+    // as are the lists of the locations added by pokemonGoAddLocation.
+    Arena arena;
+    // The keys of the maps are the names interned here, so a name is kept
+    // once, and the maps compare and hash the keys by their pointers.
+    InternTable names;
     Map trainers_map;
     Map pokedex_map;
     Map locations_map;
     Store store;
+    // Whether every location has its id and nearby ids (see
+    // pokemonGoIndexLocations).
+    bool locations_indexed;
 };
 
 //-------------------------- Auxiliary Functions -------------------------------
@@ -29,7 +39,8 @@ static Trainer trainerGetByName(PokemonGo pokemonGo, char *name);
 /*----------------------------------------------------------------------------*/
 static Location locationGetByName(PokemonGo pokemonGo, char *name);
 /*----------------------------------------------------------------------------*/
-static bool isNearby(PokemonGo pokemonGo, char *curr_location, char *nearby);
+static bool isNearby(PokemonGo pokemonGo, Location location,
+                     Location destination);
 /*----------------------------------------------------------------------------*/
 static int pokemonPrize(Pokemon pokemon);
 /*----------------------------------------------------------------------------*/
@@ -38,11 +49,9 @@ static PokemonGoResult pokemonGoTrainerHunt(PokemonGo pokemonGo,
 /*----------------------------------------------------------------------------*/
 static int itemPrice(char *item_type);
 /*----------------------------------------------------------------------------*/
-static MapKeyElement stringCopy(MapKeyElement src);
+static MapKeyElement nameCopy(MapKeyElement name);
 /*----------------------------------------------------------------------------*/
-static int stringCompare(MapKeyElement dest, MapKeyElement src);
-/*----------------------------------------------------------------------------*/
-static void stringDestroy(MapKeyElement str);
+static void nameDestroy(MapKeyElement name);
 /*----------------------------------------------------------------------------*/
 static MapDataElement trainerMapCopy(MapDataElement trainer);
 /*----------------------------------------------------------------------------*/
@@ -80,6 +89,8 @@ static void handleBattleArgs(PokemonGo pokemonGo, FILE *output_channel,
 /*----------------------------------------------------------------------------*/
 static void executeBattle(PokemonGo pokemonGo, FILE *output_channel,
                           Trainer trainer1, int id1, Trainer trainer2, int id2);
+/*----------------------------------------------------------------------------*/
+static MapResult mapPutAll(Map destination, Map source, InternTable names);
 /**************************** End of declarations *****************************/
 
 /**
@@ -89,13 +100,37 @@ static void executeBattle(PokemonGo pokemonGo, FILE *output_channel,
  * @return - A trainer with the relevant name
  */
 static Trainer trainerGetByName(PokemonGo pokemonGo, char *name) {
-    Trainer trainer = mapGet(pokemonGo->trainers_map, name);
+    Trainer trainer = mapGet(pokemonGo->trainers_map,
+                             internFind(pokemonGo->names, name));
     if (!trainer) {
         return NULL;
     }
     return trainer;
 }
 /*----------------------------------------------------------------------------*/
+/**
+ * Puts copies of all the pairs of a map into another map, with the keys
+ * interned in the names table of the other map.
+ * @param destination - The map to put the pairs into
+ * @param source - The map to copy the pairs of
+ * @param names - The names table the keys of destination are interned in
+ * @return - MAP_OUT_OF_MEMORY if a put failed, MAP_SUCCESS otherwise
+ */
+static MapResult mapPutAll(Map destination, Map source, InternTable names) {
+    MapIterator iterator;
+    MAP_ITER_FOREACH(iterator, source) {
+        char *key = internString(names, mapIterKey(&iterator));
+        if (!key) {
+            return MAP_OUT_OF_MEMORY;
+        }
+        MapResult result = mapPut(destination, key, mapIterData(&iterator));
+        if (result != MAP_SUCCESS) {
+            return result;
+        }
+    }
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
 /**
  * Returns a Location by a given name
  * @param pokemonGo - PokemonGo ADT
@@ -103,7 +138,8 @@ static Trainer trainerGetByName(PokemonGo pokemonGo, char *name) {
  * @return - A Location with the relevant name
  */
 static Location locationGetByName(PokemonGo pokemonGo, char *name) {
-    Location location = mapGet(pokemonGo->locations_map, name);
+    Location location = mapGet(pokemonGo->locations_map,
+                               internFind(pokemonGo->names, name));
     if (!location) {
         return NULL;
     }
@@ -111,16 +147,21 @@ static Location locationGetByName(PokemonGo pokemonGo, char *name) {
 }
 /*----------------------------------------------------------------------------*/
 /**
- * Returns TRUE if destination location is nearby to a given location
+ * Checks if the location dest is nearby to curr_location. Searches the
+ * nearby ids of the location if the locations are indexed, and compares the
+ * names in its nearby list otherwise.
  * @param pokemonGo - PokemonGo ADT
- * @param curr_location - The location to check if dest is near to
- * @param dest - Destination's location
+ * @param location - The location to check if destination is near to
+ * @param destination - Destination's location
  * @return - TRUE if the two locations are nearby, FALSE otherwise
  */
-static bool isNearby(PokemonGo pokemonGo, char *curr_location, char *dest) {
-    Location location = locationGetByName(pokemonGo, curr_location);
-    List nearby_locations = locationGetNearby(location);
-    LIST_FOREACH(char*, nearby_iterator, nearby_locations) {
+static bool isNearby(PokemonGo pokemonGo, Location location,
+                     Location destination) {
+    if (pokemonGo->locations_indexed && locationHasNearbyIds(location)) {
+        return locationIsNearbyId(location, locationGetId(destination));
+    }
+    char *dest = locationGetName(destination);
+    LIST_FOREACH(char*, nearby_iterator, locationGetNearby(location)) {
         if (strcmp(nearby_iterator, dest) == 0) {
             return true;
         }
@@ -191,49 +232,22 @@ static int itemPrice(char *item_type) {
 }
 /*----------------------------------------------------------------------------*/
 /**
- * String copy function to be used for PokemonGo Sub-ADTS.
- * @param src - Source string to be copied
- * @return - A copy of the string.
- *           NULL in case of memory allocation failure or a NULL parameter.
- */
-static MapKeyElement stringCopy(MapKeyElement src) {
-    if (!src) {
-        return NULL;
-    }
-    char *dest = malloc(strlen((char *) src) + 1);
-    if (!dest) {
-        return NULL;
-    }
-    strcpy(dest, (char *) src);
-    return dest;
-}
-/*----------------------------------------------------------------------------*/
-/**
- * Comparsion function for two strings (dest,src)
- * @param dest - Argument 1
- * @param src - Argument 2
- * @return -
- * stringCompare(char* dest, char* src) ==  0     ======>     dest = src
- * stringCompare(char* dest, char* src) ==  > 0   ======>     dest > src
- * stringCompare(char* dest, char* src) ==  < 0   ======>     dest < src
+ * Key copy function of the PokemonGo maps. The keys are names interned in
+ * the names table of PokemonGo, which owns them, so they are not copied.
+ * @param name - An interned name
+ * @return - The name itself.
  */
-static int stringCompare(MapKeyElement dest, MapKeyElement src) {
-    int cmp_res = strcmp((char *) dest, (char *) src);
-    if (cmp_res > 0) {
-        return 1;
-    } else if (cmp_res < 0) {
-        return -1;
-    } else {
-        return 0;
-    }
+static MapKeyElement nameCopy(MapKeyElement name) {
+    return name;
 }
 /*----------------------------------------------------------------------------*/
 /**
- * Memory deallocation function for a given string.
- * @param str
+ * Key deallocation function of the PokemonGo maps. Does nothing, as the
+ * interned names are freed with the names table.
+ * @param name
  */
-static void stringDestroy(MapKeyElement str) {
-    free(str);
+static void nameDestroy(MapKeyElement name) {
+    (void)name;
 }
 /*----------------------------------------------------------------------------*/
 /**
@@ -387,16 +401,12 @@ static PokemonGoResult sortAndPrintItemList(List items_list,
  */
 static void printPokemonsOfTrainer(Map pokemons, FILE *output_channel) {
     mtmPrintPokemonsHeaderForTrainer(output_channel);
-    int cp, level;
-    double hp;
-    char *species;
-    MAP_FOREACH(int*, pokemon_iterator, pokemons) {
-        hp = pokemonGetHp(mapGet(pokemons, pokemon_iterator));
-        level = pokemonGetLevel(mapGet(pokemons, pokemon_iterator));
-        cp = pokemonGetCp(mapGet(pokemons, pokemon_iterator));
-        species = pokemonGetName(mapGet(pokemons, pokemon_iterator));
-        mtmPrintPokemon(output_channel, *pokemon_iterator, species, hp, cp,
-                        level);
+    MapIterator pokemon_iterator;
+    MAP_ITER_FOREACH(pokemon_iterator, pokemons) {
+        Pokemon pokemon = mapIterData(&pokemon_iterator);
+        mtmPrintPokemon(output_channel, *(int*)mapIterKey(&pokemon_iterator),
+                        pokemonGetName(pokemon), pokemonGetHp(pokemon),
+                        pokemonGetCp(pokemon), pokemonGetLevel(pokemon));
     }
 }
 /*----------------------------------------------------------------------------*/
@@ -518,23 +528,38 @@ PokemonGo pokemonGoCreate(PokemonGoResult *error) {
     *error = POKEMON_GO_OUT_OF_MEM;
     PokemonGo pokemonGo = malloc(sizeof(*pokemonGo));
     if (!pokemonGo) return NULL;
-    pokemonGo->trainers_map = mapCreate(stringCopy, trainerMapCopy,
-                                        stringDestroy, trainerMapDestroy,
-                                        stringCompare);
+    pokemonGo->trainers_map = NULL;
+    pokemonGo->pokedex_map = NULL;
+    pokemonGo->locations_map = NULL;
+    pokemonGo->store = NULL;
+    pokemonGo->locations_indexed = false;
+    pokemonGo->arena = arenaCreate();
+    pokemonGo->names = internTableCreate();
+    if (!pokemonGo->arena || !pokemonGo->names) {
+        pokemonGoDestroy(pokemonGo);
+        return NULL;
+    }
+    pokemonGo->trainers_map = mapCreateInArena(nameCopy, trainerMapCopy,
+                                               nameDestroy, trainerMapDestroy,
+                                               internCompare, internHash,
+                                               pokemonGo->arena);
     if (!pokemonGo->trainers_map) {
         pokemonGoDestroy(pokemonGo);
         return NULL;
     }
-    pokemonGo->pokedex_map = mapCreate(stringCopy, pokemonMapCopy,
-                                       stringDestroy, pokemonMapDestroy,
-                                       stringCompare);
+    pokemonGo->pokedex_map = mapCreateInArena(nameCopy, pokemonMapCopy,
+                                              nameDestroy, pokemonMapDestroy,
+                                              internCompare, internHash,
+                                              pokemonGo->arena);
     if (!pokemonGo->pokedex_map) {
         pokemonGoDestroy(pokemonGo);
         return NULL;
     }
-    pokemonGo->locations_map = mapCreate(stringCopy, locationMapCopy,
-                                         stringDestroy, locationMapDestroy,
-                                         stringCompare);
+    pokemonGo->locations_map = mapCreateInArena(nameCopy, locationMapCopy,
+                                                nameDestroy,
+                                                locationMapDestroy,
+                                                internCompare, internHash,
+                                                pokemonGo->arena);
     if (!pokemonGo->locations_map) {
         pokemonGoDestroy(pokemonGo);
         return NULL;
@@ -559,15 +584,27 @@ PokemonGo pokemonGoCopy(PokemonGo pokemonGo, PokemonGoResult* error) {
     if (*error == POKEMON_GO_OUT_OF_MEM) {
         return NULL;
     }
-    copy->pokedex_map = mapCopy(pokemonGo->pokedex_map);
-    if (!copy->pokedex_map) return NULL;
-    copy->locations_map = mapCopy(pokemonGo->locations_map);
-    if (!copy->locations_map) return NULL;
-    copy->trainers_map = mapCopy(pokemonGo->trainers_map);
-    if (!copy->trainers_map) return NULL;
+    // mapCopy would allocate the maps in the arena of pokemonGo and keep the
+    // names of pokemonGo, so the elements are put into the maps of the copy
+    // instead.
+    *error = POKEMON_GO_OUT_OF_MEM;
+    if (mapPutAll(copy->pokedex_map, pokemonGo->pokedex_map, copy->names) !=
+        MAP_SUCCESS ||
+        mapPutAll(copy->locations_map, pokemonGo->locations_map,
+                  copy->names) != MAP_SUCCESS ||
+        mapPutAll(copy->trainers_map, pokemonGo->trainers_map, copy->names) !=
+        MAP_SUCCESS) {
+        pokemonGoDestroy(copy);
+        return NULL;
+    }
+    copy->locations_indexed = pokemonGo->locations_indexed;
     StoreResult store_error;
+    storeDestroy(copy->store);
     copy->store = storeCopy(pokemonGo->store, &store_error);
-    if (!copy->store) return NULL;
+    if (!copy->store) {
+        pokemonGoDestroy(copy);
+        return NULL;
+    }
     *error = POKEMON_GO_SUCCESS;
     return copy;
 }
@@ -577,6 +614,8 @@ void pokemonGoDestroy(PokemonGo pokemonGo) {
     mapDestroy(pokemonGo->locations_map);
     mapDestroy(pokemonGo->pokedex_map);
     storeDestroy(pokemonGo->store);
+    arenaDestroy(pokemonGo->arena);
+    internTableDestroy(pokemonGo->names);
     free(pokemonGo);
 }
 /*----------------------------------------------------------------------------*/
@@ -588,6 +627,27 @@ Map pokemonGoGetLocations(PokemonGo pokemonGo) {
     return pokemonGo->locations_map;
 }
 /*----------------------------------------------------------------------------*/
+Map pokemonGoGetTrainers(PokemonGo pokemonGo) {
+    if (!pokemonGo) {
+        return NULL;
+    }
+    return pokemonGo->trainers_map;
+}
+/*----------------------------------------------------------------------------*/
+char *pokemonGoInternName(PokemonGo pokemonGo, char *name) {
+    if (!pokemonGo) {
+        return NULL;
+    }
+    return internString(pokemonGo->names, name);
+}
+/*----------------------------------------------------------------------------*/
+char *pokemonGoFindName(PokemonGo pokemonGo, char *name) {
+    if (!pokemonGo) {
+        return NULL;
+    }
+    return internFind(pokemonGo->names, name);
+}
+/*----------------------------------------------------------------------------*/
 PokemonGoResult pokemonGoAddLocation(PokemonGo pokemonGo, char *name) {
     if (!pokemonGo || !name) {
         return POKEMON_GO_NULL_ARG;
@@ -596,12 +656,51 @@ PokemonGoResult pokemonGoAddLocation(PokemonGo pokemonGo, char *name) {
         return POKEMON_GO_INVALID_ARG;
     }
     LocationResult error;
-    Location location = locationCreate(name, &error);
+    Location location = locationCreateInArena(name, pokemonGo->arena, &error);
     if (error == LOCATION_OUT_OF_MEM) return POKEMON_GO_OUT_OF_MEM;
-    if (mapPut(pokemonGo->locations_map, name, location) == MAP_OUT_OF_MEMORY) {
+    pokemonGo->locations_indexed = false;
+    char *key = internString(pokemonGo->names, name);
+    if (!key || mapPutOwned(pokemonGo->locations_map, key, location) !=
+                MAP_SUCCESS) {
+        locationDestroy(location);
         return POKEMON_GO_OUT_OF_MEM;
     }
-    locationDestroy(location);
+    return POKEMON_GO_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+PokemonGoResult pokemonGoIndexLocations(PokemonGo pokemonGo) {
+    if (!pokemonGo) {
+        return POKEMON_GO_NULL_ARG;
+    }
+    pokemonGo->locations_indexed = false;
+    int id = 0;
+    MapIterator iterator;
+    MAP_ITER_FOREACH(iterator, pokemonGo->locations_map) {
+        locationSetId(mapIterData(&iterator), id++);
+    }
+    MAP_ITER_FOREACH(iterator, pokemonGo->locations_map) {
+        Location location = mapIterData(&iterator);
+        List nearby = locationGetNearby(location);
+        int *ids = malloc(sizeof(*ids) * (listGetSize(nearby) + 1));
+        if (!ids) {
+            return POKEMON_GO_OUT_OF_MEM;
+        }
+        int ids_num = 0;
+        LIST_FOREACH(char*, nearby_name, nearby) {
+            // Names of locations which don't exist are never reachable.
+            Location nearby_location = locationGetByName(pokemonGo,
+                                                         nearby_name);
+            if (nearby_location) {
+                ids[ids_num++] = locationGetId(nearby_location);
+            }
+        }
+        LocationResult result = locationSetNearbyIds(location, ids, ids_num);
+        free(ids);
+        if (result != LOCATION_SUCCESS) {
+            return POKEMON_GO_OUT_OF_MEM;
+        }
+    }
+    pokemonGo->locations_indexed = true;
     return POKEMON_GO_SUCCESS;
 }
 //-------------------------- Store Functions -----------------------------------
@@ -626,7 +725,8 @@ PokemonGoResult pokemonGoAddItemsToStore(PokemonGo pokemonGo,
 
 PokemonGoResult pokemonGoEvolve(PokemonGo pokemonGo, Pokemon pokemon) {
     Pokemon evolution = mapGet(pokemonGo->pokedex_map,
-                               pokemonGetEvolutionName(pokemon));
+                               internFind(pokemonGo->names,
+                                          pokemonGetEvolutionName(pokemon)));
     int bonus_cp = pokemonGetBonusCp(pokemon);
     int level = pokemonGetLevel(pokemon);
     pokemonSetName(pokemon, pokemonGetName(evolution));
@@ -649,7 +749,7 @@ PokemonGoResult pokemonGoAddTrainer(PokemonGo pokemonGo, FILE *output_channel,
     if (budget < 0 || strlen(name) == 0 || strlen(start_point) == 0) {
         return POKEMON_GO_INVALID_ARG;
     }
-    if (mapContains(pokemonGo->trainers_map, name)) {
+    if (trainerGetByName(pokemonGo, name)) {
         return POKEMON_GO_TRAINER_NAME_ALREADY_EXISTS;
     }
     Location starting_location = locationGetByName(pokemonGo, start_point);
@@ -661,10 +761,13 @@ PokemonGoResult pokemonGoAddTrainer(PokemonGo pokemonGo, FILE *output_channel,
     if (!trainer) {
         return POKEMON_GO_OUT_OF_MEM;
     }
-    if (mapPut(pokemonGo->trainers_map, name, trainer) == MAP_OUT_OF_MEMORY) {
+    // The map takes the trainer as is, instead of a deep copy of it.
+    char *key = internString(pokemonGo->names, name);
+    if (!key || mapPutOwned(pokemonGo->trainers_map, key, trainer) !=
+                MAP_SUCCESS) {
+        trainerDestroy(trainer);
         return POKEMON_GO_OUT_OF_MEM;
     }
-    trainerDestroy(trainer);
     pokemonGoTrainerHunt(pokemonGo, output_channel, name);
     return POKEMON_GO_SUCCESS;
 }
@@ -686,7 +789,9 @@ PokemonGoResult pokemonGoTrainerMoveHunt(PokemonGo pokemonGo,
     if (strcmp((trainerGetLocation(trainer)), go_to) == 0) {
         return POKEMON_GO_TRAINER_ALREADY_IN_LOCATION;
     }
-    if (!isNearby(pokemonGo, trainerGetLocation(trainer), go_to)) {
+    if (!isNearby(pokemonGo,
+                  locationGetByName(pokemonGo, trainerGetLocation(trainer)),
+                  location)) {
         return POKEMON_GO_LOCATION_IS_NOT_REACHABLE;
     }
     trainerSetLocation(trainer, go_to);
@@ -702,7 +807,7 @@ PokemonGoResult pokemonGoTrainerPurchase(PokemonGo pokemonGo,
     if ((strcmp(item, "candy") != 0 && strcmp(item, "potion") != 0) || value <= 0) {
         return POKEMON_GO_INVALID_ARG;
     }
-    Trainer trainer = mapGet(pokemonGo->trainers_map, name);
+    Trainer trainer = trainerGetByName(pokemonGo, name);
     if (!trainer) {
         return POKEMON_GO_TRAINER_DOES_NOT_EXIST;
     }
@@ -723,15 +828,16 @@ pokemonGoTrainerBattle(PokemonGo pokemonGo, FILE *output_channel,
                        char *trainer1_name, int id1,
                        char *trainer2_name, int id2) {
     if (!trainer1_name || !trainer2_name) return POKEMON_GO_NULL_ARG;
-    if (id1 <= 0 || id2 <= 0 || strcmp(trainer1_name, trainer2_name) == 0) {
+    if (id1 <= 0 || id2 <= 0 || strlen(trainer1_name) == 0 ||
+        strlen(trainer2_name) == 0 ||
+        strcmp(trainer1_name, trainer2_name) == 0) {
         return POKEMON_GO_INVALID_ARG;
     }
-    if (!mapContains(pokemonGo->trainers_map, trainer1_name) &&
-        !mapContains(pokemonGo->trainers_map, trainer2_name)) {
+    Trainer trainer1 = trainerGetByName(pokemonGo, trainer1_name);
+    Trainer trainer2 = trainerGetByName(pokemonGo, trainer2_name);
+    if (!trainer1 || !trainer2) {
         return POKEMON_GO_TRAINER_DOES_NOT_EXIST;
     }
-    Trainer trainer1 = mapGet(pokemonGo->trainers_map, trainer1_name);
-    Trainer trainer2 = mapGet(pokemonGo->trainers_map, trainer2_name);
     if (!trainerPokemonExist(trainer1, id1) ||
         !trainerPokemonExist(trainer2, id2)) {
         return POKEMON_GO_POKEMON_DOES_NOT_EXIST;
@@ -745,7 +851,7 @@ PokemonGoResult pokemonGoTrainerHealPokemon(PokemonGo pokemonGo, char *name,
     if (!name) {
         return POKEMON_GO_NULL_ARG;
     }
-    Trainer trainer = mapGet(pokemonGo->trainers_map, name);
+    Trainer trainer = trainerGetByName(pokemonGo, name);
     if (!trainer) {
         return POKEMON_GO_TRAINER_DOES_NOT_EXIST;
     }
@@ -770,7 +876,7 @@ pokemonGoTrainerTrainPokemon(PokemonGo pokemonGo, char *name, int id) {
     if (id < 1) {
         return POKEMON_GO_INVALID_ARG;
     }
-    Trainer trainer = mapGet(pokemonGo->trainers_map, name);
+    Trainer trainer = trainerGetByName(pokemonGo, name);
     if (!trainer) {
         return POKEMON_GO_TRAINER_DOES_NOT_EXIST;
     }
@@ -791,7 +897,7 @@ PokemonGoResult
 pokemonGoReportTrainer(PokemonGo pokemonGo, char *name, FILE *output_channel) {
     if (!pokemonGo || !name || !output_channel) return POKEMON_GO_NULL_ARG;
     if (strlen(name) == 0) return POKEMON_GO_INVALID_ARG;
-    Trainer trainer = mapGet(pokemonGo->trainers_map, name);
+    Trainer trainer = trainerGetByName(pokemonGo, name);
     if (!trainer) return POKEMON_GO_TRAINER_DOES_NOT_EXIST;
     char *location = trainerGetLocation(trainer);
     int budget = trainerGetPokecoins(trainer);
@@ -816,11 +922,12 @@ PokemonGoResult pokemonGoReportLocations(PokemonGo pokemonGo,
         return POKEMON_GO_NULL_ARG;
     }
     mtmPrintLocationsHeader(output_channel);
-    char *first_pokemon = NULL;
-    MAP_FOREACH (char*, location_iterator, pokemonGo->locations_map) {
-        first_pokemon = pokemonGetName(locationGetFirstPokemon(
-                locationGetByName(pokemonGo, location_iterator)));
-        mtmPrintLocation(output_channel, location_iterator, first_pokemon);
+    MapIterator location_iterator;
+    MAP_ITER_FOREACH(location_iterator, pokemonGo->locations_map) {
+        char *first_pokemon = pokemonGetName(locationGetFirstPokemon(
+                mapIterData(&location_iterator)));
+        mtmPrintLocation(output_channel, mapIterKey(&location_iterator),
+                         first_pokemon);
     }
     return POKEMON_GO_SUCCESS;
 }
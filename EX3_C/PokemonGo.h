@@ -76,6 +76,8 @@ void pokemonGoDestroy(PokemonGo pokemonGo);
 /*----------------------------------------------------------------------------*/
 /**
 * Returns pokemonGo pokedex map.
+* Its keys are names interned in pokemonGo: put keys returned by
+* pokemonGoInternName and look up keys returned by pokemonGoFindName.
 * @return NULL if sent NULL
 * @param pokemonGo
 */
@@ -84,11 +86,44 @@ Map pokemonGoGetPokedex(PokemonGo pokemonGo);
 /*----------------------------------------------------------------------------*/
 /**
 * Returns pokemonGo locations map.
+* Its keys are names interned in pokemonGo, as the keys of the pokedex map.
 * @return NULL if sent NULL
 * @param pokemonGo
 */
 Map pokemonGoGetLocations(PokemonGo pokemonGo);
 
+/*----------------------------------------------------------------------------*/
+/**
+* Returns pokemonGo trainers map.
+* Its keys are names interned in pokemonGo, as the keys of the pokedex map.
+* @return NULL if sent NULL
+* @param pokemonGo
+*/
+Map pokemonGoGetTrainers(PokemonGo pokemonGo);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the copy of a name interned in pokemonGo, interning it if it isn't
+* yet. Equal names are interned once, so the returned name is freed with
+* pokemonGo and must not be changed.
+* @param pokemonGo, name
+* @return
+*   NULL if sent NULL or a memory allocation failed.
+*   the interned name otherwise
+*/
+char *pokemonGoInternName(PokemonGo pokemonGo, char *name);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the copy of a name interned in pokemonGo, without interning it.
+* A name which isn't interned is not a key of any pokemonGo map.
+* @param pokemonGo, name
+* @return
+*   NULL if sent NULL or the name isn't interned.
+*   the interned name otherwise
+*/
+char *pokemonGoFindName(PokemonGo pokemonGo, char *name);
+
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -245,5 +280,20 @@ PokemonGoResult pokemonGoReportStock(PokemonGo pokemonGo, FILE *output_channel);
 */
 PokemonGoResult pokemonGoAddLocation(PokemonGo pokemonGo, char *name);
 
+/*----------------------------------------------------------------------------*/
+/**
+* Gives every location an id and resolves the names of its nearby locations
+* to sorted ids, so checking if a location is reachable is a binary search
+* instead of comparing names. Call it once all the locations and their
+* nearby locations are added; adding a location afterwards falls back to
+* comparing names until it is called again.
+* @param pokemonGo
+* @return
+*   POKEMON_GO_NULL_ARG if sent NULL
+*   POKEMON_GO_OUT_OF_MEM if an allocation failed.
+*   POKEMON_GO_SUCCESS otherwise.
+*/
+PokemonGoResult pokemonGoIndexLocations(PokemonGo pokemonGo);
+
 /*----------------------------------------------------------------------------*/
 #endif /* POKEMON_GO_H */
\ No newline at end of file
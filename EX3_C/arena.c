@@ -0,0 +1,132 @@
+#include "arena.h"
+#include <stdlib.h>
+
+//-------------------------- Defines & Declarations ----------------------------
+
+#define ARENA_ALIGNMENT 16
+#define ARENA_CHUNK_SIZE (64 * 1024)
+#define SIZE_CLASSES_NUM (ARENA_MAX_BLOCK / ARENA_ALIGNMENT)
+
+/** A chunk header, padded so the blocks after it are aligned. */
+typedef union chunk_t {
+    union chunk_t* next;
+    char alignment[ARENA_ALIGNMENT];
+} *Chunk;
+
+typedef struct free_block_t {
+    struct free_block_t* next;
+} *FreeBlock;
+
+struct arena_t {
+    Chunk chunks;
+    // The unused part of the last chunk of blocks.
+    char* top;
+    char* end;
+    // free_lists[i] holds freed blocks of (i + 1) * ARENA_ALIGNMENT bytes.
+    FreeBlock free_lists[SIZE_CLASSES_NUM];
+    int chunks_num;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Returns the size class of a block of at most ARENA_MAX_BLOCK bytes.
+*/
+static int sizeClass(size_t size) {
+    return size == 0 ? 0 : (int)((size - 1) / ARENA_ALIGNMENT);
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Allocates a chunk of a given size and links it to the arena.
+* @return the memory of the chunk, or NULL if allocation failed
+*/
+static char* chunkCreate(Arena arena, size_t size) {
+    Chunk chunk = malloc(sizeof(*chunk) + size);
+    if (!chunk) {
+        return NULL;
+    }
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->chunks_num++;
+    return (char*)(chunk + 1);
+}
+
+//-------------------------- Main Functions ------------------------------------
+
+Arena arenaCreate(void) {
+    Arena arena = malloc(sizeof(*arena));
+    if (!arena) {
+        return NULL;
+    }
+    arena->chunks = NULL;
+    arena->top = NULL;
+    arena->end = NULL;
+    for (int i = 0; i < SIZE_CLASSES_NUM; ++i) {
+        arena->free_lists[i] = NULL;
+    }
+    arena->chunks_num = 0;
+    return arena;
+}
+/*----------------------------------------------------------------------------*/
+void arenaDestroy(Arena arena) {
+    if (!arena) {
+        return;
+    }
+    while (arena->chunks) {
+        Chunk next = arena->chunks->next;
+        free(arena->chunks);
+        arena->chunks = next;
+    }
+    free(arena);
+}
+/*----------------------------------------------------------------------------*/
+void* arenaAlloc(Arena arena, size_t size) {
+    if (!arena) {
+        return malloc(size);
+    }
+    if (size > ARENA_MAX_BLOCK) {
+        return chunkCreate(arena, size);
+    }
+    int size_class = sizeClass(size);
+    FreeBlock block = arena->free_lists[size_class];
+    if (block) {
+        arena->free_lists[size_class] = block->next;
+        return block;
+    }
+    size_t block_size = (size_t)(size_class + 1) * ARENA_ALIGNMENT;
+    if (!arena->top || (size_t)(arena->end - arena->top) < block_size) {
+        char* memory = chunkCreate(arena, ARENA_CHUNK_SIZE);
+        if (!memory) {
+            return NULL;
+        }
+        arena->top = memory;
+        arena->end = memory + ARENA_CHUNK_SIZE;
+    }
+    void* new_block = arena->top;
+    arena->top += block_size;
+    return new_block;
+}
+/*----------------------------------------------------------------------------*/
+void arenaFree(Arena arena, void* block, size_t size) {
+    if (!block) {
+        return;
+    }
+    if (!arena) {
+        free(block);
+        return;
+    }
+    if (size > ARENA_MAX_BLOCK) {
+        return;
+    }
+    int size_class = sizeClass(size);
+    FreeBlock free_block = block;
+    free_block->next = arena->free_lists[size_class];
+    arena->free_lists[size_class] = free_block;
+}
+/*----------------------------------------------------------------------------*/
+int arenaGetChunksNum(Arena arena) {
+    if (!arena) {
+        return -1;
+    }
+    return arena->chunks_num;
+}
@@ -0,0 +1,79 @@
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <stddef.h>
+
+/**
+* Arena Allocator
+*
+* An arena hands out small blocks carved from large chunks, so allocating a
+* block rarely calls malloc, and destroying the arena frees all its blocks
+* with one free per chunk. Freed blocks are kept on a free list of their
+* size class and reused by later allocations of that class. Blocks larger
+* than ARENA_MAX_BLOCK get a chunk of their own, which is freed only with
+* the arena.
+*
+* A NULL arena stands for the heap: arenaAlloc and arenaFree call malloc and
+* free, so code may take an optional arena and use it unconditionally.
+* An arena is not thread safe.
+*/
+
+typedef struct arena_t* Arena;
+
+#define ARENA_MAX_BLOCK 1024
+
+/*----------------------------------------------------------------------------*/
+/**
+* Creates a new empty arena.
+*
+* @return
+* NULL if memory allocation failed.
+* new allocated arena otherwise
+*/
+Arena arenaCreate(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Frees an arena and all the blocks allocated in it, whether they were freed
+* or not. Does nothing if arena is NULL.
+*
+* @param arena
+*/
+void arenaDestroy(Arena arena);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Allocates a block in an arena, aligned as malloc aligns.
+*
+* @param arena - the arena, or NULL for the heap
+* @param size - the size of the block
+* @return
+* NULL if memory allocation failed.
+* the block otherwise
+*/
+void* arenaAlloc(Arena arena, size_t size);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns a block to the arena it was allocated in, for reuse.
+* Does nothing if block is NULL.
+*
+* @param arena - the arena of the block, or NULL for the heap
+* @param block - the block
+* @param size - the size the block was allocated with
+*/
+void arenaFree(Arena arena, void* block, size_t size);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the number of chunks an arena allocated, i.e. its calls to malloc.
+*
+* @param arena
+* @return
+* -1 if arena is NULL.
+* the number of chunks otherwise
+*/
+int arenaGetChunksNum(Arena arena);
+
+/*----------------------------------------------------------------------------*/
+#endif /* ARENA_H_ */
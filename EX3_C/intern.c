@@ -0,0 +1,162 @@
+#include "intern.h"
+#include "arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------- Defines & Declarations ----------------------------
+
+#define INITIAL_SLOTS 64
+
+/** A slot of the index. The hash is kept to skip most compares. */
+typedef struct slot_t {
+    char* string;
+    unsigned int hash;
+} *Slot;
+
+struct intern_table_t {
+    // An open addressing (linear probing) index, at most 3/4 full.
+    Slot slots;
+    int slots_num;
+    int size;
+    size_t strings_memory;
+    Arena strings;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Hashes the characters of a string (FNV-1a).
+*/
+static unsigned int stringHash(const char* str) {
+    unsigned int hash = 2166136261U;
+    for (const unsigned char* c = (const unsigned char*)str; *c; ++c) {
+        hash = (hash ^ *c) * 16777619U;
+    }
+    return hash;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the slot of a string: the slot holding it, or the empty slot
+* where it belongs.
+*/
+static Slot slotFind(InternTable table, const char* str, unsigned int hash) {
+    int mask = table->slots_num - 1;
+    for (int i = (int)(hash & (unsigned int)mask); ; i = (i + 1) & mask) {
+        Slot slot = &table->slots[i];
+        if (!slot->string ||
+            (slot->hash == hash && strcmp(slot->string, str) == 0)) {
+            return slot;
+        }
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Doubles the number of slots, moving the strings into the new slots.
+*/
+static bool slotsGrow(InternTable table) {
+    Slot old_slots = table->slots;
+    int old_slots_num = table->slots_num;
+    table->slots = calloc(2 * old_slots_num, sizeof(*table->slots));
+    if (!table->slots) {
+        table->slots = old_slots;
+        return false;
+    }
+    table->slots_num = 2 * old_slots_num;
+    for (int i = 0; i < old_slots_num; ++i) {
+        if (old_slots[i].string) {
+            *slotFind(table, old_slots[i].string, old_slots[i].hash) =
+                    old_slots[i];
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+//-------------------------- Main Functions ------------------------------------
+
+InternTable internTableCreate(void) {
+    InternTable table = malloc(sizeof(*table));
+    if (!table) {
+        return NULL;
+    }
+    table->slots = calloc(INITIAL_SLOTS, sizeof(*table->slots));
+    table->strings = arenaCreate();
+    if (!table->slots || !table->strings) {
+        free(table->slots);
+        arenaDestroy(table->strings);
+        free(table);
+        return NULL;
+    }
+    table->slots_num = INITIAL_SLOTS;
+    table->size = 0;
+    table->strings_memory = 0;
+    return table;
+}
+/*----------------------------------------------------------------------------*/
+void internTableDestroy(InternTable table) {
+    if (!table) {
+        return;
+    }
+    free(table->slots);
+    arenaDestroy(table->strings);
+    free(table);
+}
+/*----------------------------------------------------------------------------*/
+char* internString(InternTable table, const char* str) {
+    if (!table || !str) {
+        return NULL;
+    }
+    if (4 * (table->size + 1) > 3 * table->slots_num && !slotsGrow(table)) {
+        return NULL;
+    }
+    unsigned int hash = stringHash(str);
+    Slot slot = slotFind(table, str, hash);
+    if (slot->string) {
+        return slot->string;
+    }
+    size_t size = strlen(str) + 1;
+    char* string = arenaAlloc(table->strings, size);
+    if (!string) {
+        return NULL;
+    }
+    memcpy(string, str, size);
+    slot->string = string;
+    slot->hash = hash;
+    table->size++;
+    table->strings_memory += size;
+    return string;
+}
+/*----------------------------------------------------------------------------*/
+char* internFind(InternTable table, const char* str) {
+    if (!table || !str) {
+        return NULL;
+    }
+    return slotFind(table, str, stringHash(str))->string;
+}
+/*----------------------------------------------------------------------------*/
+int internGetSize(InternTable table) {
+    if (!table) {
+        return -1;
+    }
+    return table->size;
+}
+/*----------------------------------------------------------------------------*/
+size_t internGetMemory(InternTable table) {
+    if (!table) {
+        return 0;
+    }
+    return table->strings_memory + sizeof(*table->slots) * table->slots_num;
+}
+/*----------------------------------------------------------------------------*/
+int internCompare(void* str1, void* str2) {
+    if (str1 == str2) {
+        return 0;
+    }
+    return strcmp(str1, str2) > 0 ? 1 : -1;
+}
+/*----------------------------------------------------------------------------*/
+unsigned int internHash(void* str) {
+    return (unsigned int)((uintptr_t)str >> 4);
+}
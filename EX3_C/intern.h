@@ -0,0 +1,95 @@
+#ifndef INTERN_H_
+#define INTERN_H_
+
+#include <stddef.h>
+
+/**
+* String Interning Table
+*
+* Keeps one copy of every distinct string put in it, so equal strings
+* interned in the same table are the same pointer. Interned strings are
+* compared by pointer for equality, and can be hashed by their address
+* instead of by their characters. They are stored in an arena and freed
+* only with the table, and must not be changed or freed by the caller.
+*/
+
+typedef struct intern_table_t* InternTable;
+
+/*----------------------------------------------------------------------------*/
+/**
+* Creates a new empty table.
+*
+* @return
+* NULL if memory allocation failed.
+* new allocated table otherwise
+*/
+InternTable internTableCreate(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Frees a table and all the strings interned in it. Does nothing if table is
+* NULL.
+*
+* @param table
+*/
+void internTableDestroy(InternTable table);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the interned copy of a string, interning it if it isn't yet.
+*
+* @param table, str
+* @return
+* NULL if a NULL was sent or a memory allocation failed.
+* the interned string equal to str otherwise
+*/
+char* internString(InternTable table, const char* str);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the interned copy of a string without interning it.
+*
+* @param table, str
+* @return
+* NULL if a NULL was sent or the string isn't interned.
+* the interned string equal to str otherwise
+*/
+char* internFind(InternTable table, const char* str);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the number of strings interned in a table, or -1 if table is NULL.
+*
+* @param table
+*/
+int internGetSize(InternTable table);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the bytes taken by the strings of a table and its index.
+*
+* @param table
+*/
+size_t internGetMemory(InternTable table);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Compares two strings interned in the same table, as strcmp orders them.
+* Equal strings are found by comparing the pointers. Can be given to a Map
+* as its compare function.
+*
+* @param str1, str2
+*/
+int internCompare(void* str1, void* str2);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Hashes an interned string by its address. Can be given to a Map as its
+* hash function, if every key it is given is interned in the same table.
+*
+* @param str
+*/
+unsigned int internHash(void* str);
+
+/*----------------------------------------------------------------------------*/
+#endif /* INTERN_H_ */
@@ -0,0 +1,118 @@
+#include "keyword.h"
+#include <string.h>
+
+//-------------------------- Defines & Declarations ----------------------------
+
+/**
+* The tables are indexed by wordHash of their keywords, with the length
+* weights and table sizes below, which were chosen so that no two keywords
+* share a slot. Changing a keyword requires checking that this still holds:
+* the keyword tests resolve every keyword.
+*/
+#define COMMANDS_SIZE 16
+#define COMMAND_LENGTH_WEIGHT 2
+#define GROUPS_SIZE 8
+#define GROUP_LENGTH_WEIGHT 2
+#define TYPES_SIZE 32
+#define TYPE_LENGTH_WEIGHT 3
+
+typedef struct command_entry_t {
+    const char *first_word;
+    const char *second_word;
+    Command command;
+} CommandEntry;
+
+typedef struct type_entry_t {
+    const char *name;
+    PokemonType type;
+} TypeEntry;
+
+/** Slot: (wordHash(first_word, 2) + wordHash(second_word, 2)) % 16 */
+static const CommandEntry commands[COMMANDS_SIZE] = {
+        [0] = {"report", "locations", COMMAND_REPORT_LOCATIONS},
+        [2] = {"pokemon", "heal", COMMAND_POKEMON_HEAL},
+        [4] = {"report", "stock", COMMAND_REPORT_STOCK},
+        [7] = {"report", "trainer", COMMAND_REPORT_TRAINER},
+        [8] = {"battle", "fight", COMMAND_BATTLE_FIGHT},
+        [9] = {"trainer", "purchase", COMMAND_TRAINER_PURCHASE},
+        [12] = {"store", "add", COMMAND_STORE_ADD},
+        [13] = {"pokemon", "train", COMMAND_POKEMON_TRAIN},
+        [14] = {"trainer", "go", COMMAND_TRAINER_GO},
+        [15] = {"trainer", "add", COMMAND_TRAINER_ADD},
+};
+
+/** Slot: wordHash(group, 2) % 8 */
+static const char *groups[GROUPS_SIZE] = {
+        [1] = "store",
+        [3] = "report",
+        [4] = "trainer",
+        [5] = "pokemon",
+        [7] = "battle",
+};
+
+/**
+* Slot: wordHash(name, 3) % 32
+* ELECTRIC has no slot on purpose: the stringToType this replaces had no case
+* for it, so it resolves to TYPE_NORMAL as it always did.
+*/
+static const TypeEntry types[TYPES_SIZE] = {
+        [0] = {"BUG", TYPE_BUG},
+        [4] = {"FLYING", TYPE_FLYING},
+        [7] = {"WATER", TYPE_WATER},
+        [8] = {"GRASS", TYPE_GRASS},
+        [11] = {"GROUND", TYPE_GROUND},
+        [13] = {"ROCK", TYPE_ROCK},
+        [15] = {"NORMAL", TYPE_NORMAL},
+        [17] = {"POISON", TYPE_POISON},
+        [21] = {"ICE", TYPE_ICE},
+        [22] = {"FAIRY", TYPE_FAIRY},
+        [24] = {"PSYCHIC", TYPE_PSYCHIC},
+        [27] = {"FIRE", TYPE_FIRE},
+        [30] = {"GHOST", TYPE_GHOST},
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Hashes a non empty word by its first two characters and its length.
+*/
+static unsigned int wordHash(const char *word, unsigned int length_weight) {
+    return (unsigned char) word[0] + (unsigned char) word[1] +
+           length_weight * (unsigned int) strlen(word);
+}
+/*----------------------------------------------------------------------------*/
+static bool isGroup(char *word) {
+    const char *group = groups[wordHash(word, GROUP_LENGTH_WEIGHT) %
+                               GROUPS_SIZE];
+    return group && strcmp(group, word) == 0;
+}
+
+//-------------------------- Main Functions ------------------------------------
+
+Command keywordGetCommand(char *first_word, char *second_word) {
+    if (!first_word || *first_word == '\0') {
+        return COMMAND_UNKNOWN;
+    }
+    if (second_word && *second_word != '\0') {
+        const CommandEntry *entry = &commands[
+                (wordHash(first_word, COMMAND_LENGTH_WEIGHT) +
+                 wordHash(second_word, COMMAND_LENGTH_WEIGHT)) % COMMANDS_SIZE];
+        if (entry->first_word && strcmp(entry->first_word, first_word) == 0 &&
+            strcmp(entry->second_word, second_word) == 0) {
+            return entry->command;
+        }
+    }
+    return isGroup(first_word) ? COMMAND_UNKNOWN_VERB : COMMAND_UNKNOWN;
+}
+/*----------------------------------------------------------------------------*/
+PokemonType keywordGetType(char *name) {
+    if (!name || *name == '\0') {
+        return TYPE_NORMAL;
+    }
+    const TypeEntry *entry = &types[wordHash(name, TYPE_LENGTH_WEIGHT) %
+                                    TYPES_SIZE];
+    if (entry->name && strcmp(entry->name, name) == 0) {
+        return entry->type;
+    }
+    return TYPE_NORMAL;
+}
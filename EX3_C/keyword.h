@@ -0,0 +1,58 @@
+#ifndef KEYWORD_H_
+#define KEYWORD_H_
+
+#include "pokemon.h"
+
+/**
+* Keywords
+*
+* Resolves the words of the input files, the command words and the Pokemon
+* type names, with perfect hash tables: every keyword hashes to a slot of
+* its own, so a word is resolved with one hash and one compare against the
+* keyword in its slot.
+*/
+
+typedef enum {
+    COMMAND_TRAINER_ADD,
+    COMMAND_TRAINER_GO,
+    COMMAND_TRAINER_PURCHASE,
+    COMMAND_STORE_ADD,
+    COMMAND_BATTLE_FIGHT,
+    COMMAND_POKEMON_TRAIN,
+    COMMAND_POKEMON_HEAL,
+    COMMAND_REPORT_TRAINER,
+    COMMAND_REPORT_LOCATIONS,
+    COMMAND_REPORT_STOCK,
+    // The first word is a command group, but the second isn't one of its
+    // commands.
+    COMMAND_UNKNOWN_VERB,
+    // The first word is not a command group.
+    COMMAND_UNKNOWN
+} Command;
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the command named by the first two words of a command line.
+*
+* @param first_word, second_word - the words, or NULL if missing
+* @return
+* COMMAND_UNKNOWN if first_word is NULL or is not a command group.
+* COMMAND_UNKNOWN_VERB if second_word is NULL or is not a command of the
+*     group.
+* the command otherwise
+*/
+Command keywordGetCommand(char *first_word, char *second_word);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the Pokemon type of a type name of the pokedex file.
+*
+* @param name
+* @return
+* TYPE_NORMAL if name is NULL or is not a type name.
+* the type otherwise
+*/
+PokemonType keywordGetType(char *name);
+
+/*----------------------------------------------------------------------------*/
+#endif /* KEYWORD_H_ */
@@ -2,6 +2,7 @@
 #define LIST_H_
 
 #include <stdbool.h>
+#include "arena.h"
 /**
 * Generic List Container
 *
@@ -13,6 +14,8 @@
 * The following functions are available:
 *
 *   listCreate               - Creates a new empty list
+*   listCreateInArena        - Creates a new empty list which allocates in an
+*                              arena
 *   listDestroy              - Deletes an existing list and frees all resources
 *   listCopy                 - Copies an existing list
 *   listGetSize              - Returns the size of a given list
@@ -134,6 +137,22 @@ typedef bool(*FilterListElement)(ListElement, ListFilterKey);
 */
 List listCreate(CopyListElement copyElement, FreeListElement freeElement);
 
+/**
+* Allocates a new empty list as listCreate does, whose own memory (the list
+* and its array of elements) is allocated in an arena. The elements are still
+* allocated and freed by the given functions. listCopy and listFilter
+* allocate their lists in the same arena, and listDestroy returns the memory
+* of the list to the arena, which must outlive the list.
+*
+* @param copyElement, freeElement - As in listCreate.
+* @param arena - The arena, or NULL to allocate on the heap.
+* @return
+* 	NULL - if one of the element functions is NULL or allocations failed.
+* 	A new List in case of success.
+*/
+List listCreateInArena(CopyListElement copyElement, FreeListElement freeElement,
+                       Arena arena);
+
 /**
 * Creates a copy of target list.
 *
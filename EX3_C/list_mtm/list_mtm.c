@@ -0,0 +1,387 @@
+#include "../list.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+* Array List Container
+*
+* Implements list.h with the elements kept contiguously in a growing array,
+* so iterating is a walk over an array instead of a chase of pointers, and a
+* list of n elements takes one allocation for its elements instead of n.
+* Inserting or removing anywhere but at the end moves the elements after
+* it, which is cheap for the short lists of the game.
+*
+* The internal iterator is the index of the current element. Inserting
+* before it moves it along with its element, so it keeps pointing at the
+* same element, as in a linked list. listSort sorts the array in place with
+* an introsort: a quicksort which falls back to a heapsort when it recurses
+* too deep, and finishes short ranges with an insertion sort. The sort is
+* not stable.
+*
+* A list created in an arena allocates the list and its array there. As the
+* arena keeps arrays larger than ARENA_MAX_BLOCK until it is destroyed,
+* growing such a list leaves the arrays it outgrew in the arena.
+*/
+
+#define INITIAL_CAPACITY 4
+#define NO_CURRENT -1
+#define INSERTION_SORT_SIZE 16
+
+struct List_t {
+    ListElement* elements;
+    int size;
+    int capacity;
+    int current;
+    CopyListElement copyElement;
+    FreeListElement freeElement;
+    Arena arena;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Makes room for at least one more element.
+*/
+static ListResult listReserve(List list) {
+    if (list->size < list->capacity) {
+        return LIST_SUCCESS;
+    }
+    int capacity = list->capacity == 0 ? INITIAL_CAPACITY : 2 * list->capacity;
+    ListElement* elements;
+    if (!list->arena) {
+        elements = realloc(list->elements, sizeof(*elements) * capacity);
+    } else {
+        // Arenas cannot grow a block in place.
+        elements = arenaAlloc(list->arena, sizeof(*elements) * capacity);
+        if (elements && list->size > 0) {
+            memcpy(elements, list->elements, sizeof(*elements) * list->size);
+        }
+        if (elements) {
+            arenaFree(list->arena, list->elements,
+                      sizeof(*elements) * list->capacity);
+        }
+    }
+    if (!elements) {
+        return LIST_OUT_OF_MEMORY;
+    }
+    list->elements = elements;
+    list->capacity = capacity;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Inserts a copy of an element at an index. The current element stays the
+* same element.
+*/
+static ListResult listInsertAt(List list, int index, ListElement element) {
+    if (listReserve(list) != LIST_SUCCESS) {
+        return LIST_OUT_OF_MEMORY;
+    }
+    ListElement copy = list->copyElement(element);
+    if (!copy) {
+        return LIST_OUT_OF_MEMORY;
+    }
+    memmove(list->elements + index + 1, list->elements + index,
+            sizeof(*list->elements) * (list->size - index));
+    list->elements[index] = copy;
+    list->size++;
+    if (list->current != NO_CURRENT && list->current >= index) {
+        list->current++;
+    }
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+static void elementsSwap(ListElement* elements, int i, int j) {
+    ListElement element = elements[i];
+    elements[i] = elements[j];
+    elements[j] = element;
+}
+/*----------------------------------------------------------------------------*/
+static void insertionSort(ListElement* elements, int size,
+                          CompareListElements compare) {
+    for (int i = 1; i < size; ++i) {
+        ListElement element = elements[i];
+        int j = i;
+        while (j > 0 && compare(elements[j - 1], element) > 0) {
+            elements[j] = elements[j - 1];
+            j--;
+        }
+        elements[j] = element;
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Moves an element down a max-heap until its children are not greater.
+*/
+static void heapSiftDown(ListElement* elements, int index, int size,
+                         CompareListElements compare) {
+    while (2 * index + 1 < size) {
+        int child = 2 * index + 1;
+        if (child + 1 < size &&
+            compare(elements[child + 1], elements[child]) > 0) {
+            child++;
+        }
+        if (compare(elements[child], elements[index]) <= 0) {
+            return;
+        }
+        elementsSwap(elements, index, child);
+        index = child;
+    }
+}
+/*----------------------------------------------------------------------------*/
+static void heapSort(ListElement* elements, int size,
+                     CompareListElements compare) {
+    for (int i = size / 2 - 1; i >= 0; --i) {
+        heapSiftDown(elements, i, size, compare);
+    }
+    for (int last = size - 1; last > 0; --last) {
+        elementsSwap(elements, 0, last);
+        heapSiftDown(elements, 0, last, compare);
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Partitions a range around the median of its first, middle and last
+* elements. Returns the index of the pivot, which ends up in its sorted
+* place.
+*/
+static int partition(ListElement* elements, int size,
+                     CompareListElements compare) {
+    int middle = size / 2, last = size - 1;
+    if (compare(elements[0], elements[middle]) > 0) {
+        elementsSwap(elements, 0, middle);
+    }
+    if (compare(elements[middle], elements[last]) > 0) {
+        elementsSwap(elements, middle, last);
+        if (compare(elements[0], elements[middle]) > 0) {
+            elementsSwap(elements, 0, middle);
+        }
+    }
+    // elements[0] <= pivot <= elements[last], so the scans below stop
+    // within the range.
+    elementsSwap(elements, middle, last - 1);
+    ListElement pivot = elements[last - 1];
+    int i = 0, j = last - 1;
+    while (true) {
+        while (compare(elements[++i], pivot) < 0) {}
+        while (compare(elements[--j], pivot) > 0) {}
+        if (i >= j) {
+            break;
+        }
+        elementsSwap(elements, i, j);
+    }
+    elementsSwap(elements, i, last - 1);
+    return i;
+}
+/*----------------------------------------------------------------------------*/
+static void introSort(ListElement* elements, int size, int depth_limit,
+                      CompareListElements compare) {
+    while (size > INSERTION_SORT_SIZE) {
+        if (depth_limit-- == 0) {
+            heapSort(elements, size, compare);
+            return;
+        }
+        int pivot = partition(elements, size, compare);
+        // Recurse into the smaller side, and loop on the larger one.
+        if (pivot < size - pivot - 1) {
+            introSort(elements, pivot, depth_limit, compare);
+            elements += pivot + 1;
+            size -= pivot + 1;
+        } else {
+            introSort(elements + pivot + 1, size - pivot - 1, depth_limit,
+                      compare);
+            size = pivot;
+        }
+    }
+    insertionSort(elements, size, compare);
+}
+
+//-------------------------- Main Functions ------------------------------------
+
+List listCreate(CopyListElement copyElement, FreeListElement freeElement) {
+    return listCreateInArena(copyElement, freeElement, NULL);
+}
+/*----------------------------------------------------------------------------*/
+List listCreateInArena(CopyListElement copyElement, FreeListElement freeElement,
+                       Arena arena) {
+    if (!copyElement || !freeElement) {
+        return NULL;
+    }
+    List list = arenaAlloc(arena, sizeof(*list));
+    if (!list) {
+        return NULL;
+    }
+    list->elements = NULL;
+    list->size = 0;
+    list->capacity = 0;
+    list->current = NO_CURRENT;
+    list->copyElement = copyElement;
+    list->freeElement = freeElement;
+    list->arena = arena;
+    return list;
+}
+/*----------------------------------------------------------------------------*/
+List listCopy(List list) {
+    if (!list) {
+        return NULL;
+    }
+    List copy = listCreateInArena(list->copyElement, list->freeElement,
+                                  list->arena);
+    if (!copy) {
+        return NULL;
+    }
+    if (list->size > 0) {
+        copy->elements = arenaAlloc(list->arena,
+                                    sizeof(*copy->elements) * list->size);
+        if (!copy->elements) {
+            listDestroy(copy);
+            return NULL;
+        }
+        copy->capacity = list->size;
+    }
+    for (int i = 0; i < list->size; ++i) {
+        copy->elements[i] = list->copyElement(list->elements[i]);
+        if (!copy->elements[i]) {
+            listDestroy(copy);
+            return NULL;
+        }
+        copy->size++;
+    }
+    copy->current = list->current;
+    return copy;
+}
+/*----------------------------------------------------------------------------*/
+int listGetSize(List list) {
+    if (!list) {
+        return -1;
+    }
+    return list->size;
+}
+/*----------------------------------------------------------------------------*/
+ListElement listGetFirst(List list) {
+    if (!list) {
+        return NULL;
+    }
+    list->current = list->size > 0 ? 0 : NO_CURRENT;
+    return listGetCurrent(list);
+}
+/*----------------------------------------------------------------------------*/
+ListElement listGetNext(List list) {
+    if (!list || list->current == NO_CURRENT) {
+        return NULL;
+    }
+    if (++list->current >= list->size) {
+        list->current = NO_CURRENT;
+    }
+    return listGetCurrent(list);
+}
+/*----------------------------------------------------------------------------*/
+ListElement listGetCurrent(List list) {
+    if (!list || list->current == NO_CURRENT) {
+        return NULL;
+    }
+    return list->elements[list->current];
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertFirst(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    return listInsertAt(list, 0, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertLast(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    return listInsertAt(list, list->size, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertBeforeCurrent(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    if (list->current == NO_CURRENT) {
+        return LIST_INVALID_CURRENT;
+    }
+    return listInsertAt(list, list->current, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertAfterCurrent(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    if (list->current == NO_CURRENT) {
+        return LIST_INVALID_CURRENT;
+    }
+    return listInsertAt(list, list->current + 1, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listRemoveCurrent(List list) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    if (list->current == NO_CURRENT) {
+        return LIST_INVALID_CURRENT;
+    }
+    list->freeElement(list->elements[list->current]);
+    list->size--;
+    memmove(list->elements + list->current, list->elements + list->current + 1,
+            sizeof(*list->elements) * (list->size - list->current));
+    list->current = NO_CURRENT;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+ListResult listSort(List list, CompareListElements compareElement) {
+    if (!list || !compareElement) {
+        return LIST_NULL_ARGUMENT;
+    }
+    int depth_limit = 0;
+    for (int size = list->size; size > 1; size /= 2) {
+        depth_limit += 2;
+    }
+    introSort(list->elements, list->size, depth_limit, compareElement);
+    list->current = NO_CURRENT;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+List listFilter(List list, FilterListElement filterElement, ListFilterKey key) {
+    if (!list || !filterElement) {
+        return NULL;
+    }
+    List filtered = listCreateInArena(list->copyElement, list->freeElement,
+                                      list->arena);
+    if (!filtered) {
+        return NULL;
+    }
+    for (int i = 0; i < list->size; ++i) {
+        if (filterElement(list->elements[i], key) &&
+            listInsertLast(filtered, list->elements[i]) != LIST_SUCCESS) {
+            listDestroy(filtered);
+            return NULL;
+        }
+    }
+    return filtered;
+}
+/*----------------------------------------------------------------------------*/
+ListResult listClear(List list) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    for (int i = 0; i < list->size; ++i) {
+        list->freeElement(list->elements[i]);
+    }
+    list->size = 0;
+    list->current = NO_CURRENT;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+void listDestroy(List list) {
+    if (!list) {
+        return;
+    }
+    listClear(list);
+    arenaFree(list->arena, list->elements,
+              sizeof(*list->elements) * list->capacity);
+    arenaFree(list->arena, list, sizeof(*list));
+}
@@ -10,6 +10,10 @@ struct location_t {
     char *name;
     List nearby;
     List pokemons;
+    int id;
+    // The sorted ids of the nearby locations, or NULL if they aren't set.
+    int *nearby_ids;
+    int nearby_ids_num;
 };
 
 //---------------------------Auxiliary Functions--------------------------------
@@ -57,10 +61,38 @@ static ListElement pokemonListCopy(ListElement pokemon) {
 static void pokemonListDestroy(ListElement pokemon) {
     pokemonDestroy((Pokemon) pokemon);
 }
+/*----------------------------------------------------------------------------*/
+/**
+* Compares two ints, to sort ids with qsort
+*/
+static int idCompare(const void *id1, const void *id2) {
+    int int_1 = *(const int *) id1, int_2 = *(const int *) id2;
+    return int_1 > int_2 ? 1 : (int_1 < int_2 ? -1 : 0);
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Inserts copies of the elements of a list at the end of another list
+* @param destination - The list to insert the copies into
+* @param source - The list to copy the elements of
+* @return LIST_OUT_OF_MEMORY if an insertion failed, LIST_SUCCESS otherwise
+*/
+static ListResult listAppendAll(List destination, List source) {
+    LIST_FOREACH(ListElement, element, source) {
+        if (listInsertLast(destination, element) != LIST_SUCCESS) {
+            return LIST_OUT_OF_MEMORY;
+        }
+    }
+    return LIST_SUCCESS;
+}
 
 //-------------------------- Main Functions ------------------------------------
 
 Location locationCreate(char *name, LocationResult* error) {
+    return locationCreateInArena(name, NULL, error);
+}
+/*----------------------------------------------------------------------------*/
+Location locationCreateInArena(char *name, Arena arena,
+                               LocationResult* error) {
     *error = LOCATION_OUT_OF_MEM;
     if (!name) {
         *error = LOCATION_NULL_ARG;
@@ -70,18 +102,24 @@ Location locationCreate(char *name, LocationResult* error) {
     if (!location) {
         return NULL;
     }
-    List nearby = listCreate(stringListCopy, stringListDestroy);
-    if (!nearby) {
+    location->name = NULL;
+    location->nearby = NULL;
+    location->pokemons = NULL;
+    location->id = LOCATION_NO_ID;
+    location->nearby_ids = NULL;
+    location->nearby_ids_num = 0;
+    location->nearby = listCreateInArena(stringListCopy, stringListDestroy,
+                                         arena);
+    if (!location->nearby) {
         locationDestroy(location);
         return NULL;
     }
-    List pokemons = listCreate(pokemonListCopy, pokemonListDestroy);
-    if (!pokemons) {
+    location->pokemons = listCreateInArena(pokemonListCopy,
+                                           pokemonListDestroy, arena);
+    if (!location->pokemons) {
         locationDestroy(location);
         return NULL;
     }
-    location->nearby = nearby;
-    location->pokemons = pokemons;
     location->name = malloc(strlen(name) + 1);
     if (!location->name) return NULL;
     strcpy(location->name, name);
@@ -99,14 +137,18 @@ Location locationCopy(Location location, LocationResult* error) {
     if (!copy) {
         return NULL;
     }
-    listDestroy(copy->nearby);
-    listDestroy(copy->pokemons);
-    copy->nearby = listCopy(location->nearby);
-    if (!copy->nearby) {
+    // listCopy would allocate the lists in the arena of location.
+    if (listAppendAll(copy->nearby, location->nearby) != LIST_SUCCESS ||
+        listAppendAll(copy->pokemons, location->pokemons) != LIST_SUCCESS) {
+        *error = LOCATION_OUT_OF_MEM;
+        locationDestroy(copy);
         return NULL;
     }
-    copy->pokemons = listCopy(location->pokemons);
-    if (!copy->pokemons) {
+    copy->id = location->id;
+    if (location->nearby_ids && locationSetNearbyIds(copy,
+            location->nearby_ids, location->nearby_ids_num) !=
+                                LOCATION_SUCCESS) {
+        locationDestroy(copy);
         return NULL;
     }
     *error = LOCATION_SUCCESS;
@@ -118,6 +160,7 @@ void locationDestroy(Location location) {
     free(location->name);
     listDestroy(location->nearby);
     listDestroy(location->pokemons);
+    free(location->nearby_ids);
     free(location);
 }
 /*----------------------------------------------------------------------------*/
@@ -150,6 +193,9 @@ LocationResult locationAddNearby(Location current, char *nearby) {
         return LOCATION_INVALID_ARG;
     }
     listInsertLast(current->nearby, nearby);
+    free(current->nearby_ids);
+    current->nearby_ids = NULL;
+    current->nearby_ids_num = 0;
     return LOCATION_SUCCESS;
 }
 /*----------------------------------------------------------------------------*/
@@ -169,4 +215,53 @@ LocationResult locationRemoveFirstPokemon(Location location) {
     listRemoveCurrent(location->pokemons);
     return LOCATION_SUCCESS;
 }
-/*----------------------------------------------------------------------------*/
\ No newline at end of file
+/*----------------------------------------------------------------------------*/
+void locationSetId(Location location, int id) {
+    assert(location != NULL);
+    location->id = id;
+}
+/*----------------------------------------------------------------------------*/
+int locationGetId(Location location) {
+    assert(location != NULL);
+    return location->id;
+}
+/*----------------------------------------------------------------------------*/
+LocationResult locationSetNearbyIds(Location location, int *ids, int ids_num) {
+    if (!location || (!ids && ids_num > 0)) {
+        return LOCATION_NULL_ARG;
+    }
+    // Allocate at least one id, so that set ids are never NULL.
+    int *nearby_ids = malloc(sizeof(*nearby_ids) * (ids_num > 0 ? ids_num : 1));
+    if (!nearby_ids) {
+        return LOCATION_OUT_OF_MEM;
+    }
+    if (ids_num > 0) {
+        memcpy(nearby_ids, ids, sizeof(*nearby_ids) * ids_num);
+        qsort(nearby_ids, ids_num, sizeof(*nearby_ids), idCompare);
+    }
+    free(location->nearby_ids);
+    location->nearby_ids = nearby_ids;
+    location->nearby_ids_num = ids_num;
+    return LOCATION_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+bool locationHasNearbyIds(Location location) {
+    return location && location->nearby_ids;
+}
+/*----------------------------------------------------------------------------*/
+bool locationIsNearbyId(Location location, int id) {
+    if (!locationHasNearbyIds(location)) {
+        return false;
+    }
+    int low = 0, high = location->nearby_ids_num;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (location->nearby_ids[middle] < id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < location->nearby_ids_num && location->nearby_ids[low] == id;
+}
+/*----------------------------------------------------------------------------*/
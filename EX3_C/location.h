@@ -6,6 +6,9 @@
 
 typedef struct location_t* Location;
 
+/** The id of a location which has not been given one */
+#define LOCATION_NO_ID -1
+
 typedef enum {
 	LOCATION_SUCCESS,
 	LOCATION_NULL_ARG,
@@ -27,7 +30,22 @@ Location locationCreate(char* name, LocationResult* error);
 
 /*----------------------------------------------------------------------------*/
 /**
-* Creates a copy of location.
+* Creates a new location whose lists of nearby locations and Pokemons are
+* allocated in an arena, which must outlive the location.
+*
+* @param name of location
+* @param arena the arena, or NULL to allocate on the heap
+* @return
+* NULL if a NULL was sent or a memory allocation failed.
+* new allocated location otherwise
+*/
+Location locationCreateInArena(char* name, Arena arena,
+                               LocationResult* error);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Creates a copy of location. The lists of the copy are allocated on the heap,
+* whatever the arena of location, so the copy may outlive that arena.
 *
 * @param location to copy
 * @return
@@ -103,5 +121,50 @@ List locationGetNearby(Location location);
 */
 LocationResult locationRemoveFirstPokemon(Location location);
 
+/*----------------------------------------------------------------------------*/
+/**
+* Sets the id of a location, by which other locations refer to it in their
+* nearby ids.
+*
+* @param location, id
+*/
+void locationSetId(Location location, int id);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the id of a location, or LOCATION_NO_ID if it has none.
+*
+* @param location
+*/
+int locationGetId(Location location);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Sets the ids of the nearby locations of a location, resolved from its
+* nearby names. The ids are copied and sorted. Adding a nearby location
+* afterwards clears them.
+*
+* @param location, ids, number of ids
+* @return result
+*/
+LocationResult locationSetNearbyIds(Location location, int* ids, int ids_num);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns whether the nearby ids of a location are set.
+*
+* @param location
+*/
+bool locationHasNearbyIds(Location location);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns whether a location id is in the nearby ids of a location, by
+* binary search.
+*
+* @param location, id
+*/
+bool locationIsNearbyId(Location location, int id);
+
 /*----------------------------------------------------------------------------*/
 #endif /* LOCATION_H */
\ No newline at end of file
@@ -78,29 +78,6 @@ static MtmErrorCode checkExecutionCommand(int argc, char **argv) {
     return checkInputOutputFlags(argc, argv);
 }
 
-/*----------------------------------------------------------------------------*/
-/**
- * Returns a PokemonType {enum} which is suitable to a given type string.
- * @param type - A string type
- * @return PokemonType suitable to char* type
- */
-static PokemonType stringToType(char *type) {
-    if (strcmp(type, "NORMAL") == 0) return TYPE_NORMAL;
-    if (strcmp(type, "FIRE") == 0) return TYPE_FIRE;
-    if (strcmp(type, "WATER") == 0) return TYPE_WATER;
-    if (strcmp(type, "BUG") == 0) return TYPE_BUG;
-    if (strcmp(type, "GRASS") == 0) return TYPE_GRASS;
-    if (strcmp(type, "FLYING") == 0) return TYPE_FLYING;
-    if (strcmp(type, "FAIRY") == 0) return TYPE_FAIRY;
-    if (strcmp(type, "GHOST") == 0) return TYPE_GHOST;
-    if (strcmp(type, "GROUND") == 0) return TYPE_GROUND;
-    if (strcmp(type, "ICE") == 0) return TYPE_ICE;
-    if (strcmp(type, "POISON") == 0) return TYPE_POISON;
-    if (strcmp(type, "PSYCHIC") == 0) return TYPE_PSYCHIC;
-    if (strcmp(type, "ROCK") == 0) return TYPE_ROCK;
-    return TYPE_NORMAL;
-}
-
 /*----------------------------------------------------------------------------*/
 /**
  * Fills the Pokedex map ADT of PokemonGo from a given text file.
@@ -120,7 +97,7 @@ static MtmErrorCode fillPokedex(FILE *input, PokemonGo pokemonGo) {
         pokemon_cp = atoi(strtok(NULL, DELIMITER));
         type = strtok(NULL, DELIMITER);
         while (type != NULL) {
-            PokemonType strType = stringToType(type);
+            PokemonType strType = keywordGetType(type);
             if (listInsertLast(types, &strType) == LIST_OUT_OF_MEMORY) {
                 return MTM_OUT_OF_MEMORY;
             }
@@ -130,7 +107,12 @@ static MtmErrorCode fillPokedex(FILE *input, PokemonGo pokemonGo) {
         Pokemon new_pokemon = pokemonCreate(pokemon_name, "", NO_EVOLUTION,
                                             pokemon_cp, types, &res);
         if (res == POKEMON_OUT_OF_MEM) return MTM_OUT_OF_MEMORY;
-        mapPut(pokemonGoGetPokedex(pokemonGo), pokemon_name, new_pokemon);
+        char *key = pokemonGoInternName(pokemonGo, pokemon_name);
+        if (!key) {
+            pokemonDestroy(new_pokemon);
+            return MTM_OUT_OF_MEMORY;
+        }
+        mapPut(pokemonGoGetPokedex(pokemonGo), key, new_pokemon);
         listClear(types);
         pokemonDestroy(new_pokemon);
     }
@@ -156,7 +138,8 @@ static MtmErrorCode fillEvolutions(FILE *input, PokemonGo pokemonGo) {
         evolution_name = strtok(NULL, DELIMITER);
         evolution_level = atoi(strtok(NULL, DELIMITER));
         Pokemon pokemon = (Pokemon) mapGet(pokemonGoGetPokedex(pokemonGo),
-                                           pokemon_name);
+                                           pokemonGoFindName(pokemonGo,
+                                                             pokemon_name));
         if (!pokemon) {
             continue;
         }
@@ -175,7 +158,8 @@ static MtmErrorCode fillEvolutions(FILE *input, PokemonGo pokemonGo) {
  * TRUE if char* arg is a Pokemon (appears on the Pokedex) ; FALSE otherwise.
  */
 static bool isPokemon(PokemonGo pokemonGo, char *arg) {
-    if ((Pokemon) mapGet(pokemonGoGetPokedex(pokemonGo), arg) != NULL) {
+    if ((Pokemon) mapGet(pokemonGoGetPokedex(pokemonGo),
+                         pokemonGoFindName(pokemonGo, arg)) != NULL) {
         return true;
     }
     return false;
@@ -228,22 +212,22 @@ static MtmErrorCode fillLocations(FILE *input, PokemonGo pokemonGo) {
             POKEMON_GO_OUT_OF_MEM) {
             return MTM_OUT_OF_MEMORY;
         }
+        Location location = mapGet(pokemonGoGetLocations(pokemonGo),
+                                   pokemonGoFindName(pokemonGo,
+                                                     location_name));
         other_arg = strtok(NULL, DELIMITER);
         while (other_arg != NULL) {
             if (isPokemon(pokemonGo, ignoreSemiColon(other_arg))) {
                 PokemonResult error = POKEMON_SUCCESS;
                 Pokemon pokemon = pokemonCopy(
-                        mapGet(pokemonGoGetPokedex(pokemonGo), other_arg),
+                        mapGet(pokemonGoGetPokedex(pokemonGo),
+                               pokemonGoFindName(pokemonGo, other_arg)),
                         &error);
                 if (error == POKEMON_OUT_OF_MEM) return MTM_OUT_OF_MEMORY;
-                locationAddPokemon(
-                        mapGet(pokemonGoGetLocations(pokemonGo), location_name),
-                        pokemon);
+                locationAddPokemon(location, pokemon);
                 pokemonDestroy(pokemon);
             } else {
-                locationAddNearby(
-                        mapGet(pokemonGoGetLocations(pokemonGo), location_name),
-                        other_arg);
+                locationAddNearby(location, other_arg);
             }
             other_arg = strtok(NULL, DELIMITER);
         }
@@ -285,6 +269,8 @@ static MtmErrorCode fillADTS(PokemonGo pokemonGo, char *pokedex_file_name,
     if (fillLocations(locations_file, pokemonGo) == MTM_OUT_OF_MEMORY)
         return MTM_OUT_OF_MEMORY;
     fclose(locations_file);
+    if (pokemonGoIndexLocations(pokemonGo) == POKEMON_GO_OUT_OF_MEM)
+        return MTM_OUT_OF_MEMORY;
     return MTM_SUCCESS;
 }
 
@@ -342,18 +328,36 @@ int main(int argc, char **argv) {
         return printErrorAndExit(pokemonGo, MTM_CANNOT_OPEN_FILE);
     }
 
+    /* a command log is read in large blocks, and typed commands a line at a
+     * time; the output file is written in large blocks as well */
+    Reader reader = readerCreate(input, input == stdin);
+    if (!reader) {
+        if (input != stdin) {
+            fclose(input);
+        }
+        if (output != stdout) {
+            fclose(output);
+        }
+        return printErrorAndExit(pokemonGo, MTM_OUT_OF_MEMORY);
+    }
+    if (output != stdout) {
+        setvbuf(output, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+
     /*getting commands from stdin / file and executing the respective function*/
-    char current_command[MAX_INPUT_LEN];
+    char *current_command = NULL;
     MtmErrorCode error_code = MTM_SUCCESS;
-    while (fgets(current_command, MAX_INPUT_LEN, input) != NULL) {
+    while ((current_command = readerNextLine(reader)) != NULL) {
         handleCurrentCommand(output, current_command, pokemonGo, &error_code);
         if (error_code != MTM_SUCCESS) {
+            readerDestroy(reader);
             if (output != stdout) {
                 fclose(output);
             }
             return printErrorAndExit(pokemonGo, error_code);
         }
     }
+    readerDestroy(reader);
 
     /*closing the input/output if they are files*/
     if (input != stdin) {
@@ -0,0 +1,663 @@
+#include "map_mtm.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+* B-Tree Map Container
+*
+* Implements map_mtm.h with a B-tree of minimum degree MIN_DEGREE: every node
+* but the root holds between MIN_DEGREE - 1 and MAX_KEYS keys, packed with
+* their data in arrays, so a search compares O(log n) keys but visits only
+* O(log n / log MIN_DEGREE) nodes. Leaves are allocated without the children
+* array. A put searches down, inserts into a leaf and splits overflowing
+* nodes on the way back up; a remove fills minimal nodes on the way down.
+* A map created with an arena allocates its nodes in it.
+*
+* An iterator is the path from the root to the current key, so mapGetNext
+* and mapIterNext take constant amortized time. The internal iterator is a
+* MapIterator held in the map.
+*/
+
+#define MIN_DEGREE 16
+#define MAX_KEYS (2 * MIN_DEGREE - 1)
+#define MAX_DEPTH MAP_ITERATOR_DEPTH
+
+typedef struct node_t {
+    int size;
+    bool is_leaf;
+    // One more key and child than a node holds, for a put to overflow a
+    // node before it is split.
+    MapKeyElement keys[MAX_KEYS + 1];
+    MapDataElement data[MAX_KEYS + 1];
+    // MAX_KEYS + 2 children, allocated for internal nodes only.
+    struct node_t* children[];
+} *Node;
+
+struct Map_t {
+    int map_size;
+    Node root;
+    // An iterator: nodes[i]->children[positions[i]] is nodes[i + 1], and
+    // nodes[depth - 1]->keys[positions[depth - 1]] is the current key.
+    MapIterator iterator;
+    Arena arena;
+    copyMapKeyElements copyKey;
+    freeMapKeyElements freeKey;
+    copyMapDataElements copyData;
+    freeMapDataElements freeData;
+    compareMapKeyElements compareKeys;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+static size_t nodeSize(bool is_leaf) {
+    return sizeof(struct node_t) +
+           (is_leaf ? 0 : sizeof(Node) * (MAX_KEYS + 2));
+}
+/*----------------------------------------------------------------------------*/
+static Node nodeCreate(Map map, bool is_leaf) {
+    Node node = arenaAlloc(map->arena, nodeSize(is_leaf));
+    if (!node) {
+        return NULL;
+    }
+    node->size = 0;
+    node->is_leaf = is_leaf;
+    return node;
+}
+/*----------------------------------------------------------------------------*/
+static void nodeDestroy(Map map, Node node) {
+    if (!node) {
+        return;
+    }
+    for (int i = 0; i < node->size; ++i) {
+        map->freeData(node->data[i]);
+        map->freeKey(node->keys[i]);
+    }
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->size; ++i) {
+            nodeDestroy(map, node->children[i]);
+        }
+    }
+    arenaFree(map->arena, node, nodeSize(node->is_leaf));
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Copies a subtree, with copies of its keys and data. Returns NULL if an
+* allocation failed, having freed the partial copy.
+*/
+static Node nodeCopy(Map map, Node node) {
+    Node copy = nodeCreate(map, node->is_leaf);
+    if (!copy) {
+        return NULL;
+    }
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->size; ++i) {
+            copy->children[i] = NULL;
+        }
+    }
+    for (int i = 0; i < node->size; ++i) {
+        MapKeyElement key = map->copyKey(node->keys[i]);
+        MapDataElement data = key ? map->copyData(node->data[i]) : NULL;
+        if (!data) {
+            if (key) {
+                map->freeKey(key);
+            }
+            nodeDestroy(map, copy);
+            return NULL;
+        }
+        copy->keys[i] = key;
+        copy->data[i] = data;
+        copy->size++;
+    }
+    if (!node->is_leaf) {
+        for (int i = 0; i <= node->size; ++i) {
+            copy->children[i] = nodeCopy(map, node->children[i]);
+            if (!copy->children[i]) {
+                nodeDestroy(map, copy);
+                return NULL;
+            }
+        }
+    }
+    return copy;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the index of the first key of a node which is not smaller than a
+* given key, and sets found to whether it is equal to it.
+*/
+static int nodeFind(Map map, Node node, MapKeyElement key, bool* found) {
+    int low = 0, high = node->size;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        int cmp = map->compareKeys(node->keys[middle], key);
+        if (cmp == 0) {
+            *found = true;
+            return middle;
+        } else if (cmp < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    *found = false;
+    return low;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Inserts a key and data at an index of a node, and the child to the right of
+* the key if the node is internal.
+*/
+static void nodeInsertAt(Node node, int index, MapKeyElement key,
+                         MapDataElement data, Node right) {
+    int moved = node->size - index;
+    memmove(node->keys + index + 1, node->keys + index,
+            sizeof(*node->keys) * moved);
+    memmove(node->data + index + 1, node->data + index,
+            sizeof(*node->data) * moved);
+    node->keys[index] = key;
+    node->data[index] = data;
+    if (!node->is_leaf) {
+        memmove(node->children + index + 2, node->children + index + 1,
+                sizeof(*node->children) * moved);
+        node->children[index + 1] = right;
+    }
+    node->size++;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Removes the key and data at an index of a node, and the child to the right
+* of the key if the node is internal.
+*/
+static void nodeRemoveAt(Node node, int index) {
+    int moved = node->size - index - 1;
+    memmove(node->keys + index, node->keys + index + 1,
+            sizeof(*node->keys) * moved);
+    memmove(node->data + index, node->data + index + 1,
+            sizeof(*node->data) * moved);
+    if (!node->is_leaf) {
+        memmove(node->children + index + 1, node->children + index + 2,
+                sizeof(*node->children) * moved);
+    }
+    node->size--;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Splits an overflowing node: its keys above the median move to a given empty
+* node, and the median is left just past its last key, for the caller to move
+* up.
+*/
+static void nodeSplit(Node node, Node right) {
+    right->is_leaf = node->is_leaf;
+    right->size = MAX_KEYS - MIN_DEGREE;
+    memcpy(right->keys, node->keys + MIN_DEGREE + 1,
+           sizeof(*node->keys) * right->size);
+    memcpy(right->data, node->data + MIN_DEGREE + 1,
+           sizeof(*node->data) * right->size);
+    if (!node->is_leaf) {
+        memcpy(right->children, node->children + MIN_DEGREE + 1,
+               sizeof(*node->children) * (right->size + 1));
+    }
+    node->size = MIN_DEGREE;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Merges the child to the right of the key at an index of a node, and the
+* key, into the child to its left.
+*/
+static void nodeMergeChildren(Map map, Node node, int index) {
+    Node left = node->children[index];
+    Node right = node->children[index + 1];
+    left->keys[left->size] = node->keys[index];
+    left->data[left->size] = node->data[index];
+    memcpy(left->keys + left->size + 1, right->keys,
+           sizeof(*right->keys) * right->size);
+    memcpy(left->data + left->size + 1, right->data,
+           sizeof(*right->data) * right->size);
+    if (!left->is_leaf) {
+        memcpy(left->children + left->size + 1, right->children,
+               sizeof(*right->children) * (right->size + 1));
+    }
+    left->size += right->size + 1;
+    nodeRemoveAt(node, index);
+    arenaFree(map->arena, right, nodeSize(right->is_leaf));
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Makes sure the child at an index of a node has more than the minimal number
+* of keys, by moving a key from a sibling through the node or by merging it
+* with a sibling. Returns the index of the child to descend into, which
+* changes if the child was merged into its left sibling.
+*/
+static int nodeFillChild(Map map, Node node, int index) {
+    Node child = node->children[index];
+    if (child->size >= MIN_DEGREE) {
+        return index;
+    }
+    if (index > 0 && node->children[index - 1]->size >= MIN_DEGREE) {
+        Node left = node->children[index - 1];
+        memmove(child->keys + 1, child->keys,
+                sizeof(*child->keys) * child->size);
+        memmove(child->data + 1, child->data,
+                sizeof(*child->data) * child->size);
+        if (!child->is_leaf) {
+            memmove(child->children + 1, child->children,
+                    sizeof(*child->children) * (child->size + 1));
+            child->children[0] = left->children[left->size];
+        }
+        child->keys[0] = node->keys[index - 1];
+        child->data[0] = node->data[index - 1];
+        child->size++;
+        node->keys[index - 1] = left->keys[left->size - 1];
+        node->data[index - 1] = left->data[left->size - 1];
+        left->size--;
+        return index;
+    }
+    if (index < node->size && node->children[index + 1]->size >= MIN_DEGREE) {
+        Node right = node->children[index + 1];
+        nodeInsertAt(child, child->size, node->keys[index], node->data[index],
+                     child->is_leaf ? NULL : right->children[0]);
+        node->keys[index] = right->keys[0];
+        node->data[index] = right->data[0];
+        if (!right->is_leaf) {
+            memmove(right->children, right->children + 1,
+                    sizeof(*right->children) * right->size);
+        }
+        memmove(right->keys, right->keys + 1,
+                sizeof(*right->keys) * (right->size - 1));
+        memmove(right->data, right->data + 1,
+                sizeof(*right->data) * (right->size - 1));
+        right->size--;
+        return index;
+    }
+    if (index == node->size) {
+        index--;
+    }
+    nodeMergeChildren(map, node, index);
+    return index;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Detaches the largest (or smallest) key of a subtree whose root has more
+* than the minimal number of keys. The key and data are not freed.
+*/
+static void nodeDetachEdge(Map map, Node node, bool largest,
+                           MapKeyElement* key, MapDataElement* data) {
+    while (!node->is_leaf) {
+        int index = nodeFillChild(map, node, largest ? node->size : 0);
+        node = node->children[index];
+    }
+    int index = largest ? node->size - 1 : 0;
+    *key = node->keys[index];
+    *data = node->data[index];
+    nodeRemoveAt(node, index);
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Pushes the path from a node to the smallest key of its subtree onto the
+* iterator.
+*/
+static void iteratorDescend(MapIterator* iterator, Node node) {
+    while (true) {
+        iterator->nodes[iterator->depth] = node;
+        iterator->positions[iterator->depth] = 0;
+        iterator->depth++;
+        if (node->is_leaf) {
+            return;
+        }
+        node = node->children[0];
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Frees nodes which hold no keys.
+*/
+static void nodesFree(Map map, Node* nodes, int count) {
+    for (int i = 0; i < count; ++i) {
+        arenaFree(map->arena, nodes[i], nodeSize(nodes[i]->is_leaf));
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Puts a pair, copying the key and data unless the map is given their
+* ownership.
+*/
+static MapResult mapPutElements(Map map, MapKeyElement keyElement,
+                                MapDataElement dataElement, bool owned) {
+    if (!map || !keyElement || !dataElement) {
+        return MAP_NULL_ARGUMENT;
+    }
+    Node path[MAX_DEPTH];
+    int positions[MAX_DEPTH];
+    int depth = 0;
+    Node node = map->root;
+    while (true) {
+        bool found;
+        int index = nodeFind(map, node, keyElement, &found);
+        if (found) {
+            // Overriding the data of a key keeps the iterator.
+            MapDataElement data = owned ? dataElement
+                                        : map->copyData(dataElement);
+            if (!data) {
+                return MAP_OUT_OF_MEMORY;
+            }
+            map->freeData(node->data[index]);
+            node->data[index] = data;
+            if (owned) {
+                map->freeKey(keyElement);
+            }
+            return MAP_SUCCESS;
+        }
+        path[depth] = node;
+        positions[depth] = index;
+        depth++;
+        if (node->is_leaf) {
+            break;
+        }
+        node = node->children[index];
+    }
+    // Allocate the nodes for the splits (of the full nodes above the leaf,
+    // and a new root if they all are full) before changing anything. The
+    // node split off path[depth - splits + i] is new_nodes[i], and is a leaf
+    // exactly when that node is; only the new root is always internal.
+    Node new_nodes[MAX_DEPTH + 1];
+    int splits = 0;
+    while (splits < depth && path[depth - 1 - splits]->size == MAX_KEYS) {
+        splits++;
+    }
+    int allocations = splits + (splits == depth);
+    for (int i = 0; i < allocations; ++i) {
+        bool is_leaf = i < splits && path[depth - splits + i]->is_leaf;
+        new_nodes[i] = nodeCreate(map, is_leaf);
+        if (!new_nodes[i]) {
+            nodesFree(map, new_nodes, i);
+            return MAP_OUT_OF_MEMORY;
+        }
+    }
+    MapKeyElement key = keyElement;
+    MapDataElement data = dataElement;
+    if (!owned) {
+        key = map->copyKey(keyElement);
+        data = key ? map->copyData(dataElement) : NULL;
+        if (!data) {
+            if (key) {
+                map->freeKey(key);
+            }
+            nodesFree(map, new_nodes, allocations);
+            return MAP_OUT_OF_MEMORY;
+        }
+    }
+    map->iterator.depth = 0;
+    map->map_size++;
+    Node right = NULL;
+    for (int level = depth - 1; level >= 0; --level) {
+        node = path[level];
+        nodeInsertAt(node, positions[level], key, data, right);
+        if (node->size <= MAX_KEYS) {
+            return MAP_SUCCESS;
+        }
+        right = new_nodes[--splits];
+        nodeSplit(node, right);
+        key = node->keys[MIN_DEGREE];
+        data = node->data[MIN_DEGREE];
+    }
+    Node root = new_nodes[allocations - 1];
+    root->size = 1;
+    root->keys[0] = key;
+    root->data[0] = data;
+    root->children[0] = map->root;
+    root->children[1] = right;
+    map->root = root;
+    return MAP_SUCCESS;
+}
+
+//-------------------------- Main Functions ----------------------------------//
+
+Map mapCreate(copyMapKeyElements copyKeyElement,
+              copyMapDataElements copyDataElement,
+              freeMapKeyElements freeKeyElement,
+              freeMapDataElements freeDataElement,
+              compareMapKeyElements compareKeyElements) {
+    return mapCreateInArena(copyKeyElement, copyDataElement, freeKeyElement,
+                            freeDataElement, compareKeyElements, NULL, NULL);
+}
+/*----------------------------------------------------------------------------*/
+Map mapCreateHashed(copyMapKeyElements copyKeyElement,
+                    copyMapDataElements copyDataElement,
+                    freeMapKeyElements freeKeyElement,
+                    freeMapDataElements freeDataElement,
+                    compareMapKeyElements compareKeyElements,
+                    hashMapKeyElements hashKeyElement) {
+    return mapCreateInArena(copyKeyElement, copyDataElement, freeKeyElement,
+                            freeDataElement, compareKeyElements,
+                            hashKeyElement, NULL);
+}
+/*----------------------------------------------------------------------------*/
+Map mapCreateInArena(copyMapKeyElements copyKeyElement,
+                     copyMapDataElements copyDataElement,
+                     freeMapKeyElements freeKeyElement,
+                     freeMapDataElements freeDataElement,
+                     compareMapKeyElements compareKeyElements,
+                     hashMapKeyElements hashKeyElement, Arena arena) {
+    (void)hashKeyElement;
+    if (!copyKeyElement || !copyDataElement || !freeKeyElement ||
+        !freeDataElement || !compareKeyElements) {
+        return NULL;
+    }
+    Map map = arenaAlloc(arena, sizeof(*map));
+    if (!map) {
+        return NULL;
+    }
+    map->arena = arena;
+    map->root = nodeCreate(map, true);
+    if (!map->root) {
+        arenaFree(arena, map, sizeof(*map));
+        return NULL;
+    }
+    map->map_size = 0;
+    map->iterator.depth = 0;
+    map->copyKey = copyKeyElement;
+    map->freeKey = freeKeyElement;
+    map->copyData = copyDataElement;
+    map->freeData = freeDataElement;
+    map->compareKeys = compareKeyElements;
+    return map;
+}
+/*----------------------------------------------------------------------------*/
+void mapDestroy(Map map) {
+    if (!map) {
+        return;
+    }
+    nodeDestroy(map, map->root);
+    arenaFree(map->arena, map, sizeof(*map));
+}
+/*----------------------------------------------------------------------------*/
+Map mapCopy(Map map) {
+    if (!map) {
+        return NULL;
+    }
+    Map copy = arenaAlloc(map->arena, sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *map;
+    copy->iterator.depth = 0;
+    copy->root = nodeCopy(map, map->root);
+    if (!copy->root) {
+        arenaFree(map->arena, copy, sizeof(*copy));
+        return NULL;
+    }
+    return copy;
+}
+/*----------------------------------------------------------------------------*/
+int mapGetSize(Map map) {
+    if (!map) {
+        return -1;
+    }
+    return map->map_size;
+}
+/*----------------------------------------------------------------------------*/
+bool mapContains(Map map, MapKeyElement element) {
+    if (!map || !element) {
+        return false;
+    }
+    return mapGet(map, element) != NULL;
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement) {
+    return mapPutElements(map, keyElement, dataElement, false);
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapPutOwned(Map map, MapKeyElement keyElement,
+                      MapDataElement dataElement) {
+    return mapPutElements(map, keyElement, dataElement, true);
+}
+/*----------------------------------------------------------------------------*/
+MapDataElement mapGet(Map map, MapKeyElement keyElement) {
+    if (!map || !keyElement) {
+        return NULL;
+    }
+    Node node = map->root;
+    while (true) {
+        bool found;
+        int index = nodeFind(map, node, keyElement, &found);
+        if (found) {
+            return node->data[index];
+        }
+        if (node->is_leaf) {
+            return NULL;
+        }
+        node = node->children[index];
+    }
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapRemove(Map map, MapKeyElement keyElement) {
+    if (!map || !keyElement) {
+        return MAP_NULL_ARGUMENT;
+    }
+    map->iterator.depth = 0;
+    MapResult result = MAP_ITEM_DOES_NOT_EXIST;
+    Node node = map->root;
+    while (true) {
+        bool found;
+        int index = nodeFind(map, node, keyElement, &found);
+        if (found && node->is_leaf) {
+            map->freeData(node->data[index]);
+            map->freeKey(node->keys[index]);
+            nodeRemoveAt(node, index);
+            result = MAP_SUCCESS;
+            break;
+        }
+        if (found) {
+            // Replace the key by its predecessor or successor from a child
+            // which can spare it, or else merge the two children around it
+            // and remove it from the merged child.
+            Node left = node->children[index];
+            Node right = node->children[index + 1];
+            if (left->size >= MIN_DEGREE || right->size >= MIN_DEGREE) {
+                map->freeData(node->data[index]);
+                map->freeKey(node->keys[index]);
+                nodeDetachEdge(map, left->size >= MIN_DEGREE ? left : right,
+                               left->size >= MIN_DEGREE,
+                               &node->keys[index], &node->data[index]);
+                result = MAP_SUCCESS;
+                break;
+            }
+            nodeMergeChildren(map, node, index);
+            node = left;
+            continue;
+        }
+        if (node->is_leaf) {
+            break;
+        }
+        node = node->children[nodeFillChild(map, node, index)];
+    }
+    if (map->root->size == 0 && !map->root->is_leaf) {
+        Node root = map->root;
+        map->root = root->children[0];
+        arenaFree(map->arena, root, nodeSize(false));
+    }
+    if (result == MAP_SUCCESS) {
+        map->map_size--;
+    }
+    return result;
+}
+/*----------------------------------------------------------------------------*/
+MapKeyElement mapGetFirst(Map map) {
+    if (!map) {
+        return NULL;
+    }
+    mapIterBegin(map, &map->iterator);
+    return mapIterKey(&map->iterator);
+}
+/*----------------------------------------------------------------------------*/
+MapKeyElement mapGetNext(Map map) {
+    if (!map) {
+        return NULL;
+    }
+    mapIterNext(&map->iterator);
+    return mapIterKey(&map->iterator);
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapIterBegin(Map map, MapIterator* iterator) {
+    if (!map || !iterator) {
+        if (iterator) {
+            iterator->depth = 0;
+        }
+        return MAP_NULL_ARGUMENT;
+    }
+    iterator->map = map;
+    iterator->depth = 0;
+    if (map->map_size > 0) {
+        iteratorDescend(iterator, map->root);
+    }
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+void mapIterNext(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return;
+    }
+    Node node = iterator->nodes[iterator->depth - 1];
+    int position = ++iterator->positions[iterator->depth - 1];
+    if (!node->is_leaf) {
+        iteratorDescend(iterator, node->children[position]);
+        return;
+    }
+    while (position >= node->size) {
+        if (--iterator->depth == 0) {
+            return;
+        }
+        node = iterator->nodes[iterator->depth - 1];
+        position = iterator->positions[iterator->depth - 1];
+    }
+}
+/*----------------------------------------------------------------------------*/
+MapKeyElement mapIterKey(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return NULL;
+    }
+    Node node = iterator->nodes[iterator->depth - 1];
+    return node->keys[iterator->positions[iterator->depth - 1]];
+}
+/*----------------------------------------------------------------------------*/
+MapDataElement mapIterData(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return NULL;
+    }
+    Node node = iterator->nodes[iterator->depth - 1];
+    return node->data[iterator->positions[iterator->depth - 1]];
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapClear(Map map) {
+    if (!map) {
+        return MAP_NULL_ARGUMENT;
+    }
+    Node root = nodeCreate(map, true);
+    if (!root) {
+        return MAP_OUT_OF_MEMORY;
+    }
+    nodeDestroy(map, map->root);
+    map->root = root;
+    map->map_size = 0;
+    map->iterator.depth = 0;
+    return MAP_SUCCESS;
+}
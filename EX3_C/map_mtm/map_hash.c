@@ -0,0 +1,598 @@
+#include "map_mtm.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+* Hash Table Map Container
+*
+* Implements map_mtm.h with the pairs stored densely in an array of entries,
+* in no particular order, and found through an open addressing (linear
+* probing) table of entry indexes. Removing a pair moves the last entry into
+* its place, so the entries stay dense.
+*
+* The order of iteration is kept in a separate sorted view: an array of entry
+* indexes sorted by the compare function. It is built on demand by
+* mapGetFirst. Puts of new keys only append to the entries, so the view then
+* stays sorted up to the appended entries, which are sorted and merged into
+* it; a remove invalidates the whole view. Both the internal iterator and the
+* external ones are positions in the view.
+*
+* A map created without a hash function has no table. Its sorted view is
+* always kept up to date instead, and keys are found in it by binary search.
+*
+* A map created with an arena allocates only its struct in it: the arrays
+* grow by reallocation, and are few and large, so they stay on the heap.
+*/
+
+#define INITIAL_CAPACITY 8
+#define EMPTY_SLOT -1
+#define NO_ITERATOR -1
+
+typedef struct entry_t {
+    MapKeyElement key;
+    MapDataElement data;
+    unsigned int hash;
+} *Entry;
+
+/** A slot of the table. The hash is kept to skip most compares. */
+typedef struct slot_t {
+    unsigned int hash;
+    int entry;
+} *Slot;
+
+struct Map_t {
+    int map_size;
+    int capacity;
+    struct entry_t* entries;
+    struct slot_t* slots;
+    int slots_mask;
+    int* sorted;
+    int sorted_size;
+    int* merge_buffer;
+    int iterator;
+    copyMapKeyElements copyKey;
+    freeMapKeyElements freeKey;
+    copyMapDataElements copyData;
+    freeMapDataElements freeData;
+    compareMapKeyElements compareKeys;
+    hashMapKeyElements hashKey;
+    Arena arena;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Spreads the bits of a user hash, so keys hashed to consecutive or aligned
+* values (e.g. ints hashed to themselves) don't cluster in the table.
+*/
+static unsigned int hashMix(unsigned int hash) {
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bU;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35U;
+    hash ^= hash >> 16;
+    return hash;
+}
+/*----------------------------------------------------------------------------*/
+static int compareEntries(Map map, int entry1, int entry2) {
+    return map->compareKeys(map->entries[entry1].key,
+                            map->entries[entry2].key);
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the slot of a key in the table, or the empty slot where it would
+* be put.
+*/
+static int slotFind(Map map, MapKeyElement key, unsigned int hash) {
+    int slot = (int)(hash & (unsigned int)map->slots_mask);
+    while (map->slots[slot].entry != EMPTY_SLOT) {
+        if (map->slots[slot].hash == hash &&
+            map->compareKeys(map->entries[map->slots[slot].entry].key,
+                             key) == 0) {
+            return slot;
+        }
+        slot = (slot + 1) & map->slots_mask;
+    }
+    return slot;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the slot which holds an entry index. The entry must be in the table.
+*/
+static int slotOfEntry(Map map, int entry) {
+    int slot = (int)(map->entries[entry].hash & (unsigned int)map->slots_mask);
+    while (map->slots[slot].entry != entry) {
+        slot = (slot + 1) & map->slots_mask;
+    }
+    return slot;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Empties a slot, moving back the following slots of its probe run which
+* would otherwise not be found.
+*/
+static void slotRemove(Map map, int slot) {
+    int next = slot;
+    while (true) {
+        next = (next + 1) & map->slots_mask;
+        if (map->slots[next].entry == EMPTY_SLOT) {
+            break;
+        }
+        int home = (int)(map->slots[next].hash & (unsigned int)map->slots_mask);
+        // The entry in next may move to slot iff its home is not in
+        // (slot, next], cyclically.
+        bool in_between = slot <= next ? (slot < home && home <= next)
+                                       : (slot < home || home <= next);
+        if (!in_between) {
+            map->slots[slot] = map->slots[next];
+            slot = next;
+        }
+    }
+    map->slots[slot].entry = EMPTY_SLOT;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Rebuilds the table with a given number of slots (a power of 2).
+*/
+static MapResult slotsResize(Map map, int slots_num) {
+    Slot slots = malloc(sizeof(*slots) * slots_num);
+    if (!slots) {
+        return MAP_OUT_OF_MEMORY;
+    }
+    free(map->slots);
+    map->slots = slots;
+    map->slots_mask = slots_num - 1;
+    for (int i = 0; i < slots_num; ++i) {
+        slots[i].entry = EMPTY_SLOT;
+    }
+    for (int i = 0; i < map->map_size; ++i) {
+        int slot = (int)(map->entries[i].hash & (unsigned int)map->slots_mask);
+        while (slots[slot].entry != EMPTY_SLOT) {
+            slot = (slot + 1) & map->slots_mask;
+        }
+        slots[slot].hash = map->entries[i].hash;
+        slots[slot].entry = i;
+    }
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Makes room for one more entry, growing the entries, the sorted view and the
+* table (which is kept at most half full).
+*/
+static MapResult mapReserve(Map map) {
+    if (map->map_size == map->capacity) {
+        int capacity = map->capacity * 2;
+        Entry entries = realloc(map->entries, sizeof(*entries) * capacity);
+        if (!entries) {
+            return MAP_OUT_OF_MEMORY;
+        }
+        map->entries = entries;
+        int* sorted = realloc(map->sorted, sizeof(*sorted) * capacity);
+        if (!sorted) {
+            return MAP_OUT_OF_MEMORY;
+        }
+        map->sorted = sorted;
+        free(map->merge_buffer);
+        map->merge_buffer = NULL;
+        map->capacity = capacity;
+    }
+    if (map->slots && (map->map_size + 1) * 2 > map->slots_mask + 1) {
+        return slotsResize(map, (map->slots_mask + 1) * 2);
+    }
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the position of a key in the sorted view, or the complement (~) of
+* the position where it would be inserted.
+*/
+static int sortedFind(Map map, MapKeyElement key) {
+    int low = 0, high = map->sorted_size;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        int cmp = map->compareKeys(map->entries[map->sorted[middle]].key, key);
+        if (cmp == 0) {
+            return middle;
+        } else if (cmp < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return ~low;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Merges the sorted runs indexes[0..half) and indexes[half..size), using
+* buffer for at least half indexes.
+*/
+static void indexesMerge(Map map, int* indexes, int* buffer, int half,
+                         int size) {
+    if (half == 0 || half == size ||
+        compareEntries(map, indexes[half - 1], indexes[half]) <= 0) {
+        return;
+    }
+    memcpy(buffer, indexes, sizeof(*indexes) * half);
+    int left = 0, right = half, out = 0;
+    while (left < half && right < size) {
+        if (compareEntries(map, indexes[right], buffer[left]) < 0) {
+            indexes[out++] = indexes[right++];
+        } else {
+            indexes[out++] = buffer[left++];
+        }
+    }
+    while (left < half) {
+        indexes[out++] = buffer[left++];
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Sorts indexes[0..size) by their keys (merge sort), using buffer for at
+* least size / 2 indexes.
+*/
+static void indexesSort(Map map, int* indexes, int* buffer, int size) {
+    if (size < 2) {
+        return;
+    }
+    int half = size / 2;
+    indexesSort(map, indexes, buffer, half);
+    indexesSort(map, indexes + half, buffer, size - half);
+    indexesMerge(map, indexes, buffer, half, size);
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Brings the sorted view up to date: sorts the entries appended since it was
+* last sorted and merges them into it.
+*/
+static MapResult sortedUpdate(Map map) {
+    int old_size = map->sorted_size;
+    if (old_size == map->map_size) {
+        return MAP_SUCCESS;
+    }
+    if (!map->merge_buffer) {
+        map->merge_buffer = malloc(sizeof(int) * map->capacity);
+        if (!map->merge_buffer) {
+            return MAP_OUT_OF_MEMORY;
+        }
+    }
+    for (int i = old_size; i < map->map_size; ++i) {
+        map->sorted[i] = i;
+    }
+    indexesSort(map, map->sorted + old_size, map->merge_buffer,
+                map->map_size - old_size);
+    indexesMerge(map, map->sorted, map->merge_buffer, old_size,
+                 map->map_size);
+    map->sorted_size = map->map_size;
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the index of the entry of a key, or -1 if it's not in the map.
+*/
+static int entryFind(Map map, MapKeyElement key) {
+    if (map->slots) {
+        int slot = slotFind(map, key, hashMix(map->hashKey(key)));
+        return map->slots[slot].entry;
+    }
+    int position = sortedFind(map, key);
+    return position < 0 ? -1 : map->sorted[position];
+}
+/*----------------------------------------------------------------------------*/
+static void entriesFree(Map map) {
+    for (int i = 0; i < map->map_size; ++i) {
+        map->freeData(map->entries[i].data);
+        map->freeKey(map->entries[i].key);
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Puts a pair, copying the key and data unless the map is given their
+* ownership.
+*/
+static MapResult mapPutElements(Map map, MapKeyElement keyElement,
+                                MapDataElement dataElement, bool owned) {
+    if (!map || !keyElement || !dataElement) {
+        return MAP_NULL_ARGUMENT;
+    }
+    unsigned int hash = map->slots ? hashMix(map->hashKey(keyElement)) : 0;
+    int slot = 0, position = 0, entry;
+    if (map->slots) {
+        slot = slotFind(map, keyElement, hash);
+        entry = map->slots[slot].entry;
+    } else {
+        position = sortedFind(map, keyElement);
+        entry = position < 0 ? -1 : map->sorted[position];
+    }
+    if (entry != -1) {
+        MapDataElement data = owned ? dataElement : map->copyData(dataElement);
+        if (!data) {
+            return MAP_OUT_OF_MEMORY;
+        }
+        map->freeData(map->entries[entry].data);
+        map->entries[entry].data = data;
+        if (owned) {
+            map->freeKey(keyElement);
+        }
+        return MAP_SUCCESS;
+    }
+    map->iterator = NO_ITERATOR;
+    if (mapReserve(map) != MAP_SUCCESS) {
+        return MAP_OUT_OF_MEMORY;
+    }
+    MapKeyElement key = keyElement;
+    MapDataElement data = dataElement;
+    if (!owned) {
+        key = map->copyKey(keyElement);
+        data = key ? map->copyData(dataElement) : NULL;
+        if (!data) {
+            if (key) {
+                map->freeKey(key);
+            }
+            return MAP_OUT_OF_MEMORY;
+        }
+    }
+    entry = map->map_size++;
+    map->entries[entry].key = key;
+    map->entries[entry].data = data;
+    map->entries[entry].hash = hash;
+    if (map->slots) {
+        // The table may have been rebuilt by mapReserve.
+        slot = slotFind(map, key, hash);
+        map->slots[slot].hash = hash;
+        map->slots[slot].entry = entry;
+    } else {
+        position = ~position;
+        memmove(map->sorted + position + 1, map->sorted + position,
+                sizeof(*map->sorted) * (map->sorted_size - position));
+        map->sorted[position] = entry;
+        map->sorted_size++;
+    }
+    return MAP_SUCCESS;
+}
+
+//-------------------------- Main Functions ----------------------------------//
+
+Map mapCreate(copyMapKeyElements copyKeyElement,
+              copyMapDataElements copyDataElement,
+              freeMapKeyElements freeKeyElement,
+              freeMapDataElements freeDataElement,
+              compareMapKeyElements compareKeyElements) {
+    return mapCreateHashed(copyKeyElement, copyDataElement, freeKeyElement,
+                           freeDataElement, compareKeyElements, NULL);
+}
+/*----------------------------------------------------------------------------*/
+Map mapCreateHashed(copyMapKeyElements copyKeyElement,
+                    copyMapDataElements copyDataElement,
+                    freeMapKeyElements freeKeyElement,
+                    freeMapDataElements freeDataElement,
+                    compareMapKeyElements compareKeyElements,
+                    hashMapKeyElements hashKeyElement) {
+    return mapCreateInArena(copyKeyElement, copyDataElement, freeKeyElement,
+                            freeDataElement, compareKeyElements,
+                            hashKeyElement, NULL);
+}
+/*----------------------------------------------------------------------------*/
+Map mapCreateInArena(copyMapKeyElements copyKeyElement,
+                     copyMapDataElements copyDataElement,
+                     freeMapKeyElements freeKeyElement,
+                     freeMapDataElements freeDataElement,
+                     compareMapKeyElements compareKeyElements,
+                     hashMapKeyElements hashKeyElement, Arena arena) {
+    if (!copyKeyElement || !copyDataElement || !freeKeyElement ||
+        !freeDataElement || !compareKeyElements) {
+        return NULL;
+    }
+    Map map = arenaAlloc(arena, sizeof(*map));
+    if (!map) {
+        return NULL;
+    }
+    map->arena = arena;
+    map->map_size = 0;
+    map->capacity = INITIAL_CAPACITY;
+    map->entries = malloc(sizeof(*map->entries) * INITIAL_CAPACITY);
+    map->sorted = malloc(sizeof(*map->sorted) * INITIAL_CAPACITY);
+    map->slots = NULL;
+    map->slots_mask = 0;
+    map->sorted_size = 0;
+    map->merge_buffer = NULL;
+    map->iterator = NO_ITERATOR;
+    map->copyKey = copyKeyElement;
+    map->freeKey = freeKeyElement;
+    map->copyData = copyDataElement;
+    map->freeData = freeDataElement;
+    map->compareKeys = compareKeyElements;
+    map->hashKey = hashKeyElement;
+    if (!map->entries || !map->sorted || (hashKeyElement &&
+        slotsResize(map, 2 * INITIAL_CAPACITY) != MAP_SUCCESS)) {
+        mapDestroy(map);
+        return NULL;
+    }
+    return map;
+}
+/*----------------------------------------------------------------------------*/
+void mapDestroy(Map map) {
+    if (!map) {
+        return;
+    }
+    entriesFree(map);
+    free(map->entries);
+    free(map->slots);
+    free(map->sorted);
+    free(map->merge_buffer);
+    arenaFree(map->arena, map, sizeof(*map));
+}
+/*----------------------------------------------------------------------------*/
+Map mapCopy(Map map) {
+    if (!map) {
+        return NULL;
+    }
+    Map copy = mapCreateInArena(map->copyKey, map->copyData, map->freeKey,
+                                map->freeData, map->compareKeys, map->hashKey,
+                                map->arena);
+    if (!copy) {
+        return NULL;
+    }
+    for (int i = 0; i < map->map_size; ++i) {
+        if (mapPut(copy, map->entries[i].key, map->entries[i].data) !=
+            MAP_SUCCESS) {
+            mapDestroy(copy);
+            return NULL;
+        }
+    }
+    return copy;
+}
+/*----------------------------------------------------------------------------*/
+int mapGetSize(Map map) {
+    if (!map) {
+        return -1;
+    }
+    return map->map_size;
+}
+/*----------------------------------------------------------------------------*/
+bool mapContains(Map map, MapKeyElement element) {
+    if (!map || !element) {
+        return false;
+    }
+    return entryFind(map, element) != -1;
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement) {
+    return mapPutElements(map, keyElement, dataElement, false);
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapPutOwned(Map map, MapKeyElement keyElement,
+                      MapDataElement dataElement) {
+    return mapPutElements(map, keyElement, dataElement, true);
+}
+/*----------------------------------------------------------------------------*/
+MapDataElement mapGet(Map map, MapKeyElement keyElement) {
+    if (!map || !keyElement) {
+        return NULL;
+    }
+    int entry = entryFind(map, keyElement);
+    return entry == -1 ? NULL : map->entries[entry].data;
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapRemove(Map map, MapKeyElement keyElement) {
+    if (!map || !keyElement) {
+        return MAP_NULL_ARGUMENT;
+    }
+    int entry;
+    if (map->slots) {
+        int slot = slotFind(map, keyElement, hashMix(map->hashKey(keyElement)));
+        entry = map->slots[slot].entry;
+        if (entry == -1) {
+            return MAP_ITEM_DOES_NOT_EXIST;
+        }
+        slotRemove(map, slot);
+        map->sorted_size = 0;
+    } else {
+        int position = sortedFind(map, keyElement);
+        if (position < 0) {
+            return MAP_ITEM_DOES_NOT_EXIST;
+        }
+        entry = map->sorted[position];
+        memmove(map->sorted + position, map->sorted + position + 1,
+                sizeof(*map->sorted) * (map->sorted_size - position - 1));
+        map->sorted_size--;
+    }
+    map->iterator = NO_ITERATOR;
+    map->freeData(map->entries[entry].data);
+    map->freeKey(map->entries[entry].key);
+    int last = --map->map_size;
+    if (entry == last) {
+        return MAP_SUCCESS;
+    }
+    // Move the last entry into the hole, and point to it at its new index.
+    map->entries[entry] = map->entries[last];
+    if (map->slots) {
+        map->slots[slotOfEntry(map, last)].entry = entry;
+    } else {
+        map->sorted[sortedFind(map, map->entries[entry].key)] = entry;
+    }
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+MapKeyElement mapGetFirst(Map map) {
+    if (!map) {
+        return NULL;
+    }
+    map->iterator = NO_ITERATOR;
+    if (map->map_size == 0 || sortedUpdate(map) != MAP_SUCCESS) {
+        return NULL;
+    }
+    map->iterator = 0;
+    return map->entries[map->sorted[0]].key;
+}
+/*----------------------------------------------------------------------------*/
+MapKeyElement mapGetNext(Map map) {
+    if (!map || map->iterator == NO_ITERATOR) {
+        return NULL;
+    }
+    if (++map->iterator >= map->sorted_size) {
+        map->iterator = NO_ITERATOR;
+        return NULL;
+    }
+    return map->entries[map->sorted[map->iterator]].key;
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapIterBegin(Map map, MapIterator* iterator) {
+    if (!map || !iterator) {
+        if (iterator) {
+            iterator->depth = 0;
+        }
+        return MAP_NULL_ARGUMENT;
+    }
+    // The iterator is at positions[0] of the sorted view, unless its depth
+    // is 0.
+    iterator->map = map;
+    iterator->positions[0] = 0;
+    iterator->depth = 0;
+    if (sortedUpdate(map) != MAP_SUCCESS) {
+        return MAP_OUT_OF_MEMORY;
+    }
+    iterator->depth = map->map_size > 0;
+    return MAP_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+void mapIterNext(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return;
+    }
+    if (++iterator->positions[0] >= iterator->map->sorted_size) {
+        iterator->depth = 0;
+    }
+}
+/*----------------------------------------------------------------------------*/
+MapKeyElement mapIterKey(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return NULL;
+    }
+    Map map = iterator->map;
+    return map->entries[map->sorted[iterator->positions[0]]].key;
+}
+/*----------------------------------------------------------------------------*/
+MapDataElement mapIterData(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return NULL;
+    }
+    Map map = iterator->map;
+    return map->entries[map->sorted[iterator->positions[0]]].data;
+}
+/*----------------------------------------------------------------------------*/
+MapResult mapClear(Map map) {
+    if (!map) {
+        return MAP_NULL_ARGUMENT;
+    }
+    entriesFree(map);
+    map->map_size = 0;
+    map->sorted_size = 0;
+    map->iterator = NO_ITERATOR;
+    if (map->slots) {
+        for (int i = 0; i <= map->slots_mask; ++i) {
+            map->slots[i].entry = EMPTY_SLOT;
+        }
+    }
+    return MAP_SUCCESS;
+}
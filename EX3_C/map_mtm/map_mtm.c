@@ -1,4 +1,4 @@
-#include "map_dry.h"
+#include "map_mtm.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -51,6 +51,7 @@ struct Map_t {
     int map_size;
     Node head;
     Node iterator;
+    Arena arena;
     copyMapKeyElements copyKey;
     freeMapKeyElements freeKey;
     copyMapDataElements copyData;
@@ -61,7 +62,7 @@ struct Map_t {
 void mapPrint(Map map) {
     Node iterator = map->head;
     while (iterator != NULL) {
-        printf("%d -> ",(int)iterator->key);
+        printf("%p -> ",iterator->key);
         iterator = iterator->next;
     }
 }
@@ -88,17 +89,48 @@ Map mapCreate(copyMapKeyElements copyKeyElement,
               freeMapKeyElements freeKeyElement,
               freeMapDataElements freeDataElement,
               compareMapKeyElements compareKeyElements) {
+    return mapCreateInArena(copyKeyElement, copyDataElement, freeKeyElement,
+                            freeDataElement, compareKeyElements, NULL, NULL);
+}
+
+/**
+* mapCreateHashed: Allocates a new empty map. The list keeps its keys sorted,
+* so the hash function is not used.
+*/
+Map mapCreateHashed(copyMapKeyElements copyKeyElement,
+                    copyMapDataElements copyDataElement,
+                    freeMapKeyElements freeKeyElement,
+                    freeMapDataElements freeDataElement,
+                    compareMapKeyElements compareKeyElements,
+                    hashMapKeyElements hashKeyElement) {
+    return mapCreateInArena(copyKeyElement, copyDataElement, freeKeyElement,
+                            freeDataElement, compareKeyElements,
+                            hashKeyElement, NULL);
+}
+
+/**
+* mapCreateInArena: Allocates a new empty map, whose struct and nodes are
+* allocated in an arena. The hash function is not used.
+*/
+Map mapCreateInArena(copyMapKeyElements copyKeyElement,
+                     copyMapDataElements copyDataElement,
+                     freeMapKeyElements freeKeyElement,
+                     freeMapDataElements freeDataElement,
+                     compareMapKeyElements compareKeyElements,
+                     hashMapKeyElements hashKeyElement, Arena arena) {
+    (void)hashKeyElement;
     if (!copyKeyElement || !copyDataElement || !freeKeyElement ||
-        !freeKeyElement || !compareKeyElements) {
+        !freeDataElement || !compareKeyElements) {
         return NULL;
     }
-    Map new_map = malloc(sizeof(*new_map));
+    Map new_map = arenaAlloc(arena, sizeof(*new_map));
     if (!new_map) {
         return NULL;
     }
     new_map->map_size = 0;
     new_map->head = NULL;
     new_map->iterator = NULL;
+    new_map->arena = arena;
     new_map->copyKey = copyKeyElement;
     new_map->freeKey = freeKeyElement;
     new_map->copyData = copyDataElement;
@@ -107,8 +139,8 @@ Map mapCreate(copyMapKeyElements copyKeyElement,
     return new_map;
 }
 
-static Node nodeCreate(MapKeyElement key, MapDataElement data) {
-    Node new_node = malloc(sizeof(*new_node));
+static Node nodeCreate(Map map, MapKeyElement key, MapDataElement data) {
+    Node new_node = arenaAlloc(map->arena, sizeof(*new_node));
     if (!new_node) {
         return NULL;
     }
@@ -124,7 +156,56 @@ static void nodeDestroy(Map map, Node node) {
     }
     map->freeData(node->data);
     map->freeKey(node->key);
-    free(node);
+    arenaFree(map->arena, node, sizeof(*node));
+}
+
+/**
+* Puts a pair, copying the key and data unless the map is given their
+* ownership.
+*/
+static MapResult mapPutElements(Map map, MapKeyElement keyElement,
+                                MapDataElement dataElement, bool owned) {
+    if (!map || !keyElement || !dataElement) {
+        return MAP_NULL_ARGUMENT;
+    }
+    Node* next = &map->head;
+    int cmp = 1;
+    while (*next != NULL &&
+           (cmp = map->compareKeys((*next)->key, keyElement)) < 0) {
+        next = &(*next)->next;
+    }
+    if (*next != NULL && cmp == 0) {
+        MapDataElement data = owned ? dataElement : map->copyData(dataElement);
+        if (!data) {
+            return MAP_OUT_OF_MEMORY;
+        }
+        map->freeData((*next)->data);
+        (*next)->data = data;
+        if (owned) {
+            map->freeKey(keyElement);
+        }
+        return MAP_SUCCESS;
+    }
+    Node new_node = nodeCreate(map,keyElement,dataElement);
+    if (!new_node) {
+        return MAP_OUT_OF_MEMORY;
+    }
+    if (!owned) {
+        new_node->key = map->copyKey(keyElement);
+        new_node->data = new_node->key ? map->copyData(dataElement) : NULL;
+        if (!new_node->data) {
+            if (new_node->key) {
+                map->freeKey(new_node->key);
+            }
+            arenaFree(map->arena, new_node, sizeof(*new_node));
+            return MAP_OUT_OF_MEMORY;
+        }
+    }
+    new_node->next = *next;
+    *next = new_node;
+    map->iterator = NULL;
+    map->map_size++;
+    return MAP_SUCCESS;
 }
 
 /**
@@ -139,7 +220,7 @@ void mapDestroy(Map map) {
         return;
     }
     mapClear(map);
-    free(map);
+    arenaFree(map->arena, map, sizeof(*map));
 }
 
 /**
@@ -155,20 +236,30 @@ Map mapCopy(Map map) {
     if (!map) {
         return NULL;
     }
-    Map copy = mapCreate(map->copyKey,map->copyData,map->freeKey,map->freeData,
-                         map->compareKeys);
+    Map copy = mapCreateInArena(map->copyKey,map->copyData,map->freeKey,
+                                map->freeData,map->compareKeys,NULL,
+                                map->arena);
     if (!copy) {
         return NULL;
     }
-    Node temp_node = map->iterator;
-    MAP_FOREACH (Node,node_iterator,map) {
-        if (mapPut(copy,node_iterator->key,node_iterator->data) != MAP_SUCCESS) {
+    Node* last = &copy->head;
+    for (Node node = map->head; node != NULL; node = node->next) {
+        MapKeyElement key = map->copyKey(node->key);
+        MapDataElement data = key ? map->copyData(node->data) : NULL;
+        *last = data ? nodeCreate(copy,key,data) : NULL;
+        if (!*last) {
+            if (data) {
+                map->freeData(data);
+            }
+            if (key) {
+                map->freeKey(key);
+            }
             mapDestroy(copy);
             return NULL;
         }
+        last = &(*last)->next;
+        copy->map_size++;
     }
-    map->iterator = temp_node;
-    copy->iterator = temp_node;
     return copy;
 }
 
@@ -199,12 +290,7 @@ int mapGetSize(Map map) {
 * 	true - if the key element was found in the map.
 */
 bool mapContains(Map map, MapKeyElement element) {
-    MAP_FOREACH (Node,node_iterator,map) {
-        if (map->compareKeys(element,node_iterator->key) == 0) {
-            return true;
-        }
-    }
-    return false;
+    return mapGet(map,element) != NULL;
 }
 
 /**
@@ -224,43 +310,22 @@ bool mapContains(Map map, MapKeyElement element) {
 * 	MAP_SUCCESS the paired elements had been inserted successfully
 */
 MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement) {
-    if (!map || !keyElement || !dataElement) {
-        return MAP_NULL_ARGUMENT;
-    }
-    if (!map->head) {
-        map->head = nodeCreate(map->copyKey(keyElement),map->copyData(dataElement));
-        if ( !map->head ){
-            return MAP_OUT_OF_MEMORY;
-        }
-        map->iterator = map->head; 
-        map->map_size++;
-        return MAP_SUCCESS;
-    }
-    map->iterator = map->head;
-    Node prev = map->head;
-    while (map->iterator != NULL) {
-        if (map->compareKeys(map->iterator->next, keyElement) == 0) {
-            map->freeData(map->iterator->data);
-            map->iterator->data = map->copyData(dataElement);
-            if (!map->iterator->data) {
-                return MAP_OUT_OF_MEMORY;
-            }
-        } else if (map->compareKeys(map->iterator->next->key,keyElement) > 0 &&
-                   map->compareKeys(keyElement,map->iterator->key) > 0) {
-            Node new_node = nodeCreate(map->copyKey(keyElement),map->copyData(dataElement));
-            if ( !new_node ){
-                return MAP_OUT_OF_MEMORY;
-            }
-            new_node->next = map->iterator->next;
-            map->iterator->next = new_node; 
-            map->map_size++;
-            return MAP_SUCCESS;
-        }
-        map->iterator = map->iterator->next; 
-        prev = prev->next;
-    }
-    map->map_size++;
-    return MAP_SUCCESS;
+    return mapPutElements(map,keyElement,dataElement,false);
+}
+
+/**
+*	mapPutOwned: Gives a specified key a specific value, taking ownership of
+*	the given key and data elements instead of copying them.
+*  Iterator's value is undefined after this operation.
+*
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, key, or data
+* 	MAP_OUT_OF_MEMORY if an allocation failed (the caller keeps the elements)
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult mapPutOwned(Map map, MapKeyElement keyElement,
+                      MapDataElement dataElement) {
+    return mapPutElements(map,keyElement,dataElement,true);
 }
 
 /**
@@ -278,12 +343,13 @@ MapDataElement mapGet(Map map, MapKeyElement keyElement) {
     if (!map || !keyElement) {
         return NULL;
     }
-    map->iterator = map->head;
-    while (map->iterator != NULL) {
-        if (map->compareKeys(map->iterator->key, keyElement) == 0) {
-            return map->iterator->data;
+    for (Node node = map->head; node != NULL; node = node->next) {
+        int cmp = map->compareKeys(node->key, keyElement);
+        if (cmp == 0) {
+            return node->data;
+        } else if (cmp > 0) {
+            break;
         }
-        map->iterator = map->iterator->next;
     }
     return NULL;
 }
@@ -310,19 +376,15 @@ MapResult mapRemove(Map map, MapKeyElement keyElement) {
     if (!map || !keyElement) {
         return MAP_NULL_ARGUMENT;
     }
-    if (mapGetSize(map) == 1) {
-        nodeDestroy(map,mapGetFirst(map));
-        map->iterator = NULL;
-        return MAP_SUCCESS;
-    }
-    Node prev = mapGetFirst(map);
-    MAP_FOREACH (Node,node_iterator,map) {
-        if (map->compareKeys(keyElement,node_iterator->key) == 0) {
-            nodeDestroy(map,node_iterator);
-            prev->next = node_iterator->next;
+    for (Node* next = &map->head; *next != NULL; next = &(*next)->next) {
+        if (map->compareKeys((*next)->key, keyElement) == 0) {
+            Node node = *next;
+            *next = node->next;
+            nodeDestroy(map,node);
+            map->iterator = NULL;
+            map->map_size--;
             return MAP_SUCCESS;
         }
-        prev = node_iterator;
     }
     return MAP_ITEM_DOES_NOT_EXIST;
 }
@@ -344,7 +406,7 @@ MapKeyElement mapGetFirst(Map map) {
         return NULL;
     }
     map->iterator=map->head;
-    return map->head;
+    return map->head ? map->head->key : NULL;
 }
 
 /**
@@ -360,7 +422,70 @@ MapKeyElement mapGetNext(Map map) {
         return NULL;
     }
     map->iterator = map->iterator->next;
-    return map->iterator->key;
+    return map->iterator ? map->iterator->key : NULL;
+}
+
+/**
+* mapIterBegin: Sets an external iterator to the first key of the map.
+* The iterator is at the end if depth is 0, and at nodes[0] otherwise.
+* @param map - The map to iterate over
+* @param iterator - The iterator to set
+* @return
+* 	MAP_NULL_ARGUMENT - if a NULL was sent as an argument
+* 	MAP_SUCCESS - Otherwise.
+*/
+MapResult mapIterBegin(Map map, MapIterator* iterator) {
+    if (!map || !iterator) {
+        if (iterator) {
+            iterator->depth = 0;
+        }
+        return MAP_NULL_ARGUMENT;
+    }
+    iterator->map = map;
+    iterator->nodes[0] = map->head;
+    iterator->depth = map->head ? 1 : 0;
+    return MAP_SUCCESS;
+}
+
+/**
+* mapIterNext: Advances an external iterator to the next key.
+* @param iterator - The iterator to advance
+*/
+void mapIterNext(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return;
+    }
+    Node next = ((Node)iterator->nodes[0])->next;
+    iterator->nodes[0] = next;
+    iterator->depth = next ? 1 : 0;
+}
+
+/**
+* mapIterKey: Returns the key an external iterator is at.
+* @param iterator - The iterator
+* @return
+* 	NULL if the iterator is at the end or a NULL was sent as an argument
+* 	The key otherwise
+*/
+MapKeyElement mapIterKey(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return NULL;
+    }
+    return ((Node)iterator->nodes[0])->key;
+}
+
+/**
+* mapIterData: Returns the data of the key an external iterator is at.
+* @param iterator - The iterator
+* @return
+* 	NULL if the iterator is at the end or a NULL was sent as an argument
+* 	The data otherwise
+*/
+MapDataElement mapIterData(MapIterator* iterator) {
+    if (!iterator || iterator->depth == 0) {
+        return NULL;
+    }
+    return ((Node)iterator->nodes[0])->data;
 }
 
 
@@ -374,16 +499,15 @@ MapKeyElement mapGetNext(Map map) {
 * 	MAP_SUCCESS - Otherwise.
 */
 MapResult mapClear(Map map) {
-//    if (!map) {
-//        return MAP_NULL_ARGUMENT;
-//    }
-//    if (mapGetSize(map) == 1) {
-//        destroyNode(map,mapGetFirst(map));
-//        return MAP_SUCCESS;
-//    } else {
-//        mapGetFirst(map);
-//        Node current = map->head;
-//        while (map)
-//    }
+    if (!map) {
+        return MAP_NULL_ARGUMENT;
+    }
+    while (map->head != NULL) {
+        Node node = map->head;
+        map->head = node->next;
+        nodeDestroy(map,node);
+    }
+    map->iterator = NULL;
+    map->map_size = 0;
     return MAP_SUCCESS;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define MAP_MTM_H_
 
 #include <stdbool.h>
+#include "../arena.h"
 /**
 * Generic Ordered Map Container
 *
@@ -19,6 +20,8 @@
 *
 * The following functions are available:
 *   mapCreate		- Creates a new empty map.
+*   mapCreateHashed - Creates a new empty map which finds keys by hash.
+*   mapCreateInArena - Creates a new empty map which allocates in an arena.
 *   mapDestroy	- Deletes an existing map and frees all resources.
 *   mapCopy	  	- Copies an existing map.
 *   mapGetSize  - Returns the size of a given map.
@@ -27,6 +30,8 @@
 *   mapPut      - Gives a specific key a given value.
 *   				      If the key exists, the value is overridden.
 *   				      This resets the internal iterator.
+*   mapPutOwned - Like mapPut, but the map takes ownership of the key and
+*                 data instead of copying them.
 *   mapGet      - Returns the data paired to a key which matches the given key.
 *					        Iterator status unchanged.
 *   mapRemove		- Removes a pair of (key,data) elements for which the key
@@ -39,6 +44,15 @@
 *	  mapClear	 	- Clears the contents of the map. Frees all the elements of
 *	 				        the map using the free function.
 *   MAP_FOREACH - A macro for iterating over the map's elements.
+*   mapIterBegin, mapIterNext, mapIterKey, mapIterData - External iterators,
+*                 which don't use the internal iterator.
+*
+* There are three implementations; the map is chosen by linking one of them:
+*   map_mtm.c   - A sorted linked list. O(n) puts, gets and removes.
+*   map_hash.c  - A hash table with a sorted view built on demand for the
+*                 iteration. O(1) expected puts, gets and removes when the map
+*                 is created with a hash function.
+*   map_btree.c - A B-tree. O(log n) puts, gets and removes.
 */
 
 /** Type for defining the map */
@@ -51,6 +65,25 @@ typedef enum MapResult_t {
     MAP_ITEM_DOES_NOT_EXIST
 } MapResult;
 
+/** The maximal depth of the external iterators of maps kept as trees */
+#define MAP_ITERATOR_DEPTH 16
+
+/**
+* An external iterator over a map, from the smallest key to the largest.
+* It is a plain struct, so it can be declared on the stack, and it is
+* independent of the internal iterator: a map may have any number of external
+* iterators, and they are not affected by mapGet, mapContains, mapGetFirst,
+* mapGetNext or by giving an existing key new data. Putting a new key,
+* removing a key, or clearing or destroying the map invalidates them.
+* The fields are private to the map implementation.
+*/
+typedef struct MapIterator_t {
+    Map map;
+    void* nodes[MAP_ITERATOR_DEPTH];
+    int positions[MAP_ITERATOR_DEPTH];
+    int depth;
+} MapIterator;
+
 /** Data element data type for map container */
 typedef void* MapDataElement;
 
@@ -79,6 +112,12 @@ typedef void(*freeMapKeyElements)(MapKeyElement);
 */
 typedef int(*compareMapKeyElements)(MapKeyElement, MapKeyElement);
 
+/**
+* Type of function used by a hashed map to find key elements. Key elements
+* which are equal by the compare function must have equal hashes.
+*/
+typedef unsigned int(*hashMapKeyElements)(MapKeyElement);
+
 
 void mapPrint(Map map);
 /**
@@ -104,6 +143,51 @@ Map mapCreate(copyMapKeyElements copyKeyElement,
               freeMapDataElements freeDataElement,
               compareMapKeyElements compareKeyElements);
 
+/**
+* mapCreateHashed: Allocates a new empty map which finds key elements by their
+* hash instead of by comparing them, so mapContains, mapGet, mapPut and
+* mapRemove take constant expected time. The compare function is still used
+* for equality and for the order of iteration; the keys are sorted on demand
+* by the first mapGetFirst after the map changes.
+*
+* @param copyDataElement, copyKeyElement, freeDataElement, freeKeyElement,
+* 		compareKeyElements - As in mapCreate.
+* @param hashKeyElement - Function pointer to be used for hashing key elements.
+* 		If NULL, key elements are found by binary search with the compare
+* 		function.
+* @return
+* 	NULL - if one of the other parameters is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateHashed(copyMapKeyElements copyKeyElement,
+                    copyMapDataElements copyDataElement,
+                    freeMapKeyElements freeKeyElement,
+                    freeMapDataElements freeDataElement,
+                    compareMapKeyElements compareKeyElements,
+                    hashMapKeyElements hashKeyElement);
+
+/**
+* mapCreateInArena: Allocates a new empty map as mapCreateHashed does, whose
+* own memory (the map, and the nodes of the list and B-tree maps) is allocated
+* in an arena. The key and data elements are still allocated and freed by the
+* given functions. mapCopy allocates the copy in the same arena, and
+* mapDestroy returns the memory of the map to the arena, which must outlive
+* the map.
+*
+* @param copyDataElement, copyKeyElement, freeDataElement, freeKeyElement,
+* 		compareKeyElements, hashKeyElement - As in mapCreateHashed.
+* @param arena - The arena, or NULL to allocate on the heap.
+* @return
+* 	NULL - if one of the element functions is NULL or allocations failed.
+* 	A new Map in case of success.
+*/
+Map mapCreateInArena(copyMapKeyElements copyKeyElement,
+                     copyMapDataElements copyDataElement,
+                     freeMapKeyElements freeKeyElement,
+                     freeMapDataElements freeDataElement,
+                     compareMapKeyElements compareKeyElements,
+                     hashMapKeyElements hashKeyElement, Arena arena);
+
 /**
 * mapDestroy: Deallocates an existing map. Clears all elements by using the
 * stored free functions.
@@ -165,6 +249,27 @@ bool mapContains(Map map, MapKeyElement element);
 */
 MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement);
 
+/**
+*	mapPutOwned: Gives a specified key a specific value, without copying them:
+*  the map takes ownership of the given key and data elements, and frees them
+*  with the free functions given at initialization. If the key already exists,
+*  the given data replaces the old data and the given key is freed at once.
+*  On failure, nothing is freed, and the caller keeps the elements.
+*  Iterator's value is undefined after this operation.
+*
+* @param map - The map for which to reassign the data element
+* @param keyElement - The key element which need to be reassigned. Must be
+*      freeable by the free function given at initialization.
+* @param dataElement - The new data element to associate with the given key.
+*      Must be freeable by the free function given at initialization.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL was sent as map, key, or data
+* 	MAP_OUT_OF_MEMORY if an allocation failed
+* 	MAP_SUCCESS the paired elements had been inserted successfully
+*/
+MapResult mapPutOwned(Map map, MapKeyElement keyElement,
+                      MapDataElement dataElement);
+
 /**
 *	mapGet: Returns the data associated with a specific key in the map.
 *			Iterator status unchanged
@@ -174,7 +279,9 @@ MapResult mapPut(Map map, MapKeyElement keyElement, MapDataElement dataElement);
 we want to get.
 * @return
 *  NULL if a NULL pointer was sent or if the map does not contain the requested key.
-* 	The data element associated with the key otherwise.
+* 	The data element associated with the key otherwise. It is borrowed: it is
+* 	owned by the map, and valid until the key is removed or given new data, or
+* 	the map is cleared or destroyed.
 */
 MapDataElement mapGet(Map map, MapKeyElement keyElement);
 
@@ -223,6 +330,44 @@ MapKeyElement mapGetFirst(Map map);
 MapKeyElement mapGetNext(Map map);
 
 
+/**
+*	mapIterBegin: Sets an external iterator to the first key element of a map.
+*	A map which keeps its order on demand (see mapCreateHashed) may update it
+*	here, so iterations which run concurrently must not begin while the map
+*	is changed since its last iteration.
+*
+* @param map - The map to iterate over.
+* @param iterator - The iterator to set.
+* @return
+* 	MAP_NULL_ARGUMENT if a NULL pointer was sent.
+* 	MAP_OUT_OF_MEMORY if an allocation failed. The iterator is then at the end.
+* 	MAP_SUCCESS otherwise. The iterator is at the end if the map is empty.
+*/
+MapResult mapIterBegin(Map map, MapIterator* iterator);
+
+/**
+*	mapIterNext: Advances an external iterator to the next key element.
+*	Does nothing if the iterator is at the end or NULL.
+*/
+void mapIterNext(MapIterator* iterator);
+
+/**
+*	mapIterKey: Returns the key element an external iterator is at.
+* @return
+* 	NULL if the iterator is at the end or NULL.
+* 	The current key element otherwise.
+*/
+MapKeyElement mapIterKey(MapIterator* iterator);
+
+/**
+*	mapIterData: Returns the data element paired to the key element an external
+*	iterator is at, without looking it up.
+* @return
+* 	NULL if the iterator is at the end or NULL.
+* 	The current data element otherwise (borrowed, as from mapGet).
+*/
+MapDataElement mapIterData(MapIterator* iterator);
+
 /**
 * mapClear: Removes all key and data elements from target map.
 * The elements are deallocated using the stored free functions.
@@ -243,4 +388,13 @@ MapResult mapClear(Map map);
 		iterator ;\
 		iterator = mapGetNext(map))
 
+/*!
+* Macro for iterating over a map with an external iterator, declared by the
+* caller. mapIterKey and mapIterData give the current elements.
+*/
+#define MAP_ITER_FOREACH(iterator,map) \
+	for(mapIterBegin(map, &(iterator)) ; \
+		mapIterKey(&(iterator)) ; \
+		mapIterNext(&(iterator)))
+
 #endif /* MAP_MTM_H_ */
@@ -56,55 +56,55 @@ void PokemonGoResultToMtmErrorCode(PokemonGoResult result) {
 
 // ------------------------ Trainer Functions ----------------------------------
 
-void executeTrainerAdd(FILE *output_channel, char *string, PokemonGo pokemonGo,
+void executeTrainerAdd(FILE *output_channel, char **line, PokemonGo pokemonGo,
                        PokemonGoResult *error_code) {
-    char *name = strtok(NULL, DELIMITER);
-    int budget = atoi(strtok(NULL, DELIMITER));
-    char *start_point = strtok(NULL, DELIMITER);
+    char *name = readerNextToken(line);
+    int budget = readerParseInt(readerNextToken(line));
+    char *start_point = readerNextToken(line);
     *error_code = pokemonGoAddTrainer(pokemonGo, output_channel, name, budget,
                                       start_point);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 /*----------------------------------------------------------------------------*/
-void executeTrainerGoToLocation(FILE *output_channel, char *string,
+void executeTrainerGoToLocation(FILE *output_channel, char **line,
                                 PokemonGo pokemonGo,
                                 PokemonGoResult *error_code) {
-    char *name = strtok(NULL, DELIMITER);
-    char *location = strtok(NULL, DELIMITER);
+    char *name = readerNextToken(line);
+    char *location = readerNextToken(line);
     *error_code = pokemonGoTrainerMoveHunt(pokemonGo, output_channel, name,
                                            location);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 /*----------------------------------------------------------------------------*/
-void executeTrainerPurchase(char *string, PokemonGo pokemonGo,
+void executeTrainerPurchase(char **line, PokemonGo pokemonGo,
                             PokemonGoResult *error_code) {
-    char *name = strtok(NULL, DELIMITER);
-    char *item = strtok(NULL, DELIMITER);
-    int value = atoi(strtok(NULL, DELIMITER));
+    char *name = readerNextToken(line);
+    char *item = readerNextToken(line);
+    int value = readerParseInt(readerNextToken(line));
     *error_code = pokemonGoTrainerPurchase(pokemonGo, name, item, value);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 
 // ------------------------ Store Functions ------------------------------------
 
-void executeStoreAdd(char *string, PokemonGo pokemonGo,
+void executeStoreAdd(char **line, PokemonGo pokemonGo,
                      PokemonGoResult *error_code) {
-    char *item = strtok(NULL, DELIMITER);
-    int value = atoi(strtok(NULL, DELIMITER));
-    int quantity = atoi(strtok(NULL, DELIMITER));
+    char *item = readerNextToken(line);
+    int value = readerParseInt(readerNextToken(line));
+    int quantity = readerParseInt(readerNextToken(line));
     *error_code = pokemonGoAddItemsToStore(pokemonGo, item, value, quantity);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 
 // ------------------------ Battle Functions -----------------------------------
 
-void executePokemonGoTrainerBattle(FILE *output_channel, char *string,
+void executePokemonGoTrainerBattle(FILE *output_channel, char **line,
                                    PokemonGo pokemonGo,
                                    PokemonGoResult *error_code) {
-    char *trainer1 = strtok(NULL, DELIMITER);
-    char *trainer2 = strtok(NULL, DELIMITER);
-    int pokemon_id1 = atoi(strtok(NULL, DELIMITER));
-    int pokemon_id2 = atoi(strtok(NULL, DELIMITER));
+    char *trainer1 = readerNextToken(line);
+    char *trainer2 = readerNextToken(line);
+    int pokemon_id1 = readerParseInt(readerNextToken(line));
+    int pokemon_id2 = readerParseInt(readerNextToken(line));
     *error_code = pokemonGoTrainerBattle(pokemonGo, output_channel, trainer1,
                                          pokemon_id1, trainer2, pokemon_id2);
     PokemonGoResultToMtmErrorCode(*error_code);
@@ -112,177 +112,103 @@ void executePokemonGoTrainerBattle(FILE *output_channel, char *string,
 
 // ------------------------ Pokemon Functions ----------------------------------
 
-void executePokemonGoTrainerHealPokemon(char *string, PokemonGo pokemonGo,
+void executePokemonGoTrainerHealPokemon(char **line, PokemonGo pokemonGo,
                                         PokemonGoResult *error_code) {
-    char *trainer = strtok(NULL, DELIMITER);
-    int pokemon_id = atoi(strtok(NULL, DELIMITER));
+    char *trainer = readerNextToken(line);
+    int pokemon_id = readerParseInt(readerNextToken(line));
     *error_code = pokemonGoTrainerHealPokemon(pokemonGo, trainer, pokemon_id);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 /*----------------------------------------------------------------------------*/
-void executePokemonGoTrainerTrainPokemon(char *string, PokemonGo pokemonGo,
+void executePokemonGoTrainerTrainPokemon(char **line, PokemonGo pokemonGo,
                                          PokemonGoResult *error_code) {
-    char *trainer = strtok(NULL, DELIMITER);
-    int pokemon_id = atoi(strtok(NULL, DELIMITER));
+    char *trainer = readerNextToken(line);
+    int pokemon_id = readerParseInt(readerNextToken(line));
     *error_code = pokemonGoTrainerTrainPokemon(pokemonGo, trainer, pokemon_id);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 
 // ------------------------ Report Functions -----------------------------------
 
-void executePokemonGoReportTrainer(FILE *output_channel, char *string,
+void executePokemonGoReportTrainer(FILE *output_channel, char **line,
                                    PokemonGo pokemonGo,
                                    PokemonGoResult *error_code) {
-    char *trainer = strtok(NULL, DELIMITER);
+    char *trainer = readerNextToken(line);
     *error_code = pokemonGoReportTrainer(pokemonGo, trainer, output_channel);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 /*----------------------------------------------------------------------------*/
-void executePokemonGoReportLocations(FILE *output_channel, char *string,
+void executePokemonGoReportLocations(FILE *output_channel, char **line,
                                      PokemonGo pokemonGo,
                                      PokemonGoResult *error_code) {
     *error_code = pokemonGoReportLocations(pokemonGo, output_channel);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 /*----------------------------------------------------------------------------*/
-void executePokemonGoReportStock(FILE *output_channel, char *string,
+void executePokemonGoReportStock(FILE *output_channel, char **line,
                                  PokemonGo pokemonGo,
                                  PokemonGoResult *error_code) {
     *error_code = pokemonGoReportStock(pokemonGo, output_channel);
     PokemonGoResultToMtmErrorCode(*error_code);
 }
 
-// Trainer commands ------------------------------------------------------------
-void handleTrainerCommand(FILE *output, char *second_word, char *current_line,
-                          PokemonGo pokemonGo, PokemonGoResult *error_code) {
-    if (strcmp(second_word, "add") == 0) {
-        executeTrainerAdd(output, current_line, pokemonGo, error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else if (strcmp(second_word, "go") == 0) {
-        executeTrainerGoToLocation(output, current_line, pokemonGo, error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else if (strcmp(second_word, "purchase") == 0) {
-        executeTrainerPurchase(current_line, pokemonGo, error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else {
-        *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
-        mtmPrintErrorMessage(stderr, MTM_INVALID_COMMAND_LINE_PARAMETERS);
-    }
-}
-
-// Store commands --------------------------------------------------------------
-void
-handleStoreCommand(char *second_word, char *current_line, PokemonGo pokemonGo,
-                   PokemonGoResult *error_code) {
-    if (strcmp(second_word, "add") == 0) {
-        executeStoreAdd(current_line, pokemonGo, error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else {
-        *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
-        mtmPrintErrorMessage(stderr, MTM_INVALID_COMMAND_LINE_PARAMETERS);
-    }
-}
-
-// Battle commands -------------------------------------------------------------
-void handleBattleCommand(FILE *output, char *second_word, char *current_line,
-                         PokemonGo pokemonGo, PokemonGoResult *error_code) {
-    if (strcmp(second_word, "fight") == 0) {
-        executePokemonGoTrainerBattle(output, current_line, pokemonGo,
-                                      error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else {
-        *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
-        mtmPrintErrorMessage(stderr, MTM_INVALID_COMMAND_LINE_PARAMETERS);
-    }
-}
-
-// Pokemon commands ------------------------------------------------------------
-void
-handlePokemonCommand(char *second_word, char *current_line, PokemonGo pokemonGo,
-                     PokemonGoResult *error_code) {
-    if (strcmp(second_word, "train") == 0) {
-        executePokemonGoTrainerTrainPokemon(current_line, pokemonGo,
-                                            error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else if (strcmp(second_word, "heal") == 0) {
-        executePokemonGoTrainerHealPokemon(current_line, pokemonGo, error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else {
-        *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
-        mtmPrintErrorMessage(stderr, MTM_INVALID_COMMAND_LINE_PARAMETERS);
-    }
-}
-
-
-// Report commands -------------------------------------------------------------
-void handleReportCommand(FILE *output, char *second_word, char *current_line,
-                         PokemonGo pokemonGo, PokemonGoResult *error_code) {
-    if (strcmp(second_word, "locations") == 0) {
-        executePokemonGoReportLocations(output, current_line, pokemonGo,
-                                        error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else if (strcmp(second_word, "stock") == 0) {
-        executePokemonGoReportStock(output, current_line, pokemonGo,
-                                    error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) return;
-    } else if (strcmp(second_word, "trainer") == 0) {
-        executePokemonGoReportTrainer(output, current_line, pokemonGo,
-                                      error_code);
-    } else {
-        *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
-        mtmPrintErrorMessage(stderr, MTM_INVALID_COMMAND_LINE_PARAMETERS);
-    }
-}
-
 // ------------------------ Command Analysis Functions -------------------------
 
 void analyzeCurrentCommand(FILE *output, char *first_word, char *second_word,
-                           char *current_line, PokemonGo pokemonGo,
+                           char **line, PokemonGo pokemonGo,
                            PokemonGoResult *error_code) {
-    if (strcmp(first_word, "trainer") == 0) {
-        handleTrainerCommand(output, second_word, current_line, pokemonGo,
-                             error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) {
-            return;
-        }
-    } else if (strcmp(first_word, "store") == 0) {
-        handleStoreCommand(second_word, current_line, pokemonGo,
-                           error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) {
-            return;
-        }
-    } else if (strcmp(first_word, "battle") == 0) {
-        handleBattleCommand(output, second_word, current_line, pokemonGo,
-                            error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) {
-            return;
-        }
-    } else if (strcmp(first_word, "pokemon") == 0) {
-        handlePokemonCommand(second_word, current_line, pokemonGo,
-                             error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) {
-            return;
-        }
-    } else if (strcmp(first_word, "report") == 0) {
-        handleReportCommand(output, second_word, current_line, pokemonGo,
-                            error_code);
-        if (*error_code == POKEMON_GO_OUT_OF_MEM) {
-            return;
-        }
-    } else {
-        *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
+    switch (keywordGetCommand(first_word, second_word)) {
+        case COMMAND_TRAINER_ADD:
+            executeTrainerAdd(output, line, pokemonGo, error_code);
+            break;
+        case COMMAND_TRAINER_GO:
+            executeTrainerGoToLocation(output, line, pokemonGo, error_code);
+            break;
+        case COMMAND_TRAINER_PURCHASE:
+            executeTrainerPurchase(line, pokemonGo, error_code);
+            break;
+        case COMMAND_STORE_ADD:
+            executeStoreAdd(line, pokemonGo, error_code);
+            break;
+        case COMMAND_BATTLE_FIGHT:
+            executePokemonGoTrainerBattle(output, line, pokemonGo, error_code);
+            break;
+        case COMMAND_POKEMON_TRAIN:
+            executePokemonGoTrainerTrainPokemon(line, pokemonGo, error_code);
+            break;
+        case COMMAND_POKEMON_HEAL:
+            executePokemonGoTrainerHealPokemon(line, pokemonGo, error_code);
+            break;
+        case COMMAND_REPORT_TRAINER:
+            executePokemonGoReportTrainer(output, line, pokemonGo, error_code);
+            break;
+        case COMMAND_REPORT_LOCATIONS:
+            executePokemonGoReportLocations(output, line, pokemonGo,
+                                            error_code);
+            break;
+        case COMMAND_REPORT_STOCK:
+            executePokemonGoReportStock(output, line, pokemonGo, error_code);
+            break;
+        case COMMAND_UNKNOWN_VERB:
+            *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
+            mtmPrintErrorMessage(stderr, MTM_INVALID_COMMAND_LINE_PARAMETERS);
+            break;
+        case COMMAND_UNKNOWN:
+            *error_code = POKEMON_GO_INVALID_COMMAND_LINE_PARAMETERS;
+            break;
     }
 }
 /*----------------------------------------------------------------------------*/
 void handleCurrentCommand(FILE *output, char *current_command,
                           PokemonGo pokemonGo, MtmErrorCode *main_error_code) {
     PokemonGoResult error_code = POKEMON_GO_SUCCESS;
+    char *line = current_command;
     char *first_word = NULL;
     char *second_word = NULL;
-    first_word = strtok(current_command, DELIMITER);
+    first_word = readerNextToken(&line);
     if (first_word == NULL) return;
-    second_word = strtok(NULL, DELIMITER);
-    analyzeCurrentCommand(output, first_word, second_word, current_command,
+    second_word = readerNextToken(&line);
+    analyzeCurrentCommand(output, first_word, second_word, &line,
                           pokemonGo, &error_code);
     if (error_code == POKEMON_GO_OUT_OF_MEM) {
         *main_error_code = MTM_OUT_OF_MEMORY;
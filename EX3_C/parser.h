@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include "print_utils.h"
 #include "PokemonGo.h"
+#include "reader.h"
+#include "keyword.h"
 
 #define DELIMITER " \r\t\n"
 #define READ_ONLY "r"
@@ -19,6 +21,7 @@
 #define MIN_EXECUTE_COMMAND_LENGTH 7
 #define MAX_EXECUTE_COMMAND_LENGTH 11
 #define MAX_INPUT_LEN 250
+#define OUTPUT_BUFFER_SIZE (1 << 20)
 
 /**
  * Returns a relevant Mtm error code according to PokemonGo program errors
@@ -30,14 +33,14 @@ void PokemonGoResultToMtmErrorCode(PokemonGoResult result);
 /**
  * Calling function for "trainer add" command
 */
-void executeTrainerAdd(FILE *output_channel, char *string, PokemonGo pokemonGo,
+void executeTrainerAdd(FILE *output_channel, char **line, PokemonGo pokemonGo,
                        PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
  * Calling function for "trainer go" command
 */
-void executeTrainerGoToLocation(FILE *output_channel, char *string,
+void executeTrainerGoToLocation(FILE *output_channel, char **line,
                                 PokemonGo pokemonGo,
                                 PokemonGoResult *error_code);
 
@@ -45,21 +48,21 @@ void executeTrainerGoToLocation(FILE *output_channel, char *string,
 /**
  * Calling function for "trainer purchase" command
 */
-void executeTrainerPurchase(char *string, PokemonGo pokemonGo,
+void executeTrainerPurchase(char **line, PokemonGo pokemonGo,
                             PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
  * Calling function for "store add" command
 */
-void executeStoreAdd(char *string, PokemonGo pokemonGo,
+void executeStoreAdd(char **line, PokemonGo pokemonGo,
                      PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
  * Calling function for "battle fight" command
 */
-void executePokemonGoTrainerBattle(FILE *output_channel, char *string,
+void executePokemonGoTrainerBattle(FILE *output_channel, char **line,
                                    PokemonGo pokemonGo,
                                    PokemonGoResult *error_code);
 
@@ -67,21 +70,21 @@ void executePokemonGoTrainerBattle(FILE *output_channel, char *string,
 /**
  * Calling function for "pokemon heal" command
 */
-void executePokemonGoTrainerHealPokemon(char *string, PokemonGo pokemonGo,
+void executePokemonGoTrainerHealPokemon(char **line, PokemonGo pokemonGo,
                                         PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
  * Calling function for "pokemon train" command
 */
-void executePokemonGoTrainerTrainPokemon(char *string, PokemonGo pokemonGo,
+void executePokemonGoTrainerTrainPokemon(char **line, PokemonGo pokemonGo,
                                          PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
  * Calling function for "report $trainer" command
 */
-void executePokemonGoReportTrainer(FILE *output_channel, char *string,
+void executePokemonGoReportTrainer(FILE *output_channel, char **line,
                                    PokemonGo pokemonGo,
                                    PokemonGoResult *error_code);
 
@@ -89,7 +92,7 @@ void executePokemonGoReportTrainer(FILE *output_channel, char *string,
 /**
  * Calling function for "report $location" command
 */
-void executePokemonGoReportLocations(FILE *output_channel, char *string,
+void executePokemonGoReportLocations(FILE *output_channel, char **line,
                                      PokemonGo pokemonGo,
                                      PokemonGoResult *error_code);
 
@@ -97,60 +100,26 @@ void executePokemonGoReportLocations(FILE *output_channel, char *string,
 /**
  * Calling function for "report stock" command
 */
-void executePokemonGoReportStock(FILE *output_channel, char *string,
+void executePokemonGoReportStock(FILE *output_channel, char **line,
                                  PokemonGo pokemonGo,
                                  PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
- * Calling function for "Trainer add" command
-*/
-void handleTrainerCommand(FILE *output, char *second_word, char *current_line,
-                          PokemonGo pokemonGo, PokemonGoResult *error_code);
-
-/*----------------------------------------------------------------------------*/
-/**
- * Calling function for "store" command
-*/
-void
-handleStoreCommand(char *second_word, char *current_line, PokemonGo pokemonGo,
-                   PokemonGoResult *error_code);
-
-/*----------------------------------------------------------------------------*/
-/**
- * "battle fight" parsing function
-*/
-void handleBattleCommand(FILE *output, char *second_word, char *current_line,
-                         PokemonGo pokemonGo, PokemonGoResult *error_code);
-
-/*----------------------------------------------------------------------------*/
-/**
- * "pokemon" parsing function
-*/
-void
-handlePokemonCommand(char *second_word, char *current_line, PokemonGo pokemonGo,
-                     PokemonGoResult *error_code);
-
-/*----------------------------------------------------------------------------*/
-/**
- * "report" parsing function
-*/
-void handleReportCommand(FILE *output, char *second_word, char *current_line,
-                         PokemonGo pokemonGo, PokemonGoResult *error_code);
-
-/*----------------------------------------------------------------------------*/
-/**
- * Analyze a given command by comparing it to each of the known commands in the
- * PokemonGo system and call to the suitable function for that command
+ * Analyze a given command by looking up its first two words among the known
+ * commands in the PokemonGo system (see keywordGetCommand) and call to the
+ * suitable function for that command
 */
 void analyzeCurrentCommand(FILE *output, char *first_word, char *second_word,
-                           char *current_line, PokemonGo pokemonGo,
+                           char **line, PokemonGo pokemonGo,
                            PokemonGoResult *error_code);
 
 /*----------------------------------------------------------------------------*/
 /**
  * Split a given command given from a file / standard intput into tokens and
- * call the suitable function for that command
+ * call the suitable function for that command. The command is split in place,
+ * and the functions it calls take the rest of it, from which they split their
+ * arguments with readerNextToken.
 */
 void
 handleCurrentCommand(FILE *output, char *current_command, PokemonGo pokemonGo,
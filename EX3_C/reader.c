@@ -0,0 +1,161 @@
+#include "reader.h"
+#include <stdlib.h>
+#include <string.h>
+
+//-------------------------- Defines & Declarations ----------------------------
+
+struct reader_t {
+    FILE *input;
+    bool interactive;
+    // The unread part of the buffer is [start, end), and buffer[end] is
+    // kept free for the terminator of a last line without a newline.
+    char *buffer;
+    size_t start;
+    size_t end;
+    bool eof;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Returns whether a character is one of READER_DELIMITERS.
+*/
+static inline bool isDelimiter(char c) {
+    return c == ' ' || c == '\r' || c == '\t' || c == '\n';
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Moves the unread bytes to the beginning of the buffer, and fills the rest
+* of it from the input.
+*/
+static void readerFill(Reader reader) {
+    size_t unread = reader->end - reader->start;
+    memmove(reader->buffer, reader->buffer + reader->start, unread);
+    reader->start = 0;
+    reader->end = unread;
+    size_t read = fread(reader->buffer + unread, 1,
+                        READER_BUFFER_SIZE - unread, reader->input);
+    reader->end += read;
+    if (read < READER_BUFFER_SIZE - unread) {
+        reader->eof = true;
+    }
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Terminates the line which starts at start and ends at index, and moves
+* start past it.
+*/
+static char *readerTakeLine(Reader reader, size_t index) {
+    char *line = reader->buffer + reader->start;
+    reader->buffer[index] = '\0';
+    reader->start = index < reader->end ? index + 1 : index;
+    return line;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the next line in interactive mode, read with fgets.
+*/
+static char *readerNextInteractiveLine(Reader reader) {
+    if (!fgets(reader->buffer, READER_BUFFER_SIZE + 1, reader->input)) {
+        return NULL;
+    }
+    size_t length = strlen(reader->buffer);
+    if (length > 0 && reader->buffer[length - 1] == '\n') {
+        reader->buffer[length - 1] = '\0';
+    }
+    return reader->buffer;
+}
+
+//-------------------------- Main Functions ------------------------------------
+
+Reader readerCreate(FILE *input, bool interactive) {
+    if (!input) {
+        return NULL;
+    }
+    Reader reader = malloc(sizeof(*reader));
+    if (!reader) {
+        return NULL;
+    }
+    reader->buffer = malloc(READER_BUFFER_SIZE + 1);
+    if (!reader->buffer) {
+        free(reader);
+        return NULL;
+    }
+    reader->input = input;
+    reader->interactive = interactive;
+    reader->start = 0;
+    reader->end = 0;
+    reader->eof = false;
+    return reader;
+}
+/*----------------------------------------------------------------------------*/
+void readerDestroy(Reader reader) {
+    if (!reader) {
+        return;
+    }
+    free(reader->buffer);
+    free(reader);
+}
+/*----------------------------------------------------------------------------*/
+char *readerNextLine(Reader reader) {
+    if (!reader) {
+        return NULL;
+    }
+    if (reader->interactive) {
+        return readerNextInteractiveLine(reader);
+    }
+    char *newline = memchr(reader->buffer + reader->start, '\n',
+                           reader->end - reader->start);
+    if (!newline && !reader->eof) {
+        readerFill(reader);
+        newline = memchr(reader->buffer + reader->start, '\n',
+                         reader->end - reader->start);
+    }
+    if (newline) {
+        return readerTakeLine(reader, (size_t) (newline - reader->buffer));
+    }
+    if (reader->start == reader->end) {
+        return NULL;
+    }
+    // A last line without a newline, or a piece of a line longer than the
+    // buffer.
+    return readerTakeLine(reader, reader->end);
+}
+/*----------------------------------------------------------------------------*/
+char *readerNextToken(char **line) {
+    if (!line || !*line) {
+        return NULL;
+    }
+    char *token = *line;
+    while (isDelimiter(*token)) {
+        token++;
+    }
+    if (*token == '\0') {
+        *line = token;
+        return NULL;
+    }
+    char *token_end = token + 1;
+    while (*token_end != '\0' && !isDelimiter(*token_end)) {
+        token_end++;
+    }
+    if (*token_end != '\0') {
+        *token_end++ = '\0';
+    }
+    *line = token_end;
+    return token;
+}
+/*----------------------------------------------------------------------------*/
+int readerParseInt(char *token) {
+    if (!token) {
+        return 0;
+    }
+    bool negative = *token == '-';
+    if (*token == '-' || *token == '+') {
+        token++;
+    }
+    unsigned int value = 0;
+    for (; *token >= '0' && *token <= '9'; ++token) {
+        value = 10 * value + (unsigned int) (*token - '0');
+    }
+    return (int) (negative ? 0U - value : value);
+}
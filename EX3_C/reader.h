@@ -0,0 +1,80 @@
+#ifndef READER_H_
+#define READER_H_
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/**
+* Command Reader
+*
+* Reads the commands of an input stream a line at a time, into a buffer of
+* its own. In block mode the stream is read READER_BUFFER_SIZE bytes at a
+* time, so a long command log takes few reads. In interactive mode it is
+* read a line at a time, so a command runs as soon as it is typed.
+*
+* A line is returned in place in the buffer, without its newline, and is
+* valid until the next line is read. It may be split into tokens in place
+* with readerNextToken. A line longer than the buffer is returned in
+* pieces, as fgets returns it.
+*/
+
+typedef struct reader_t *Reader;
+
+#define READER_BUFFER_SIZE (1 << 20)
+#define READER_DELIMITERS " \r\t\n"
+
+/*----------------------------------------------------------------------------*/
+/**
+* Creates a reader of an input stream. The stream is not closed with the
+* reader.
+*
+* @param input - the stream to read
+* @param interactive - whether to read a line at a time
+* @return
+* NULL if a NULL was sent or a memory allocation failed.
+* new allocated reader otherwise
+*/
+Reader readerCreate(FILE *input, bool interactive);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Frees all memory allocated to reader
+*
+* @param reader
+*/
+void readerDestroy(Reader reader);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Returns the next line of the input.
+*
+* @param reader
+* @return
+* NULL if a NULL was sent, or at the end of the input or on a read error.
+* the line otherwise
+*/
+char *readerNextLine(Reader reader);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Splits the next token of a line in place, as strtok does, but keeps its
+* position in the line instead of a global state.
+*
+* @param line - a pointer to the rest of the line, advanced past the token
+* @return
+* NULL if no token is left.
+* the token otherwise
+*/
+char *readerNextToken(char **line);
+
+/*----------------------------------------------------------------------------*/
+/**
+* Converts a token to an integer as atoi does: an optional sign and the
+* digits which follow it. Returns 0 if token is NULL.
+*
+* @param token
+*/
+int readerParseInt(char *token);
+
+/*----------------------------------------------------------------------------*/
+#endif /* READER_H_ */
@@ -54,7 +54,8 @@ static bool testPokemonGoAddTrainer() {
     Pokemon pikachu = pokemonCreate("Pikachu", "Raichu", 3, 1, types,
                                     &pokemon_error);
     ASSERT_TEST(pokemonGoAddLocation(pokemonGo, "bern") == POKEMON_GO_SUCCESS);
-    Location bern = mapGet(pokemonGoGetLocations(pokemonGo), "bern");
+    Location bern = mapGet(pokemonGoGetLocations(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "bern"));
     ASSERT_TEST(locationAddPokemon(bern, pikachu) == LOCATION_SUCCESS);
     ASSERT_TEST(error == POKEMON_GO_SUCCESS);
     ASSERT_TEST(pokemonGoAddTrainer(pokemonGo, stderr, NULL, 50, "paris") ==
@@ -91,9 +92,11 @@ static bool testPokemonGoTrainerMoveHunt() {
     Pokemon pikachu = pokemonCreate("Pikachu", "Raichu", 3, 1, types,
                                     &pokemon_error);
     ASSERT_TEST(pokemonGoAddLocation(pokemonGo, "bern") == POKEMON_GO_SUCCESS);
-    Location bern = mapGet(pokemonGoGetLocations(pokemonGo), "bern");
+    Location bern = mapGet(pokemonGoGetLocations(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "bern"));
     ASSERT_TEST(pokemonGoAddLocation(pokemonGo, "eilat") == POKEMON_GO_SUCCESS);
-    Location eilat = mapGet(pokemonGoGetLocations(pokemonGo), "eilat");
+    Location eilat = mapGet(pokemonGoGetLocations(pokemonGo),
+                            pokemonGoFindName(pokemonGo, "eilat"));
     ASSERT_TEST(locationAddPokemon(bern, pikachu) == LOCATION_SUCCESS);
     ASSERT_TEST(locationAddPokemon(eilat, pikachu) == LOCATION_SUCCESS);
     ASSERT_TEST(error == POKEMON_GO_SUCCESS);
@@ -163,7 +166,8 @@ static bool testPokemonGoTrainerBattle() {
                                     &pokemon_error);
     listDestroy(types1);
     ASSERT_TEST(pokemonGoAddLocation(pokemonGo, "eilat") == POKEMON_GO_SUCCESS);
-    Location eilat = mapGet(pokemonGoGetLocations(pokemonGo), "eilat");
+    Location eilat = mapGet(pokemonGoGetLocations(pokemonGo),
+                            pokemonGoFindName(pokemonGo, "eilat"));
     ASSERT_TEST(locationAddPokemon(eilat, pikachu) == LOCATION_SUCCESS);
 
     // Second Pokemon
@@ -175,7 +179,8 @@ static bool testPokemonGoTrainerBattle() {
     listDestroy(types2);
     ASSERT_TEST(
             pokemonGoAddLocation(pokemonGo, "metula") == POKEMON_GO_SUCCESS);
-    Location metula = mapGet(pokemonGoGetLocations(pokemonGo), "metula");
+    Location metula = mapGet(pokemonGoGetLocations(pokemonGo),
+                             pokemonGoFindName(pokemonGo, "metula"));
     ASSERT_TEST(locationAddPokemon(metula, pikachu) == LOCATION_SUCCESS);
 
 
@@ -222,7 +227,8 @@ static bool testPokemonGoTrainerHealPokemon() {
     Pokemon pikachu = pokemonCreate("Pikachu", "Raichu", 3, 1, types1,
                                     &pokemon_error);
     listDestroy(types1);
-    Location bern = mapGet(pokemonGoGetLocations(pokemonGo), "bern");
+    Location bern = mapGet(pokemonGoGetLocations(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "bern"));
     ASSERT_TEST(locationAddPokemon(bern, pikachu) == LOCATION_SUCCESS);
     ASSERT_TEST(pokemonGoAddTrainer(pokemonGo, stderr, "Linda", 100, "bern") ==
                 POKEMON_GO_SUCCESS);
@@ -230,7 +236,8 @@ static bool testPokemonGoTrainerHealPokemon() {
                 POKEMON_GO_SUCCESS);
     ASSERT_TEST(pokemonGoTrainerPurchase(pokemonGo, "Linda", "potion", 62) ==
                 POKEMON_GO_SUCCESS);
-    Trainer linda = mapGet(pokemonGoGetTrainers(pokemonGo), "Linda");
+    Trainer linda = mapGet(pokemonGoGetTrainers(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "Linda"));
     Pokemon pokemon1 = trainerGetPokemonByID(linda, 1);
     pokemonSetHp(pokemon1, 10);
     ASSERT_TEST(pokemonGoTrainerHealPokemon(pokemonGo, "Linda", 1) ==
@@ -262,7 +269,8 @@ static bool testPokemonGoTrainerTrainPokemon() {
     Pokemon pikachu = pokemonCreate("Pikachu", "Raichu", 3, 1, types1,
                                     &pokemon_error);
     listDestroy(types1);
-    Location bern = mapGet(pokemonGoGetLocations(pokemonGo), "bern");
+    Location bern = mapGet(pokemonGoGetLocations(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "bern"));
     ASSERT_TEST(locationAddPokemon(bern, pikachu) == LOCATION_SUCCESS);
     ASSERT_TEST(pokemonGoAddTrainer(pokemonGo, stderr, "Linda", 1000, "bern") ==
                 POKEMON_GO_SUCCESS);
@@ -274,7 +282,8 @@ static bool testPokemonGoTrainerTrainPokemon() {
                 POKEMON_GO_SUCCESS);
     ASSERT_TEST(pokemonGoTrainerPurchase(pokemonGo, "Linda", "candy", 150) ==
                 POKEMON_GO_SUCCESS);
-    Trainer linda = mapGet(pokemonGoGetTrainers(pokemonGo), "Linda");
+    Trainer linda = mapGet(pokemonGoGetTrainers(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "Linda"));
     Pokemon pokemon1 = trainerGetPokemonByID(linda, 1);
     ASSERT_TEST(pokemonGetCp(pokemon1) == 1);
     ASSERT_TEST(pokemonGoTrainerTrainPokemon(pokemonGo, "Linda", 1) ==
@@ -307,7 +316,8 @@ static bool testPokemonGoAddItemsToStore() {
     Pokemon pikachu = pokemonCreate("Pikachu", "Raichu", 3, 1, types1,
                                     &pokemon_error);
     listDestroy(types1);
-    Location bern = mapGet(pokemonGoGetLocations(pokemonGo), "bern");
+    Location bern = mapGet(pokemonGoGetLocations(pokemonGo),
+                           pokemonGoFindName(pokemonGo, "bern"));
     ASSERT_TEST(locationAddPokemon(bern, pikachu) == LOCATION_SUCCESS);
     ASSERT_TEST(pokemonGoAddTrainer(pokemonGo, stderr, "Linda", 1000, "bern") ==
                 POKEMON_GO_SUCCESS);
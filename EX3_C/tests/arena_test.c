@@ -0,0 +1,65 @@
+#include <stdint.h>
+#include <string.h>
+#include "../arena.h"
+#include "test_utilities.h"
+
+
+static bool testArenaCreate() {
+    Arena arena = arenaCreate();
+    ASSERT_TEST(arena != NULL);
+    ASSERT_TEST(arenaGetChunksNum(arena) == 0);
+    ASSERT_TEST(arenaGetChunksNum(NULL) == -1);
+    arenaDestroy(arena);
+    arenaDestroy(NULL);
+    return true;
+}
+
+static bool testArenaAlloc() {
+    Arena arena = arenaCreate();
+    char* blocks[1000];
+    for (int i = 0; i < 1000; ++i) {
+        size_t size = (size_t)(i % 40 + 1);
+        blocks[i] = arenaAlloc(arena, size);
+        ASSERT_TEST(blocks[i] != NULL);
+        ASSERT_TEST((uintptr_t)blocks[i] % 16 == 0);
+        memset(blocks[i], i % 128, size);
+    }
+    // Small blocks share a few chunks, and don't overlap.
+    ASSERT_TEST(arenaGetChunksNum(arena) == 1);
+    for (int i = 0; i < 1000; ++i) {
+        size_t size = (size_t)(i % 40 + 1);
+        for (size_t j = 0; j < size; ++j) {
+            ASSERT_TEST(blocks[i][j] == i % 128);
+        }
+    }
+    char* large = arenaAlloc(arena, 100000);
+    ASSERT_TEST(large != NULL);
+    memset(large, 1, 100000);
+    ASSERT_TEST(arenaGetChunksNum(arena) == 2);
+    arenaFree(arena, large, 100000);
+    arenaDestroy(arena);
+    return true;
+}
+
+static bool testArenaFree() {
+    Arena arena = arenaCreate();
+    void* block = arenaAlloc(arena, 24);
+    arenaFree(arena, block, 24);
+    // A freed block is reused by the next allocation of its size class.
+    ASSERT_TEST(arenaAlloc(arena, 32) == block);
+    ASSERT_TEST(arenaAlloc(arena, 24) != block);
+    arenaFree(arena, NULL, 24);
+    arenaDestroy(arena);
+    // Without an arena, blocks are on the heap.
+    block = arenaAlloc(NULL, 24);
+    ASSERT_TEST(block != NULL);
+    arenaFree(NULL, block, 24);
+    return true;
+}
+
+int main() {
+    RUN_TEST(testArenaCreate);
+    RUN_TEST(testArenaAlloc);
+    RUN_TEST(testArenaFree);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../intern.h"
+#include "../map.h"
+
+/**
+ * Benchmarks of the keys of the PokemonGo maps, as copied strings and as
+ * interned names:
+ *     gcc -std=c99 -O2 tests/intern_benchmark.c intern.c map_mtm/map_hash.c \
+ *         arena.c
+ *
+ * Usage: intern_benchmark [names_num] [commands_num]
+ * Puts names_num (100K by default) names into the pokedex, locations and
+ * trainers maps, with a tenth of the names in more than one map, as Pokemons
+ * and locations may share a name, and counts the memory of the keys. Then
+ * runs commands_num (10M by default) commands, each looking up a name given
+ * as a string once, as the parser hands it over, and then again LOOKUPS_NUM
+ * times, as the commands look up the trainer again in the hunt and battle.
+ */
+
+#define RUN_BENCHMARK(b, interned) do { \
+        clock_t start = clock(); \
+        long found = b(interned); \
+        fprintf(stderr, "%s (%s, %d names, %d commands): %.1f ms, " \
+                "%ld found\n", #b, interned ? "interned" : "strings", \
+                names_num, commands_num, \
+                (clock() - start) * 1000.0 / CLOCKS_PER_SEC, found); \
+} while (0)
+
+#define MAPS_NUM 3
+#define LOOKUPS_NUM 3
+#define MAX_NAME_LEN 24
+
+static int names_num;
+static int commands_num;
+static char (*names)[MAX_NAME_LEN];
+static Map maps[MAPS_NUM];
+static InternTable table;
+static long strings_allocations;
+static size_t strings_memory;
+
+static MapKeyElement copyString(MapKeyElement str) {
+    size_t size = strlen(str) + 1;
+    char* copy = malloc(size);
+    if (!copy) {
+        return NULL;
+    }
+    strings_allocations++;
+    strings_memory += size;
+    return memcpy(copy, str, size);
+}
+
+static MapKeyElement copyName(MapKeyElement name) {
+    return name;
+}
+
+static void freeNothing(MapKeyElement element) {
+    (void)element;
+}
+
+static int compareStrings(MapKeyElement str1, MapKeyElement str2) {
+    return strcmp(str1, str2);
+}
+
+static unsigned int hashString(MapKeyElement str) {
+    unsigned int hash = 2166136261U;
+    for (unsigned char* c = str; *c; ++c) {
+        hash = (hash ^ *c) * 16777619U;
+    }
+    return hash;
+}
+
+/** Returns the index of the map of the i-th name, and of its second one. */
+static int mapOf(int i, int second) {
+    return (i + second * (i % 10 == 0)) % MAPS_NUM;
+}
+
+static void buildMaps(bool interned) {
+    int value = 0;
+    strings_allocations = 0;
+    strings_memory = 0;
+    for (int m = 0; m < MAPS_NUM; ++m) {
+        maps[m] = interned ?
+                  mapCreateHashed(copyName, copyName, freeNothing, freeNothing,
+                                  internCompare, internHash) :
+                  mapCreateHashed(copyString, copyName, free, freeNothing,
+                                  compareStrings, hashString);
+    }
+    table = interned ? internTableCreate() : NULL;
+    for (int i = 0; i < names_num; ++i) {
+        for (int second = 0; second < 2; ++second) {
+            char* key = interned ? internString(table, names[i]) : names[i];
+            mapPut(maps[mapOf(i, second)], key, &value);
+        }
+    }
+    if (interned) {
+        fprintf(stderr, "interned keys: %d strings in an arena, %zu bytes "
+                "with the index\n",
+                internGetSize(table), internGetMemory(table));
+    } else {
+        fprintf(stderr, "string keys: %ld allocations, %zu bytes\n",
+                strings_allocations, strings_memory);
+    }
+}
+
+static void destroyMaps() {
+    for (int m = 0; m < MAPS_NUM; ++m) {
+        mapDestroy(maps[m]);
+    }
+    internTableDestroy(table);
+}
+
+static long BenchmarkCommands(bool interned) {
+    long found = 0;
+    for (int i = 0; i < commands_num; ++i) {
+        int index = (int)(((unsigned int)i * 2654435761U) % names_num);
+        // Every other command names a missing trainer.
+        char* name = names[index];
+        if (i % 2 == 1) {
+            name[0] = 'X';
+        }
+        Map map = maps[mapOf(index, 0)];
+        char* key = interned ? internFind(table, name) : name;
+        for (int lookup = 0; lookup <= LOOKUPS_NUM; ++lookup) {
+            found += mapGet(map, key) != NULL;
+        }
+        name[0] = 'n';
+    }
+    return found;
+}
+
+int main(int argc, char** argv) {
+    names_num = argc > 1 ? atoi(argv[1]) : 100000;
+    commands_num = argc > 2 ? atoi(argv[2]) : 10000000;
+    names = malloc(sizeof(*names) * names_num);
+    if (!names) {
+        return 1;
+    }
+    for (int i = 0; i < names_num; ++i) {
+        sprintf(names[i], "name_of_trainer%d", i);
+    }
+    buildMaps(false);
+    RUN_BENCHMARK(BenchmarkCommands, false);
+    destroyMaps();
+    buildMaps(true);
+    RUN_BENCHMARK(BenchmarkCommands, true);
+    destroyMaps();
+    free(names);
+    return 0;
+}
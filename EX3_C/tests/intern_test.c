@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <string.h>
+#include "../intern.h"
+#include "test_utilities.h"
+
+
+static bool testInternTableCreate() {
+    InternTable table = internTableCreate();
+    ASSERT_TEST(table != NULL);
+    ASSERT_TEST(internGetSize(table) == 0);
+    ASSERT_TEST(internGetSize(NULL) == -1);
+    internTableDestroy(table);
+    internTableDestroy(NULL);
+    return true;
+}
+
+static bool testInternString() {
+    InternTable table = internTableCreate();
+    char name[] = "pikachu";
+    char* pikachu = internString(table, name);
+    ASSERT_TEST(pikachu != NULL && pikachu != name);
+    ASSERT_TEST(strcmp(pikachu, "pikachu") == 0);
+    // Equal strings are interned once.
+    ASSERT_TEST(internString(table, "pikachu") == pikachu);
+    ASSERT_TEST(internString(table, pikachu) == pikachu);
+    ASSERT_TEST(internGetSize(table) == 1);
+    char* empty = internString(table, "");
+    ASSERT_TEST(empty != NULL && empty != pikachu && *empty == '\0');
+    ASSERT_TEST(internString(table, NULL) == NULL);
+    ASSERT_TEST(internString(NULL, name) == NULL);
+    // The table grows past its first slots and keeps every string.
+    char* strings[1000];
+    for (int i = 0; i < 1000; ++i) {
+        char buffer[16];
+        sprintf(buffer, "name%d", i);
+        strings[i] = internString(table, buffer);
+        ASSERT_TEST(strings[i] != NULL);
+    }
+    ASSERT_TEST(internGetSize(table) == 1002);
+    for (int i = 0; i < 1000; ++i) {
+        char buffer[16];
+        sprintf(buffer, "name%d", i);
+        ASSERT_TEST(internString(table, buffer) == strings[i]);
+    }
+    ASSERT_TEST(internString(table, "pikachu") == pikachu);
+    ASSERT_TEST(internGetMemory(table) > 1000 * sizeof("name0"));
+    internTableDestroy(table);
+    return true;
+}
+
+static bool testInternFind() {
+    InternTable table = internTableCreate();
+    ASSERT_TEST(internFind(table, "pikachu") == NULL);
+    char* pikachu = internString(table, "pikachu");
+    ASSERT_TEST(internFind(table, "pikachu") == pikachu);
+    ASSERT_TEST(internFind(table, "pikach") == NULL);
+    ASSERT_TEST(internGetSize(table) == 1);
+    ASSERT_TEST(internFind(table, NULL) == NULL);
+    ASSERT_TEST(internFind(NULL, "pikachu") == NULL);
+    internTableDestroy(table);
+    return true;
+}
+
+static bool testInternCompare() {
+    InternTable table = internTableCreate();
+    char* bulbasaur = internString(table, "bulbasaur");
+    char* pikachu = internString(table, "pikachu");
+    ASSERT_TEST(internCompare(pikachu, pikachu) == 0);
+    ASSERT_TEST(internCompare(bulbasaur, pikachu) == -1);
+    ASSERT_TEST(internCompare(pikachu, bulbasaur) == 1);
+    ASSERT_TEST(internHash(pikachu) == internHash(internFind(table, "pikachu")));
+    internTableDestroy(table);
+    return true;
+}
+
+int main() {
+    RUN_TEST(testInternTableCreate);
+    RUN_TEST(testInternString);
+    RUN_TEST(testInternFind);
+    RUN_TEST(testInternCompare);
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../keyword.h"
+#include "../reader.h"
+
+/**
+ * Benchmarks of resolving the command words of a command log and the type
+ * names of a pokedex, with chains of strcmp as the parser and main did, and
+ * with the perfect hash tables of keyword.h:
+ *     gcc -std=c99 -O2 tests/keyword_benchmark.c keyword.c reader.c
+ *
+ * Usage: keyword_benchmark [lines_num]
+ * Writes lines_num (10M by default) lines of every command, in turn, to a
+ * temporary file, and resolves the first two words of every line read back.
+ * Then the words are resolved alone, without reading them, and so are
+ * lines_num type names.
+ */
+
+#define RUN_BENCHMARK(b, hashed) do { \
+        clock_t start = clock(); \
+        long sum = b(hashed); \
+        fprintf(stderr, "%s (%s, %d lines): %.1f ms, sum %ld\n", #b, \
+                hashed ? "hashed" : "strcmp", lines_num, \
+                (clock() - start) * 1000.0 / CLOCKS_PER_SEC, sum); \
+} while (0)
+
+#define COMMANDS_NUM 10
+#define TYPES_NUM 13
+
+static const char *commands[COMMANDS_NUM] = {
+        "trainer add ash 100 bern", "trainer go ash paris",
+        "trainer purchase ash candy 3", "store add potion 10 5",
+        "battle fight ash 1 misty 2", "pokemon train ash 1",
+        "pokemon heal misty 2", "report trainer ash", "report locations",
+        "report stock"};
+
+static const char *types[TYPES_NUM] = {
+        "NORMAL", "FIRE", "WATER", "BUG", "GRASS", "FLYING", "FAIRY", "GHOST",
+        "GROUND", "ICE", "POISON", "PSYCHIC", "ROCK"};
+
+static int lines_num;
+
+/** Resolves a command as the handle functions of the parser did. */
+static Command commandByStrcmp(char *first_word, char *second_word) {
+    if (strcmp(first_word, "trainer") == 0) {
+        if (strcmp(second_word, "add") == 0) return COMMAND_TRAINER_ADD;
+        if (strcmp(second_word, "go") == 0) return COMMAND_TRAINER_GO;
+        if (strcmp(second_word, "purchase") == 0) {
+            return COMMAND_TRAINER_PURCHASE;
+        }
+    } else if (strcmp(first_word, "store") == 0) {
+        if (strcmp(second_word, "add") == 0) return COMMAND_STORE_ADD;
+    } else if (strcmp(first_word, "battle") == 0) {
+        if (strcmp(second_word, "fight") == 0) return COMMAND_BATTLE_FIGHT;
+    } else if (strcmp(first_word, "pokemon") == 0) {
+        if (strcmp(second_word, "train") == 0) return COMMAND_POKEMON_TRAIN;
+        if (strcmp(second_word, "heal") == 0) return COMMAND_POKEMON_HEAL;
+    } else if (strcmp(first_word, "report") == 0) {
+        if (strcmp(second_word, "locations") == 0) {
+            return COMMAND_REPORT_LOCATIONS;
+        }
+        if (strcmp(second_word, "stock") == 0) return COMMAND_REPORT_STOCK;
+        if (strcmp(second_word, "trainer") == 0) return COMMAND_REPORT_TRAINER;
+    } else {
+        return COMMAND_UNKNOWN;
+    }
+    return COMMAND_UNKNOWN_VERB;
+}
+
+/** Resolves a type name as stringToType of main did. */
+static PokemonType typeByStrcmp(char *type) {
+    if (strcmp(type, "NORMAL") == 0) return TYPE_NORMAL;
+    if (strcmp(type, "FIRE") == 0) return TYPE_FIRE;
+    if (strcmp(type, "WATER") == 0) return TYPE_WATER;
+    if (strcmp(type, "BUG") == 0) return TYPE_BUG;
+    if (strcmp(type, "GRASS") == 0) return TYPE_GRASS;
+    if (strcmp(type, "FLYING") == 0) return TYPE_FLYING;
+    if (strcmp(type, "FAIRY") == 0) return TYPE_FAIRY;
+    if (strcmp(type, "GHOST") == 0) return TYPE_GHOST;
+    if (strcmp(type, "GROUND") == 0) return TYPE_GROUND;
+    if (strcmp(type, "ICE") == 0) return TYPE_ICE;
+    if (strcmp(type, "POISON") == 0) return TYPE_POISON;
+    if (strcmp(type, "PSYCHIC") == 0) return TYPE_PSYCHIC;
+    if (strcmp(type, "ROCK") == 0) return TYPE_ROCK;
+    return TYPE_NORMAL;
+}
+
+static FILE *writeLines(const char **lines, int lines_kinds) {
+    FILE *file = tmpfile();
+    if (!file) {
+        return NULL;
+    }
+    for (int i = 0; i < lines_num; ++i) {
+        fprintf(file, "%s\n", lines[i % lines_kinds]);
+    }
+    return file;
+}
+
+/** Sums the commands of the lines, read and split with a Reader. */
+static long BenchmarkCommands(bool hashed) {
+    FILE *file = writeLines(commands, COMMANDS_NUM);
+    rewind(file);
+    clock_t start = clock();
+    Reader reader = readerCreate(file, false);
+    long sum = 0;
+    char *line;
+    while ((line = readerNextLine(reader)) != NULL) {
+        char *first_word = readerNextToken(&line);
+        char *second_word = readerNextToken(&line);
+        sum += hashed ? keywordGetCommand(first_word, second_word)
+                      : commandByStrcmp(first_word, second_word);
+    }
+    readerDestroy(reader);
+    fclose(file);
+    fprintf(stderr, "  read and resolved in %.1f ms\n",
+            (clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    return sum;
+}
+
+/** Sums the commands of the first two words of the lines alone. */
+static long BenchmarkCommandWords(bool hashed) {
+    char words[COMMANDS_NUM][2][16];
+    for (int i = 0; i < COMMANDS_NUM; ++i) {
+        sscanf(commands[i], "%15s %15s", words[i][0], words[i][1]);
+    }
+    long sum = 0;
+    for (int i = 0; i < lines_num; ++i) {
+        char (*command)[16] = words[i % COMMANDS_NUM];
+        sum += hashed ? keywordGetCommand(command[0], command[1])
+                      : commandByStrcmp(command[0], command[1]);
+    }
+    return sum;
+}
+
+static long BenchmarkTypes(bool hashed) {
+    long sum = 0;
+    for (int i = 0; i < lines_num; ++i) {
+        char *type = (char *) types[i % TYPES_NUM];
+        sum += hashed ? keywordGetType(type) : typeByStrcmp(type);
+    }
+    return sum;
+}
+
+int main(int argc, char **argv) {
+    lines_num = argc > 1 ? atoi(argv[1]) : 10000000;
+    RUN_BENCHMARK(BenchmarkCommands, false);
+    RUN_BENCHMARK(BenchmarkCommands, true);
+    RUN_BENCHMARK(BenchmarkCommandWords, false);
+    RUN_BENCHMARK(BenchmarkCommandWords, true);
+    RUN_BENCHMARK(BenchmarkTypes, false);
+    RUN_BENCHMARK(BenchmarkTypes, true);
+    return 0;
+}
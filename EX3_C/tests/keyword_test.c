@@ -0,0 +1,63 @@
+#include "../keyword.h"
+#include "test_utilities.h"
+
+
+static bool testKeywordGetCommand() {
+    // Every command resolves to itself, so no two share a slot.
+    char *words[][2] = {{"trainer", "add"}, {"trainer", "go"},
+                        {"trainer", "purchase"}, {"store", "add"},
+                        {"battle", "fight"}, {"pokemon", "train"},
+                        {"pokemon", "heal"}, {"report", "trainer"},
+                        {"report", "locations"}, {"report", "stock"}};
+    Command expected[] = {COMMAND_TRAINER_ADD, COMMAND_TRAINER_GO,
+                          COMMAND_TRAINER_PURCHASE, COMMAND_STORE_ADD,
+                          COMMAND_BATTLE_FIGHT, COMMAND_POKEMON_TRAIN,
+                          COMMAND_POKEMON_HEAL, COMMAND_REPORT_TRAINER,
+                          COMMAND_REPORT_LOCATIONS, COMMAND_REPORT_STOCK};
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TEST(keywordGetCommand(words[i][0], words[i][1]) ==
+                    expected[i]);
+    }
+    return true;
+}
+
+static bool testKeywordGetCommandUnknown() {
+    ASSERT_TEST(keywordGetCommand("trainer", "fight") == COMMAND_UNKNOWN_VERB);
+    ASSERT_TEST(keywordGetCommand("store", "adds") == COMMAND_UNKNOWN_VERB);
+    ASSERT_TEST(keywordGetCommand("report", "Stock") == COMMAND_UNKNOWN_VERB);
+    ASSERT_TEST(keywordGetCommand("report", "") == COMMAND_UNKNOWN_VERB);
+    ASSERT_TEST(keywordGetCommand("battle", NULL) == COMMAND_UNKNOWN_VERB);
+    ASSERT_TEST(keywordGetCommand("trainers", "add") == COMMAND_UNKNOWN);
+    ASSERT_TEST(keywordGetCommand("add", "trainer") == COMMAND_UNKNOWN);
+    ASSERT_TEST(keywordGetCommand("t", "add") == COMMAND_UNKNOWN);
+    ASSERT_TEST(keywordGetCommand("", "add") == COMMAND_UNKNOWN);
+    ASSERT_TEST(keywordGetCommand(NULL, "add") == COMMAND_UNKNOWN);
+    return true;
+}
+
+static bool testKeywordGetType() {
+    char *names[] = {"NORMAL", "FIRE", "WATER", "BUG", "GRASS", "FLYING",
+                     "FAIRY", "GHOST", "GROUND", "ICE", "POISON", "PSYCHIC",
+                     "ROCK"};
+    PokemonType expected[] = {TYPE_NORMAL, TYPE_FIRE, TYPE_WATER, TYPE_BUG,
+                              TYPE_GRASS, TYPE_FLYING, TYPE_FAIRY, TYPE_GHOST,
+                              TYPE_GROUND, TYPE_ICE, TYPE_POISON,
+                              TYPE_PSYCHIC, TYPE_ROCK};
+    for (int i = 0; i < 13; ++i) {
+        ASSERT_TEST(keywordGetType(names[i]) == expected[i]);
+    }
+    ASSERT_TEST(keywordGetType("ELECTRIC") == TYPE_NORMAL);
+    ASSERT_TEST(keywordGetType("fire") == TYPE_NORMAL);
+    ASSERT_TEST(keywordGetType("FIREE") == TYPE_NORMAL);
+    ASSERT_TEST(keywordGetType("F") == TYPE_NORMAL);
+    ASSERT_TEST(keywordGetType("") == TYPE_NORMAL);
+    ASSERT_TEST(keywordGetType(NULL) == TYPE_NORMAL);
+    return true;
+}
+
+int main() {
+    RUN_TEST(testKeywordGetCommand);
+    RUN_TEST(testKeywordGetCommandUnknown);
+    RUN_TEST(testKeywordGetType);
+    return 0;
+}
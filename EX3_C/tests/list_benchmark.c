@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../list.h"
+
+/**
+ * Benchmarks of the List on the workloads of the game: short lists which
+ * are iterated far more often than they change. The implementation is
+ * chosen when linking, tests/list_linked.c being the linked baseline:
+ *     gcc -std=c99 -O2 tests/list_benchmark.c list_mtm/list_mtm.c arena.c
+ *     gcc -std=c99 -O2 tests/list_benchmark.c tests/list_linked.c arena.c
+ *
+ * Usage: list_benchmark [lists_num]
+ * Builds lists_num (100K by default) lists of Pokemon types and of nearby
+ * location names, then scans the types as pokemonPrize does, searches the
+ * names as isNearby does, and copies and sorts item values as the reports
+ * of trainers do.
+ */
+
+#define RUN_BENCHMARK(b) do { \
+        clock_t start = clock(); \
+        b(); \
+        fprintf(stderr, "%s (%d lists): %.1f ms\n", #b, lists_num, \
+                (clock() - start) * 1000.0 / CLOCKS_PER_SEC); \
+} while (0)
+
+#define SCANS_NUM 20
+#define MAX_TYPES 3
+#define MAX_NEARBY 8
+#define MAX_ITEMS 16
+#define TYPES_NUM 18
+#define MAX_NAME_LEN 20
+
+static int lists_num;
+static List* types_lists;
+static List* nearby_lists;
+
+static ListElement copyInt(ListElement n) {
+    int* copy = malloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int*)n;
+    return copy;
+}
+
+static void freeElement(ListElement element) {
+    free(element);
+}
+
+static int compareInts(ListElement n1, ListElement n2) {
+    int int_1 = *(int*)n1, int_2 = *(int*)n2;
+    return int_1 > int_2 ? 1 : (int_1 < int_2 ? -1 : 0);
+}
+
+static ListElement copyString(ListElement str) {
+    char* copy = malloc(strlen(str) + 1);
+    return copy ? strcpy(copy, str) : NULL;
+}
+
+static void BenchmarkBuild() {
+    char name[MAX_NAME_LEN];
+    for (int i = 0; i < lists_num; ++i) {
+        types_lists[i] = listCreate(copyInt, freeElement);
+        for (int t = 0; t <= i % MAX_TYPES; ++t) {
+            int type = (i * 7 + t) % TYPES_NUM;
+            listInsertLast(types_lists[i], &type);
+        }
+        nearby_lists[i] = listCreate(copyString, freeElement);
+        for (int n = 0; n <= i % MAX_NEARBY; ++n) {
+            sprintf(name, "location%d", (i + n * 31) % lists_num);
+            listInsertLast(nearby_lists[i], name);
+        }
+    }
+}
+
+static void BenchmarkPrize() {
+    long prize = 0;
+    for (int scan = 0; scan < SCANS_NUM; ++scan) {
+        for (int i = 0; i < lists_num; ++i) {
+            int max_prize = 10;
+            LIST_FOREACH(int*, type, types_lists[i]) {
+                if (*type % 3 == 0 && max_prize < 30) {
+                    max_prize = 30;
+                } else if (*type % 3 == 1 && max_prize < 20) {
+                    max_prize = 20;
+                }
+            }
+            prize += max_prize;
+        }
+    }
+    fprintf(stderr, "  %d scans, prize %ld\n", SCANS_NUM, prize);
+}
+
+static void BenchmarkNearby() {
+    char name[MAX_NAME_LEN];
+    long found = 0;
+    for (int scan = 0; scan < SCANS_NUM; ++scan) {
+        for (int i = 0; i < lists_num; ++i) {
+            // Half of the searches miss, and scan the whole list.
+            sprintf(name, "location%d", (i + (scan % 2) * 17) % lists_num);
+            LIST_FOREACH(char*, nearby, nearby_lists[i]) {
+                if (strcmp(nearby, name) == 0) {
+                    found++;
+                    break;
+                }
+            }
+        }
+    }
+    fprintf(stderr, "  %d scans, %ld found\n", SCANS_NUM, found);
+}
+
+static void BenchmarkSort() {
+    List items = listCreate(copyInt, freeElement);
+    long first = 0;
+    for (int i = 0; i < lists_num / MAX_ITEMS; ++i) {
+        listClear(items);
+        for (int n = 0; n < MAX_ITEMS; ++n) {
+            int value = (i * 13 + n * 7) % 100;
+            listInsertLast(items, &value);
+        }
+        List sorted = listCopy(items);
+        listSort(sorted, compareInts);
+        first += *(int*)listGetFirst(sorted);
+        listDestroy(sorted);
+    }
+    listDestroy(items);
+    fprintf(stderr, "  %d sorts, sum of minimums %ld\n", lists_num / MAX_ITEMS,
+            first);
+}
+
+static void BenchmarkDestroy() {
+    for (int i = 0; i < lists_num; ++i) {
+        listDestroy(types_lists[i]);
+        listDestroy(nearby_lists[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    lists_num = argc > 1 ? atoi(argv[1]) : 100000;
+    types_lists = malloc(sizeof(*types_lists) * lists_num);
+    nearby_lists = malloc(sizeof(*nearby_lists) * lists_num);
+    if (!types_lists || !nearby_lists) {
+        return 1;
+    }
+    RUN_BENCHMARK(BenchmarkBuild);
+    RUN_BENCHMARK(BenchmarkPrize);
+    RUN_BENCHMARK(BenchmarkNearby);
+    RUN_BENCHMARK(BenchmarkSort);
+    RUN_BENCHMARK(BenchmarkDestroy);
+    free(types_lists);
+    free(nearby_lists);
+    return 0;
+}
@@ -0,0 +1,287 @@
+#include "../list.h"
+#include <stdlib.h>
+
+/**
+* Linked List Container
+*
+* The baseline list_benchmark measures list_mtm/list_mtm.c against: a doubly
+* linked list behind list.h, with one node allocated per element. listSort is
+* a merge sort of the nodes. It is not part of the game; link it instead of
+* list_mtm/list_mtm.c to time it:
+*     gcc -std=c99 -O2 tests/list_benchmark.c tests/list_linked.c arena.c
+*/
+
+typedef struct Node_t {
+    ListElement element;
+    struct Node_t* previous;
+    struct Node_t* next;
+} *Node;
+
+struct List_t {
+    Node first;
+    Node last;
+    Node current;
+    int size;
+    CopyListElement copyElement;
+    FreeListElement freeElement;
+    Arena arena;
+};
+
+//-------------------------- Auxiliary Functions -------------------------------
+
+/**
+* Links a node holding a copy of an element before a node, or last if next
+* is NULL.
+*/
+static ListResult listInsertBefore(List list, Node next, ListElement element) {
+    Node node = arenaAlloc(list->arena, sizeof(*node));
+    if (!node) {
+        return LIST_OUT_OF_MEMORY;
+    }
+    node->element = list->copyElement(element);
+    if (!node->element) {
+        arenaFree(list->arena, node, sizeof(*node));
+        return LIST_OUT_OF_MEMORY;
+    }
+    node->next = next;
+    node->previous = next ? next->previous : list->last;
+    if (node->previous) {
+        node->previous->next = node;
+    } else {
+        list->first = node;
+    }
+    if (next) {
+        next->previous = node;
+    } else {
+        list->last = node;
+    }
+    list->size++;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+/**
+* Merge sorts a chain of size nodes linked by next, and returns its new head.
+* Equal elements keep their order.
+*/
+static Node mergeSort(Node head, int size, CompareListElements compare) {
+    if (size < 2) {
+        return head;
+    }
+    Node middle = head;
+    for (int i = 1; i < size / 2; ++i) {
+        middle = middle->next;
+    }
+    Node second = middle->next;
+    middle->next = NULL;
+    Node left = mergeSort(head, size / 2, compare);
+    Node right = mergeSort(second, size - size / 2, compare);
+    struct Node_t merged = { NULL, NULL, NULL };
+    Node tail = &merged;
+    while (left && right) {
+        if (compare(right->element, left->element) < 0) {
+            tail->next = right;
+            right = right->next;
+        } else {
+            tail->next = left;
+            left = left->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = left ? left : right;
+    return merged.next;
+}
+
+//--------------------------- Interface Functions ------------------------------
+
+List listCreate(CopyListElement copyElement, FreeListElement freeElement) {
+    return listCreateInArena(copyElement, freeElement, NULL);
+}
+/*----------------------------------------------------------------------------*/
+List listCreateInArena(CopyListElement copyElement, FreeListElement freeElement,
+                       Arena arena) {
+    if (!copyElement || !freeElement) {
+        return NULL;
+    }
+    List list = arenaAlloc(arena, sizeof(*list));
+    if (!list) {
+        return NULL;
+    }
+    list->first = NULL;
+    list->last = NULL;
+    list->current = NULL;
+    list->size = 0;
+    list->copyElement = copyElement;
+    list->freeElement = freeElement;
+    list->arena = arena;
+    return list;
+}
+/*----------------------------------------------------------------------------*/
+List listCopy(List list) {
+    if (!list) {
+        return NULL;
+    }
+    List copy = listCreateInArena(list->copyElement, list->freeElement,
+                                  list->arena);
+    if (!copy) {
+        return NULL;
+    }
+    for (Node node = list->first; node; node = node->next) {
+        if (listInsertBefore(copy, NULL, node->element) != LIST_SUCCESS) {
+            listDestroy(copy);
+            return NULL;
+        }
+        if (node == list->current) {
+            copy->current = copy->last;
+        }
+    }
+    return copy;
+}
+/*----------------------------------------------------------------------------*/
+int listGetSize(List list) {
+    if (!list) {
+        return -1;
+    }
+    return list->size;
+}
+/*----------------------------------------------------------------------------*/
+ListElement listGetFirst(List list) {
+    if (!list) {
+        return NULL;
+    }
+    list->current = list->first;
+    return listGetCurrent(list);
+}
+/*----------------------------------------------------------------------------*/
+ListElement listGetNext(List list) {
+    if (!list || !list->current) {
+        return NULL;
+    }
+    list->current = list->current->next;
+    return listGetCurrent(list);
+}
+/*----------------------------------------------------------------------------*/
+ListElement listGetCurrent(List list) {
+    if (!list || !list->current) {
+        return NULL;
+    }
+    return list->current->element;
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertFirst(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    return listInsertBefore(list, list->first, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertLast(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    return listInsertBefore(list, NULL, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertBeforeCurrent(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    if (!list->current) {
+        return LIST_INVALID_CURRENT;
+    }
+    return listInsertBefore(list, list->current, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listInsertAfterCurrent(List list, ListElement element) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    if (!list->current) {
+        return LIST_INVALID_CURRENT;
+    }
+    return listInsertBefore(list, list->current->next, element);
+}
+/*----------------------------------------------------------------------------*/
+ListResult listRemoveCurrent(List list) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    Node node = list->current;
+    if (!node) {
+        return LIST_INVALID_CURRENT;
+    }
+    if (node->previous) {
+        node->previous->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+    if (node->next) {
+        node->next->previous = node->previous;
+    } else {
+        list->last = node->previous;
+    }
+    list->freeElement(node->element);
+    arenaFree(list->arena, node, sizeof(*node));
+    list->size--;
+    list->current = NULL;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+ListResult listSort(List list, CompareListElements compareElement) {
+    if (!list || !compareElement) {
+        return LIST_NULL_ARGUMENT;
+    }
+    list->first = mergeSort(list->first, list->size, compareElement);
+    Node previous = NULL;
+    for (Node node = list->first; node; node = node->next) {
+        node->previous = previous;
+        previous = node;
+    }
+    list->last = previous;
+    list->current = NULL;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+List listFilter(List list, FilterListElement filterElement, ListFilterKey key) {
+    if (!list || !filterElement) {
+        return NULL;
+    }
+    List filtered = listCreateInArena(list->copyElement, list->freeElement,
+                                      list->arena);
+    if (!filtered) {
+        return NULL;
+    }
+    for (Node node = list->first; node; node = node->next) {
+        if (filterElement(node->element, key) &&
+            listInsertBefore(filtered, NULL, node->element) != LIST_SUCCESS) {
+            listDestroy(filtered);
+            return NULL;
+        }
+    }
+    return filtered;
+}
+/*----------------------------------------------------------------------------*/
+ListResult listClear(List list) {
+    if (!list) {
+        return LIST_NULL_ARGUMENT;
+    }
+    Node node = list->first;
+    while (node) {
+        Node next = node->next;
+        list->freeElement(node->element);
+        arenaFree(list->arena, node, sizeof(*node));
+        node = next;
+    }
+    list->first = NULL;
+    list->last = NULL;
+    list->current = NULL;
+    list->size = 0;
+    return LIST_SUCCESS;
+}
+/*----------------------------------------------------------------------------*/
+void listDestroy(List list) {
+    if (!list) {
+        return;
+    }
+    listClear(list);
+    arenaFree(list->arena, list, sizeof(*list));
+}
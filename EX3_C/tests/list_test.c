@@ -0,0 +1,199 @@
+#include "test_utilities.h"
+#include <stdlib.h>
+#include "../list.h"
+
+/** Function to be used for copying an int into the list */
+static ListElement copyInt(ListElement n) {
+    int* copy = malloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int*)n;
+    return copy;
+}
+
+/** Function to be used by the list for freeing elements */
+static void freeInt(ListElement n) {
+    free(n);
+}
+
+/** Function to be used by the list for sorting ints in ascending order */
+static int compareInts(ListElement n1, ListElement n2) {
+    int int_1 = *(int*)n1, int_2 = *(int*)n2;
+    return int_1 > int_2 ? 1 : (int_1 < int_2 ? -1 : 0);
+}
+
+static bool isEven(ListElement n, ListFilterKey key) {
+    (void)key;
+    return *(int*)n % 2 == 0;
+}
+
+/** Checks that a list holds the given ints, in order. */
+static bool listEquals(List list, int* expected, int size) {
+    int i = 0;
+    LIST_FOREACH(int*, n, list) {
+        if (i >= size || *n != expected[i]) {
+            return false;
+        }
+        i++;
+    }
+    return i == size && listGetSize(list) == size;
+}
+
+static bool testListCreate() {
+    List list = listCreate(copyInt, freeInt);
+    ASSERT_TEST(list != NULL);
+    ASSERT_TEST(listGetSize(list) == 0);
+    ASSERT_TEST(listGetFirst(list) == NULL);
+    ASSERT_TEST(listGetCurrent(list) == NULL);
+    ASSERT_TEST(listCreate(NULL, freeInt) == NULL);
+    ASSERT_TEST(listGetSize(NULL) == -1);
+    listDestroy(list);
+    listDestroy(NULL);
+    return true;
+}
+
+static bool testListInsert() {
+    List list = listCreate(copyInt, freeInt);
+    int values[] = {1, 2, 3, 4, 5};
+    ASSERT_TEST(listInsertBeforeCurrent(list, &values[0]) ==
+                LIST_INVALID_CURRENT);
+    ASSERT_TEST(listInsertLast(list, &values[2]) == LIST_SUCCESS);
+    ASSERT_TEST(listInsertFirst(list, &values[0]) == LIST_SUCCESS);
+    ASSERT_TEST(*(int*)listGetFirst(list) == 1);
+    ASSERT_TEST(*(int*)listGetNext(list) == 3);
+    // The iterator stays at its element when inserting around it.
+    ASSERT_TEST(listInsertBeforeCurrent(list, &values[1]) == LIST_SUCCESS);
+    ASSERT_TEST(listInsertAfterCurrent(list, &values[3]) == LIST_SUCCESS);
+    ASSERT_TEST(listInsertFirst(list, &values[4]) == LIST_SUCCESS);
+    ASSERT_TEST(*(int*)listGetCurrent(list) == 3);
+    ASSERT_TEST(*(int*)listGetNext(list) == 4);
+    int expected[] = {5, 1, 2, 3, 4};
+    ASSERT_TEST(listEquals(list, expected, 5));
+    ASSERT_TEST(listGetNext(list) == NULL);
+    ASSERT_TEST(listInsertAfterCurrent(list, &values[0]) ==
+                LIST_INVALID_CURRENT);
+    ASSERT_TEST(listInsertLast(NULL, &values[0]) == LIST_NULL_ARGUMENT);
+    listDestroy(list);
+    return true;
+}
+
+static bool testListRemoveCurrent() {
+    List list = listCreate(copyInt, freeInt);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TEST(listInsertLast(list, &i) == LIST_SUCCESS);
+    }
+    ASSERT_TEST(listRemoveCurrent(list) == LIST_INVALID_CURRENT);
+    LIST_FOREACH(int*, n, list) {
+        if (*n == 4) {
+            ASSERT_TEST(listRemoveCurrent(list) == LIST_SUCCESS);
+            break;
+        }
+    }
+    ASSERT_TEST(listGetCurrent(list) == NULL);
+    listGetFirst(list);
+    ASSERT_TEST(listRemoveCurrent(list) == LIST_SUCCESS);
+    int expected[] = {1, 2, 3, 5, 6, 7, 8, 9};
+    ASSERT_TEST(listEquals(list, expected, 8));
+    ASSERT_TEST(listClear(list) == LIST_SUCCESS);
+    ASSERT_TEST(listGetSize(list) == 0);
+    ASSERT_TEST(listRemoveCurrent(NULL) == LIST_NULL_ARGUMENT);
+    listDestroy(list);
+    return true;
+}
+
+static bool testListCopyAndFilter() {
+    List list = listCreate(copyInt, freeInt);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TEST(listInsertLast(list, &i) == LIST_SUCCESS);
+    }
+    listGetFirst(list);
+    listGetNext(list);
+    List copy = listCopy(list);
+    ASSERT_TEST(*(int*)listGetCurrent(copy) == 1);
+    int all[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ASSERT_TEST(listEquals(copy, all, 10));
+    List even = listFilter(list, isEven, NULL);
+    int expected[] = {0, 2, 4, 6, 8};
+    ASSERT_TEST(listEquals(even, expected, 5));
+    ASSERT_TEST(listFilter(list, NULL, NULL) == NULL);
+    ASSERT_TEST(listCopy(NULL) == NULL);
+    listDestroy(even);
+    listDestroy(copy);
+    listDestroy(list);
+    return true;
+}
+
+static bool testListInArena() {
+    Arena arena = arenaCreate();
+    List lists[100];
+    for (int l = 0; l < 100; ++l) {
+        lists[l] = listCreateInArena(copyInt, freeInt, arena);
+        ASSERT_TEST(lists[l] != NULL);
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TEST(listInsertLast(lists[l], &i) == LIST_SUCCESS);
+        }
+    }
+    // The lists share a few chunks of memory.
+    ASSERT_TEST(arenaGetChunksNum(arena) < 100);
+    // Arrays larger than ARENA_MAX_BLOCK grow in chunks of their own.
+    for (int i = 10; i < 300; ++i) {
+        ASSERT_TEST(listInsertLast(lists[0], &i) == LIST_SUCCESS);
+    }
+    List copy = listCopy(lists[0]);
+    List even = listFilter(lists[0], isEven, NULL);
+    ASSERT_TEST(listGetSize(copy) == 300);
+    ASSERT_TEST(listGetSize(even) == 150);
+    int i = 0;
+    LIST_FOREACH(int*, n, copy) {
+        ASSERT_TEST(*n == i++);
+    }
+    for (int l = 0; l < 100; ++l) {
+        listDestroy(lists[l]);
+    }
+    listDestroy(copy);
+    listDestroy(even);
+    arenaDestroy(arena);
+    ASSERT_TEST(listCreateInArena(copyInt, NULL, NULL) == NULL);
+    return true;
+}
+
+static bool testListSort() {
+    List list = listCreate(copyInt, freeInt);
+    ASSERT_TEST(listSort(list, compareInts) == LIST_SUCCESS);
+    ASSERT_TEST(listSort(list, NULL) == LIST_NULL_ARGUMENT);
+    // Random, sorted, reversed and equal elements, short and long lists.
+    int sizes[] = {1, 2, 5, 17, 100, 5000};
+    for (int s = 0; s < 6; ++s) {
+        for (int order = 0; order < 4; ++order) {
+            listClear(list);
+            srand(234122);
+            for (int i = 0; i < sizes[s]; ++i) {
+                int n = order == 0 ? rand() % 1000 : order == 1 ? i :
+                        order == 2 ? -i : 7;
+                ASSERT_TEST(listInsertLast(list, &n) == LIST_SUCCESS);
+            }
+            ASSERT_TEST(listSort(list, compareInts) == LIST_SUCCESS);
+            ASSERT_TEST(listGetSize(list) == sizes[s]);
+            int last = -1000000, count = 0;
+            LIST_FOREACH(int*, n, list) {
+                ASSERT_TEST(*n >= last);
+                last = *n;
+                count++;
+            }
+            ASSERT_TEST(count == sizes[s]);
+        }
+    }
+    listDestroy(list);
+    return true;
+}
+
+int main() {
+    RUN_TEST(testListCreate);
+    RUN_TEST(testListInsert);
+    RUN_TEST(testListRemoveCurrent);
+    RUN_TEST(testListCopyAndFilter);
+    RUN_TEST(testListInArena);
+    RUN_TEST(testListSort);
+    return 0;
+}
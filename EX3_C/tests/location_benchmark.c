@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../location.h"
+#include "../map.h"
+
+/**
+ * Benchmarks of checking if a location is reachable, as the trainer go
+ * command does, by comparing the nearby names and by searching the nearby
+ * ids:
+ *     gcc -std=c99 -O2 tests/location_benchmark.c location.c pokemon.c \
+ *         list_mtm/list_mtm.c map_mtm/map_hash.c arena.c
+ *
+ * Usage: location_benchmark [locations_num] [commands_num]
+ * Builds locations_num (100K by default) locations with 1 to MAX_NEARBY
+ * nearby locations each, indexes them as pokemonGoIndexLocations does, and
+ * runs commands_num (10M by default) checks, half of them reachable. The
+ * checks are timed alone and with the lookups of both locations by name.
+ */
+
+#define RUN_BENCHMARK(b, by_ids) do { \
+        clock_t start = clock(); \
+        long reachable = b(by_ids); \
+        fprintf(stderr, "%s (%s, %d locations, %d commands): %.1f ms, " \
+                "%ld reachable\n", #b, by_ids ? "ids" : "names", \
+                locations_num, commands_num, \
+                (clock() - start) * 1000.0 / CLOCKS_PER_SEC, reachable); \
+} while (0)
+
+#define MAX_NEARBY 8
+#define MAX_NAME_LEN 20
+
+static int locations_num;
+static int commands_num;
+static char (*names)[MAX_NAME_LEN];
+static Location* locations;
+static Map locations_map;
+
+static MapKeyElement copyString(MapKeyElement str) {
+    char* copy = malloc(strlen(str) + 1);
+    return copy ? strcpy(copy, str) : NULL;
+}
+
+static void freeString(MapKeyElement str) {
+    free(str);
+}
+
+static int compareStrings(MapKeyElement str1, MapKeyElement str2) {
+    return strcmp(str1, str2);
+}
+
+static unsigned int hashString(MapKeyElement str) {
+    unsigned int hash = 2166136261U;
+    for (unsigned char* c = str; *c; ++c) {
+        hash = (hash ^ *c) * 16777619U;
+    }
+    return hash;
+}
+
+static MapDataElement copyLocation(MapDataElement location) {
+    LocationResult error;
+    return locationCopy(location, &error);
+}
+
+static void freeLocation(MapDataElement location) {
+    locationDestroy(location);
+}
+
+/** Returns the index of the n-th nearby location of a location. */
+static int nearbyIndex(int index, int n) {
+    return (int)((index + 1 + (long)n * 7919) % locations_num);
+}
+
+static void buildLocations() {
+    locations_map = mapCreateHashed(copyString, copyLocation, freeString,
+                                    freeLocation, compareStrings, hashString);
+    for (int i = 0; i < locations_num; ++i) {
+        LocationResult error;
+        sprintf(names[i], "location%d", i);
+        Location location = locationCreate(names[i], &error);
+        mapPutOwned(locations_map, copyString(names[i]), location);
+        locations[i] = location;
+    }
+    for (int i = 0; i < locations_num; ++i) {
+        for (int n = 0; n <= i % MAX_NEARBY; ++n) {
+            locationAddNearby(locations[i], names[nearbyIndex(i, n)]);
+        }
+    }
+    // Index the locations as pokemonGoIndexLocations does.
+    int id = 0;
+    MapIterator iterator;
+    MAP_ITER_FOREACH(iterator, locations_map) {
+        locationSetId(mapIterData(&iterator), id++);
+    }
+    int ids[MAX_NEARBY];
+    MAP_ITER_FOREACH(iterator, locations_map) {
+        int ids_num = 0;
+        LIST_FOREACH(char*, name,
+                     locationGetNearby(mapIterData(&iterator))) {
+            ids[ids_num++] = locationGetId(mapGet(locations_map, name));
+        }
+        locationSetNearbyIds(mapIterData(&iterator), ids, ids_num);
+    }
+}
+
+static bool isNearby(Location location, Location destination, bool by_ids) {
+    if (by_ids) {
+        return locationIsNearbyId(location, locationGetId(destination));
+    }
+    char* dest = locationGetName(destination);
+    LIST_FOREACH(char*, nearby, locationGetNearby(location)) {
+        if (strcmp(nearby, dest) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Returns the location and destination indexes of the i-th command. */
+static void commandAt(int i, int* from, int* to) {
+    *from = (int)(((unsigned int)i * 2654435761U) % locations_num);
+    *to = i % 2 == 0 ? nearbyIndex(*from, (i / 2) % (*from % MAX_NEARBY + 1))
+                     : (*from + 1 + i % 1000) % locations_num;
+}
+
+static long BenchmarkCheck(bool by_ids) {
+    long reachable = 0;
+    for (int i = 0; i < commands_num; ++i) {
+        int from, to;
+        commandAt(i, &from, &to);
+        reachable += isNearby(locations[from], locations[to], by_ids);
+    }
+    return reachable;
+}
+
+static long BenchmarkGoCommand(bool by_ids) {
+    long reachable = 0;
+    for (int i = 0; i < commands_num; ++i) {
+        int from, to;
+        commandAt(i, &from, &to);
+        reachable += isNearby(mapGet(locations_map, names[from]),
+                              mapGet(locations_map, names[to]), by_ids);
+    }
+    return reachable;
+}
+
+int main(int argc, char** argv) {
+    locations_num = argc > 1 ? atoi(argv[1]) : 100000;
+    commands_num = argc > 2 ? atoi(argv[2]) : 10000000;
+    names = malloc(sizeof(*names) * locations_num);
+    locations = malloc(sizeof(*locations) * locations_num);
+    if (!names || !locations) {
+        return 1;
+    }
+    buildLocations();
+    RUN_BENCHMARK(BenchmarkCheck, false);
+    RUN_BENCHMARK(BenchmarkCheck, true);
+    RUN_BENCHMARK(BenchmarkGoCommand, false);
+    RUN_BENCHMARK(BenchmarkGoCommand, true);
+    mapDestroy(locations_map);
+    free(locations);
+    free(names);
+    return 0;
+}
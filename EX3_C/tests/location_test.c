@@ -22,6 +22,22 @@ static bool testLocationCopy(){
     return true;
 }
 
+static bool testLocationCopyOutlivesArena(){
+    LocationResult error;
+    Arena arena = arenaCreate();
+    Location paris = locationCreateInArena("paris", arena, &error);
+    ASSERT_TEST(error == LOCATION_SUCCESS);
+    ASSERT_TEST(locationAddNearby(paris, "rome") == LOCATION_SUCCESS);
+    Location copy = locationCopy(paris, &error);
+    ASSERT_TEST(copy != NULL);
+    locationDestroy(paris);
+    arenaDestroy(arena);
+    ASSERT_TEST(strcmp(listGetFirst(locationGetNearby(copy)), "rome") == 0);
+    ASSERT_TEST(locationAddNearby(copy, "berlin") == LOCATION_SUCCESS);
+    locationDestroy(copy);
+    return true;
+}
+
 static bool testLocationDestroy(){
     LocationResult error;
     Location paris = locationCreate("paris", &error);
@@ -108,16 +124,47 @@ static bool testLocationGetNearby(){
     return true;
 }
 
+static bool testLocationNearbyIds(){
+    LocationResult error;
+    Location paris = locationCreate("paris",&error);
+    ASSERT_TEST(locationGetId(paris) == LOCATION_NO_ID);
+    ASSERT_TEST(!locationHasNearbyIds(paris));
+    ASSERT_TEST(!locationIsNearbyId(paris, 3));
+    locationSetId(paris, 7);
+    int ids[] = {9, 3, 12, 0};
+    ASSERT_TEST(locationSetNearbyIds(paris, ids, 4) == LOCATION_SUCCESS);
+    ASSERT_TEST(locationHasNearbyIds(paris));
+    ASSERT_TEST(locationIsNearbyId(paris, 0));
+    ASSERT_TEST(locationIsNearbyId(paris, 3));
+    ASSERT_TEST(locationIsNearbyId(paris, 12));
+    ASSERT_TEST(!locationIsNearbyId(paris, 7));
+    ASSERT_TEST(!locationIsNearbyId(paris, 13));
+    Location copy = locationCopy(paris, &error);
+    ASSERT_TEST(locationGetId(copy) == 7);
+    ASSERT_TEST(locationIsNearbyId(copy, 9));
+    // Adding a nearby location clears the ids, which are stale.
+    ASSERT_TEST(locationAddNearby(paris, "rome") == LOCATION_SUCCESS);
+    ASSERT_TEST(!locationHasNearbyIds(paris));
+    ASSERT_TEST(locationSetNearbyIds(paris, NULL, 0) == LOCATION_SUCCESS);
+    ASSERT_TEST(locationHasNearbyIds(paris));
+    ASSERT_TEST(!locationIsNearbyId(paris, 0));
+    locationDestroy(copy);
+    locationDestroy(paris);
+    return true;
+}
+
 
 int main(){
     RUN_TEST(testLocationCreate);
     RUN_TEST(testLocationDestroy);
     RUN_TEST(testLocationCopy);
+    RUN_TEST(testLocationCopyOutlivesArena);
     RUN_TEST(testLocationAddNearby);
     RUN_TEST(testLocationAddPokemon);
     RUN_TEST(testLocationGetFirstPokemon);
     RUN_TEST(testLocationGetName);
     RUN_TEST(testLocationGetNearby);
     RUN_TEST(testLocationRemoveFirstPokemon);
+    RUN_TEST(testLocationNearbyIds);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../map_mtm/map_mtm.h"
+#include "../arena.h"
+
+/**
+ * Benchmarks of the Map. The implementation is chosen when linking:
+ *     gcc -std=c99 -O2 tests/map_benchmark.c map_mtm/map_hash.c arena.c
+ *     gcc -std=c99 -O2 tests/map_benchmark.c map_mtm/map_btree.c arena.c
+ *     gcc -std=c99 -O2 tests/map_benchmark.c map_mtm/map_mtm.c arena.c
+ *
+ * Usage: map_benchmark [hashed|compare] [keys_num...]
+ * The maps are created with a hash function (hashed, the default) or without
+ * one (compare), and filled with 10K and 1M keys by default. Puts are
+ * quadratic in the list map and in the hash map without a hash function, so
+ * run those with fewer keys. Then 100K trainer-like records are put with
+ * mapPut and with mapPutOwned, counting the allocations of keys and data,
+ * and 100K small maps are filled and destroyed on the heap and in an arena.
+ */
+
+#define RUN_BENCHMARK(b, hash) do { \
+        clock_t start = clock(); \
+        b(hash); \
+        fprintf(stderr, "%s (%s, %d keys): %.1f ms\n", #b, \
+                hash ? "hashed" : "compare", keys_num, \
+                (clock() - start) * 1000.0 / CLOCKS_PER_SEC); \
+} while (0)
+
+#define LOOKUPS_PER_KEY 10
+#define ITERATIONS_NUM 10
+#define TRAINERS_NUM 100000
+#define TRAINER_POKEMONS 10
+#define MAX_NAME_LEN 16
+
+static int keys_num;
+static long allocations;
+
+/** A trainer-like record: a name and a map of Pokemons. */
+typedef struct record_t {
+    char* name;
+    Map pokemons;
+} *Record;
+
+static void* countedMalloc(size_t size) {
+    allocations++;
+    return malloc(size);
+}
+
+static MapKeyElement copyInt(MapKeyElement n) {
+    int* copy = countedMalloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    *copy = *(int*)n;
+    return copy;
+}
+
+static void freeInt(MapKeyElement n) {
+    free(n);
+}
+
+static int compareInts(MapKeyElement n1, MapKeyElement n2) {
+    int int_1 = *(int*)n1, int_2 = *(int*)n2;
+    return int_1 > int_2 ? 1 : (int_1 < int_2 ? -1 : 0);
+}
+
+static unsigned int hashInt(MapKeyElement n) {
+    return (unsigned int)*(int*)n;
+}
+
+static MapKeyElement copyString(MapKeyElement str) {
+    char* copy = countedMalloc(strlen(str) + 1);
+    if (!copy) {
+        return NULL;
+    }
+    strcpy(copy, str);
+    return copy;
+}
+
+static int compareStrings(MapKeyElement str1, MapKeyElement str2) {
+    return strcmp(str1, str2);
+}
+
+static unsigned int hashString(MapKeyElement str) {
+    unsigned int hash = 2166136261U;
+    for (unsigned char* c = str; *c; ++c) {
+        hash = (hash ^ *c) * 16777619U;
+    }
+    return hash;
+}
+
+static void recordDestroy(MapDataElement element) {
+    Record record = element;
+    if (!record) {
+        return;
+    }
+    free(record->name);
+    mapDestroy(record->pokemons);
+    free(record);
+}
+
+static MapDataElement recordCopy(MapDataElement element) {
+    Record record = element;
+    Record copy = countedMalloc(sizeof(*copy));
+    if (!copy) {
+        return NULL;
+    }
+    copy->name = copyString(record->name);
+    copy->pokemons = mapCopy(record->pokemons);
+    if (!copy->name || !copy->pokemons) {
+        recordDestroy(copy);
+        return NULL;
+    }
+    return copy;
+}
+
+static Record recordCreate(int i) {
+    Record record = countedMalloc(sizeof(*record));
+    char name[MAX_NAME_LEN];
+    sprintf(name, "trainer%d", i);
+    record->name = copyString(name);
+    record->pokemons = mapCreateHashed(copyInt, copyInt, freeInt, freeInt,
+                                       compareInts, hashInt);
+    for (int id = 1; id <= TRAINER_POKEMONS; ++id) {
+        mapPut(record->pokemons, &id, &i);
+    }
+    return record;
+}
+
+/**
+ * Adds TRAINERS_NUM trainers to a map as PokemonGo does, either putting a
+ * copy and destroying the original, or handing the original over.
+ */
+static void putTrainers(bool owned) {
+    Map trainers = mapCreateHashed(copyString, recordCopy, free, recordDestroy,
+                                   compareStrings, hashString);
+    allocations = 0;
+    clock_t start = clock();
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        Record record = recordCreate(i);
+        if (owned) {
+            mapPutOwned(trainers, copyString(record->name), record);
+        } else {
+            mapPut(trainers, record->name, record);
+            recordDestroy(record);
+        }
+    }
+    fprintf(stderr, "%s: %d trainers in %.1f ms, %ld element allocations\n",
+            owned ? "mapPutOwned" : "mapPut", TRAINERS_NUM,
+            (clock() - start) * 1000.0 / CLOCKS_PER_SEC, allocations);
+    mapDestroy(trainers);
+}
+
+/**
+ * Fills TRAINERS_NUM maps of TRAINER_POKEMONS pairs, as the trainers'
+ * Pokemons are, and destroys them, either on the heap or in one arena.
+ */
+static void fillSmallMaps(bool in_arena) {
+    static Map maps[TRAINERS_NUM];
+    Arena arena = in_arena ? arenaCreate() : NULL;
+    clock_t start = clock();
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        maps[i] = mapCreateInArena(copyInt, copyInt, freeInt, freeInt,
+                                   compareInts, hashInt, arena);
+        for (int id = 1; id <= TRAINER_POKEMONS; ++id) {
+            mapPut(maps[i], &id, &i);
+        }
+    }
+    clock_t filled = clock();
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        mapDestroy(maps[i]);
+    }
+    fprintf(stderr, "%s: %d maps filled in %.1f ms, destroyed in %.1f ms",
+            in_arena ? "arena" : "heap", TRAINERS_NUM,
+            (filled - start) * 1000.0 / CLOCKS_PER_SEC,
+            (clock() - filled) * 1000.0 / CLOCKS_PER_SEC);
+    if (in_arena) {
+        fprintf(stderr, ", %d arena chunks", arenaGetChunksNum(arena));
+    }
+    fprintf(stderr, "\n");
+    arenaDestroy(arena);
+}
+
+/** Returns the i-th of keys_num distinct keys, in a scattered order. */
+static int keyAt(int i) {
+    return (int)(((unsigned int)i * 2654435761U) % 1000000007U);
+}
+
+static Map fillMap(hashMapKeyElements hash) {
+    Map map = mapCreateHashed(copyInt, copyInt, freeInt, freeInt,
+                              compareInts, hash);
+    for (int i = 0; i < keys_num; ++i) {
+        int key = keyAt(i);
+        mapPut(map, &key, &i);
+    }
+    return map;
+}
+
+static void BenchmarkPut(hashMapKeyElements hash) {
+    mapDestroy(fillMap(hash));
+}
+
+static void BenchmarkGet(hashMapKeyElements hash) {
+    Map map = fillMap(hash);
+    clock_t start = clock();
+    long found = 0;
+    int lookups_num = LOOKUPS_PER_KEY * keys_num;
+    for (int i = 0; i < lookups_num; ++i) {
+        int key = keyAt((int)((i * 7919L) % keys_num));
+        found += *(int*)mapGet(map, &key) >= 0;
+        key++;
+        found += mapContains(map, &key);
+    }
+    fprintf(stderr, "  %d lookups (half missing): %.1f ms, %ld found\n",
+            2 * lookups_num, (clock() - start) * 1000.0 / CLOCKS_PER_SEC,
+            found);
+    mapDestroy(map);
+}
+
+static void BenchmarkIterate(hashMapKeyElements hash) {
+    Map map = fillMap(hash);
+    clock_t start = clock();
+    long sum = 0;
+    for (int i = 0; i < ITERATIONS_NUM; ++i) {
+        MAP_FOREACH(int*, key, map) {
+            sum += *key;
+        }
+    }
+    fprintf(stderr, "  %d ordered iterations: %.1f ms, sum %ld\n",
+            ITERATIONS_NUM, (clock() - start) * 1000.0 / CLOCKS_PER_SEC, sum);
+    mapDestroy(map);
+}
+
+static void BenchmarkRemove(hashMapKeyElements hash) {
+    Map map = fillMap(hash);
+    clock_t start = clock();
+    for (int i = 0; i < keys_num; ++i) {
+        int key = keyAt(i);
+        mapRemove(map, &key);
+    }
+    fprintf(stderr, "  %d removes: %.1f ms\n", keys_num,
+            (clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+    mapDestroy(map);
+}
+
+int main(int argc, char** argv) {
+    hashMapKeyElements hash = hashInt;
+    int first_size = 1;
+    if (argc > 1 && (strcmp(argv[1], "hashed") == 0 ||
+                     strcmp(argv[1], "compare") == 0)) {
+        hash = strcmp(argv[1], "hashed") == 0 ? hashInt : NULL;
+        first_size = 2;
+    }
+    int default_sizes[] = {10000, 1000000};
+    int sizes_num = argc > first_size ? argc - first_size : 2;
+    for (int i = 0; i < sizes_num; ++i) {
+        keys_num = argc > first_size ? atoi(argv[first_size + i])
+                                     : default_sizes[i];
+        RUN_BENCHMARK(BenchmarkPut, hash);
+        RUN_BENCHMARK(BenchmarkGet, hash);
+        RUN_BENCHMARK(BenchmarkIterate, hash);
+        RUN_BENCHMARK(BenchmarkRemove, hash);
+    }
+    putTrainers(false);
+    putTrainers(true);
+    fillSmallMaps(false);
+    fillSmallMaps(true);
+    return 0;
+}
@@ -51,6 +51,11 @@ static int compareInts(MapKeyElement n1, MapKeyElement n2) {
     }
 }
 
+/** Function to be used by the map for hashing elements */
+static unsigned int hashInt(MapKeyElement n) {
+    return (unsigned int)*(int*)n;
+}
+
 bool testMapCreateDestroy() {
     Map map = mapCreate(copyKeyInt, copyDataChar, freeInt, freeChar, compareInts);
     ASSERT_TEST(map != NULL);
@@ -125,10 +130,264 @@ bool testIterator() {
     return true;
 }
 
+bool testMapRemove() {
+    hashMapKeyElements hashes[] = {hashInt, NULL};
+    for (int h = 0; h < 2; ++h) {
+        Map map = mapCreateHashed(copyKeyInt, copyDataChar, freeInt, freeChar,
+                                  compareInts, hashes[h]);
+        ASSERT_TEST(map != NULL);
+        for (int i = 0; i < 1000; ++i) {
+            char j = (char) i;
+            ASSERT_TEST(mapPut(map,&i,&j) == MAP_SUCCESS);
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            ASSERT_TEST(mapRemove(map,&i) == MAP_SUCCESS);
+            ASSERT_TEST(mapRemove(map,&i) == MAP_ITEM_DOES_NOT_EXIST);
+        }
+        ASSERT_TEST(mapGetSize(map) == 500);
+        for (int i = 0; i < 1000; ++i) {
+            char* getVal = (char*)mapGet(map,&i);
+            ASSERT_TEST(mapContains(map,&i) == (i % 2 == 1));
+            ASSERT_TEST(i % 2 == 0 ? getVal == NULL : *getVal == (char) i);
+        }
+        int i = 1;
+        MAP_FOREACH(int*,iter,map) {
+            ASSERT_TEST(*iter == i);
+            i += 2;
+        }
+        ASSERT_TEST(i == 1001);
+        ASSERT_TEST(mapClear(map) == MAP_SUCCESS);
+        ASSERT_TEST(mapGetSize(map) == 0);
+        ASSERT_TEST(mapGetFirst(map) == NULL);
+        mapDestroy(map);
+    }
+    return true;
+}
+
+bool testMapHashedIterator() {
+    Map map = mapCreateHashed(copyKeyInt, copyDataChar, freeInt, freeChar,
+                              compareInts, hashInt);
+    for (int i = 999; i >= 500; --i) {
+        char j = (char) i;
+        ASSERT_TEST(mapPut(map,&i,&j) == MAP_SUCCESS);
+    }
+    int i = 500;
+    MAP_FOREACH(int*,iter,map) {
+        ASSERT_TEST(*iter == i++);
+        // Looking up and overriding keys doesn't move the iterator.
+        char j = 'x';
+        ASSERT_TEST(mapGet(map,iter) != NULL);
+        ASSERT_TEST(mapPut(map,iter,&j) == MAP_SUCCESS);
+    }
+    ASSERT_TEST(i == 1000);
+    // Keys put after an iteration are merged into the order.
+    for (int k = 0; k < 500; k += 2) {
+        char j = (char) k;
+        ASSERT_TEST(mapPut(map,&k,&j) == MAP_SUCCESS);
+    }
+    for (int k = 499; k > 0; k -= 2) {
+        char j = (char) k;
+        ASSERT_TEST(mapPut(map,&k,&j) == MAP_SUCCESS);
+    }
+    i = 0;
+    MAP_FOREACH(int*,iter,map) {
+        ASSERT_TEST(*iter == i++);
+    }
+    ASSERT_TEST(i == 1000);
+    Map copy = mapCopy(map);
+    ASSERT_TEST(mapGetSize(copy) == 1000);
+    i = 0;
+    MAP_FOREACH(int*,iter,copy) {
+        ASSERT_TEST(*iter == i);
+        ASSERT_TEST(*(char*)mapGet(copy,iter) == (i < 500 ? (char) i : 'x'));
+        i++;
+    }
+    mapDestroy(copy);
+    mapDestroy(map);
+    return true;
+}
+
+bool testMapPutOwned() {
+    Map map = mapCreateHashed(copyKeyInt, copyDataChar, freeInt, freeChar,
+                              compareInts, hashInt);
+    for (int i = 0; i < 1000; ++i) {
+        int* key = malloc(sizeof(*key));
+        char* data = malloc(sizeof(*data));
+        *key = i % 500;
+        *data = (char) i;
+        ASSERT_TEST(mapPutOwned(map,key,data) == MAP_SUCCESS);
+        // The map holds the given data itself, not a copy. The given key is
+        // freed if the map already has an equal one.
+        int lookup = i % 500;
+        ASSERT_TEST(mapGet(map,&lookup) == data);
+    }
+    ASSERT_TEST(mapGetSize(map) == 500);
+    int i = 0;
+    MAP_FOREACH(int*,iter,map) {
+        ASSERT_TEST(*iter == i);
+        ASSERT_TEST(*(char*)mapGet(map,iter) == (char)(i + 500));
+        i++;
+    }
+    char data = 'a';
+    ASSERT_TEST(mapPutOwned(NULL,&i,&data) == MAP_NULL_ARGUMENT);
+    ASSERT_TEST(mapPutOwned(map,NULL,&data) == MAP_NULL_ARGUMENT);
+    ASSERT_TEST(mapPutOwned(map,&i,NULL) == MAP_NULL_ARGUMENT);
+    mapDestroy(map);
+    return true;
+}
+
+bool testMapExternalIterator() {
+    Map map = mapCreateHashed(copyKeyInt, copyDataChar, freeInt, freeChar,
+                              compareInts, hashInt);
+    MapIterator outer, inner;
+    ASSERT_TEST(mapIterBegin(map,&outer) == MAP_SUCCESS);
+    ASSERT_TEST(mapIterKey(&outer) == NULL);
+    ASSERT_TEST(mapIterData(&outer) == NULL);
+    for (int i = 0; i < 300; ++i) {
+        int key = (i * 7) % 300;
+        char j = (char) key;
+        ASSERT_TEST(mapPut(map,&key,&j) == MAP_SUCCESS);
+    }
+    // Nested iterations visit every ordered pair, and neither lookups nor
+    // the internal iterator move them.
+    int pairs = 0, i = 0;
+    MAP_ITER_FOREACH(outer,map) {
+        ASSERT_TEST(*(int*)mapIterKey(&outer) == i);
+        ASSERT_TEST(mapIterData(&outer) == mapGet(map,mapIterKey(&outer)));
+        int j = 0;
+        MAP_ITER_FOREACH(inner,map) {
+            ASSERT_TEST(*(int*)mapIterKey(&inner) == j++);
+            ASSERT_TEST(*(char*)mapIterData(&inner) ==
+                        (char)*(int*)mapIterKey(&inner));
+            pairs++;
+        }
+        ASSERT_TEST(j == 300);
+        ASSERT_TEST(*(int*)mapGetFirst(map) == 0);
+        i++;
+    }
+    ASSERT_TEST(i == 300 && pairs == 300 * 300);
+    mapIterNext(&outer);
+    ASSERT_TEST(mapIterKey(&outer) == NULL);
+    ASSERT_TEST(mapIterBegin(NULL,&outer) == MAP_NULL_ARGUMENT);
+    ASSERT_TEST(mapIterKey(&outer) == NULL);
+    ASSERT_TEST(mapIterBegin(map,NULL) == MAP_NULL_ARGUMENT);
+    ASSERT_TEST(mapIterKey(NULL) == NULL);
+    ASSERT_TEST(mapIterData(NULL) == NULL);
+    mapIterNext(NULL);
+    mapDestroy(map);
+    return true;
+}
+
+bool testMapInArena() {
+    Arena arena = arenaCreate();
+    Map maps[100];
+    for (int m = 0; m < 100; ++m) {
+        maps[m] = mapCreateInArena(copyKeyInt, copyDataChar, freeInt, freeChar,
+                                   compareInts, hashInt, arena);
+        ASSERT_TEST(maps[m] != NULL);
+        for (int i = 0; i < 50; ++i) {
+            int key = (i * 7 + m) % 50;
+            char j = (char) key;
+            ASSERT_TEST(mapPut(maps[m],&key,&j) == MAP_SUCCESS);
+        }
+        for (int i = 0; i < 50; i += 3) {
+            ASSERT_TEST(mapRemove(maps[m],&i) == MAP_SUCCESS);
+        }
+    }
+    Map copy = mapCopy(maps[0]);
+    mapDestroy(maps[0]);
+    ASSERT_TEST(mapGetSize(copy) == 33);
+    int i = 0;
+    MAP_FOREACH(int*,iter,copy) {
+        i += i % 3 == 0;
+        ASSERT_TEST(*iter == i);
+        ASSERT_TEST(*(char*)mapGet(copy,iter) == (char) i);
+        i++;
+    }
+    ASSERT_TEST(i == 50);
+    // The maps share a few chunks of memory.
+    ASSERT_TEST(arenaGetChunksNum(arena) < 100);
+    mapDestroy(copy);
+    for (int m = 1; m < 100; ++m) {
+        mapDestroy(maps[m]);
+    }
+    arenaDestroy(arena);
+    ASSERT_TEST(mapCreateInArena(copyKeyInt, copyDataChar, NULL, freeChar,
+                                 compareInts, hashInt, NULL) == NULL);
+    return true;
+}
+
+bool testMapInArenaReusesBlocks() {
+    Arena arena = arenaCreate();
+    int chunks = 0;
+    for (int cycle = 0; cycle < 10; ++cycle) {
+        Map map = mapCreateInArena(copyKeyInt, copyDataChar, freeInt, freeChar,
+                                   compareInts, hashInt, arena);
+        ASSERT_TEST(map != NULL);
+        for (int i = 0; i < 3000; ++i) {
+            char j = (char) i;
+            ASSERT_TEST(mapPut(map,&i,&j) == MAP_SUCCESS);
+        }
+        mapDestroy(map);
+        // Blocks are freed in the size they were allocated in, so every
+        // cycle reuses the blocks of the previous one.
+        if (cycle == 0) {
+            chunks = arenaGetChunksNum(arena);
+        }
+        ASSERT_TEST(arenaGetChunksNum(arena) == chunks);
+    }
+    arenaDestroy(arena);
+    return true;
+}
+
+bool testMapRandomOperations() {
+    Map map = mapCreateHashed(copyKeyInt, copyDataChar, freeInt, freeChar,
+                              compareInts, hashInt);
+    char present[3000] = {0};
+    int size = 0;
+    srand(234122);
+    for (int op = 0; op < 100000; ++op) {
+        int key = rand() % 3000;
+        char data = (char)(op % 100 + 1);
+        if (rand() % 5 < (op < 50000 ? 3 : 2)) {
+            ASSERT_TEST(mapPut(map,&key,&data) == MAP_SUCCESS);
+            size += !present[key];
+            present[key] = data;
+        } else {
+            ASSERT_TEST(mapRemove(map,&key) ==
+                        (present[key] ? MAP_SUCCESS : MAP_ITEM_DOES_NOT_EXIST));
+            size -= present[key] != 0;
+            present[key] = 0;
+        }
+        ASSERT_TEST(mapGetSize(map) == size);
+        if (op % 10000 == 0) {
+            Map copy = mapCopy(map);
+            int last = -1, seen = 0;
+            MAP_FOREACH(int*,iter,copy) {
+                ASSERT_TEST(*iter > last && present[*iter]);
+                ASSERT_TEST(*(char*)mapGet(map,iter) == present[*iter]);
+                last = *iter;
+                seen++;
+            }
+            ASSERT_TEST(seen == size);
+            mapDestroy(copy);
+        }
+    }
+    mapDestroy(map);
+    return true;
+}
+
 int main() {
     RUN_TEST(testMapCreateDestroy);
     RUN_TEST(testMapAddAndSize);
     RUN_TEST(testMapGet);
     RUN_TEST(testIterator);
+    RUN_TEST(testMapRemove);
+    RUN_TEST(testMapHashedIterator);
+    RUN_TEST(testMapPutOwned);
+    RUN_TEST(testMapExternalIterator);
+    RUN_TEST(testMapInArena);
+    RUN_TEST(testMapInArenaReusesBlocks);
+    RUN_TEST(testMapRandomOperations);
     return 0;
 }
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../reader.h"
+
+/**
+ * Benchmarks of reading and splitting a command log, with fgets, strtok and
+ * atoi as main did, and with a Reader; and of writing the output lines of
+ * the commands with the default output buffer and with a large one:
+ *     gcc -std=c99 -O2 tests/reader_benchmark.c reader.c
+ *
+ * Usage: reader_benchmark [commands_num]
+ * Writes a log of commands_num (10M by default) commands to a temporary
+ * file, reads it back both ways, and reports commands per second.
+ */
+
+#define RUN_BENCHMARK(b, arg) do { \
+        clock_t start = clock(); \
+        long sum = b(arg); \
+        double seconds = (double) (clock() - start) / CLOCKS_PER_SEC; \
+        fprintf(stderr, "%s (%s, %d commands): %.1f ms, %.2fM commands/s, " \
+                "sum %ld\n", #b, arg ? "new" : "old", commands_num, \
+                seconds * 1000, commands_num / seconds / 1e6, sum); \
+} while (0)
+
+#define MAX_INPUT_LEN 250
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+#define OLD_DELIMITER " \r\t\n"
+
+static int commands_num;
+static FILE *commands;
+
+static void writeCommands() {
+    for (int i = 0; i < commands_num; ++i) {
+        switch (i % 4) {
+            case 0:
+                fprintf(commands, "trainer go trainer%d location%d\n",
+                        i % 1000, i % 97);
+                break;
+            case 1:
+                fprintf(commands, "battle fight trainer%d %d trainer%d %d\n",
+                        i % 1000, i % 7 + 1, (i + 1) % 1000, i % 5 + 1);
+                break;
+            case 2:
+                fprintf(commands, "trainer purchase trainer%d candy %d\n",
+                        i % 1000, i % 50 + 1);
+                break;
+            default:
+                fprintf(commands, "pokemon heal trainer%d %d\n", i % 1000,
+                        i % 9 + 1);
+        }
+    }
+}
+
+/** Sums the lengths of the words and the numbers of every command. */
+static long BenchmarkRead(bool with_reader) {
+    rewind(commands);
+    long sum = 0;
+    if (with_reader) {
+        Reader reader = readerCreate(commands, false);
+        char *line;
+        while ((line = readerNextLine(reader)) != NULL) {
+            for (char *token = readerNextToken(&line); token;
+                 token = readerNextToken(&line)) {
+                sum += *token >= '0' && *token <= '9' ?
+                       readerParseInt(token) : (long) strlen(token);
+            }
+        }
+        readerDestroy(reader);
+        return sum;
+    }
+    char line[MAX_INPUT_LEN];
+    while (fgets(line, MAX_INPUT_LEN, commands) != NULL) {
+        for (char *token = strtok(line, OLD_DELIMITER); token;
+             token = strtok(NULL, OLD_DELIMITER)) {
+            sum += *token >= '0' && *token <= '9' ?
+                   atoi(token) : (long) strlen(token);
+        }
+    }
+    return sum;
+}
+
+/** Writes a catch result line per command, as the trainer go command does. */
+static long BenchmarkWrite(bool large_buffer) {
+    FILE *output = tmpfile();
+    if (!output) {
+        return 0;
+    }
+    if (large_buffer) {
+        setvbuf(output, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+    for (int i = 0; i < commands_num; ++i) {
+        fprintf(output, "trainer%d caught pikachu at location%d\n", i % 1000,
+                i % 97);
+    }
+    fflush(output);
+    long size = ftell(output);
+    fclose(output);
+    return size;
+}
+
+int main(int argc, char **argv) {
+    commands_num = argc > 1 ? atoi(argv[1]) : 10000000;
+    commands = tmpfile();
+    if (!commands) {
+        return 1;
+    }
+    writeCommands();
+    RUN_BENCHMARK(BenchmarkRead, false);
+    RUN_BENCHMARK(BenchmarkRead, true);
+    RUN_BENCHMARK(BenchmarkWrite, false);
+    RUN_BENCHMARK(BenchmarkWrite, true);
+    fclose(commands);
+    return 0;
+}
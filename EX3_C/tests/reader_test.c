@@ -0,0 +1,111 @@
+#include <string.h>
+#include "../reader.h"
+#include "test_utilities.h"
+
+/** Returns a stream holding the given contents, rewound. */
+static FILE *streamCreate(const char *contents, size_t size) {
+    FILE *stream = tmpfile();
+    if (!stream) {
+        return NULL;
+    }
+    fwrite(contents, 1, size, stream);
+    rewind(stream);
+    return stream;
+}
+
+static bool testReaderCreate() {
+    FILE *input = streamCreate("", 0);
+    ASSERT_TEST(input != NULL);
+    Reader reader = readerCreate(input, false);
+    ASSERT_TEST(reader != NULL);
+    ASSERT_TEST(readerNextLine(reader) == NULL);
+    ASSERT_TEST(readerCreate(NULL, false) == NULL);
+    ASSERT_TEST(readerNextLine(NULL) == NULL);
+    readerDestroy(reader);
+    readerDestroy(NULL);
+    fclose(input);
+    return true;
+}
+
+static bool testReaderNextLine() {
+    const char contents[] = "trainer add ash 10 bern\r\n\nreport stock";
+    for (int interactive = 0; interactive <= 1; ++interactive) {
+        FILE *input = streamCreate(contents, sizeof(contents) - 1);
+        Reader reader = readerCreate(input, interactive);
+        ASSERT_TEST(strcmp(readerNextLine(reader),
+                           "trainer add ash 10 bern\r") == 0);
+        ASSERT_TEST(strcmp(readerNextLine(reader), "") == 0);
+        // The last line has no newline.
+        ASSERT_TEST(strcmp(readerNextLine(reader), "report stock") == 0);
+        ASSERT_TEST(readerNextLine(reader) == NULL);
+        ASSERT_TEST(readerNextLine(reader) == NULL);
+        readerDestroy(reader);
+        fclose(input);
+    }
+    return true;
+}
+
+static bool testReaderLongInput() {
+    // Lines which cross the ends of the buffer come back whole, and a line
+    // longer than the buffer comes back in pieces.
+    FILE *input = tmpfile();
+    ASSERT_TEST(input != NULL);
+    int lines_num = READER_BUFFER_SIZE / 10;
+    for (int i = 0; i < lines_num; ++i) {
+        fprintf(input, "line %d\n", i);
+    }
+    for (int i = 0; i < READER_BUFFER_SIZE + 10; ++i) {
+        fputc('x', input);
+    }
+    fputc('\n', input);
+    rewind(input);
+    Reader reader = readerCreate(input, false);
+    for (int i = 0; i < lines_num; ++i) {
+        char expected[32];
+        sprintf(expected, "line %d", i);
+        ASSERT_TEST(strcmp(readerNextLine(reader), expected) == 0);
+    }
+    ASSERT_TEST(strlen(readerNextLine(reader)) == READER_BUFFER_SIZE);
+    ASSERT_TEST(strcmp(readerNextLine(reader), "xxxxxxxxxx") == 0);
+    ASSERT_TEST(readerNextLine(reader) == NULL);
+    readerDestroy(reader);
+    fclose(input);
+    return true;
+}
+
+static bool testReaderNextToken() {
+    char command[] = "  battle\tfight ash 1  misty 2\r";
+    char *line = command;
+    ASSERT_TEST(strcmp(readerNextToken(&line), "battle") == 0);
+    ASSERT_TEST(strcmp(readerNextToken(&line), "fight") == 0);
+    ASSERT_TEST(strcmp(readerNextToken(&line), "ash") == 0);
+    ASSERT_TEST(strcmp(readerNextToken(&line), "1") == 0);
+    ASSERT_TEST(strcmp(readerNextToken(&line), "misty") == 0);
+    ASSERT_TEST(strcmp(readerNextToken(&line), "2") == 0);
+    ASSERT_TEST(readerNextToken(&line) == NULL);
+    ASSERT_TEST(readerNextToken(&line) == NULL);
+    ASSERT_TEST(readerNextToken(NULL) == NULL);
+    char empty[] = " \t";
+    line = empty;
+    ASSERT_TEST(readerNextToken(&line) == NULL);
+    return true;
+}
+
+static bool testReaderParseInt() {
+    char *tokens[] = {"0", "42", "-7", "+13", "12ab", "ab", "-", "2147483647"};
+    int expected[] = {0, 42, -7, 13, 12, 0, 0, 2147483647};
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TEST(readerParseInt(tokens[i]) == expected[i]);
+    }
+    ASSERT_TEST(readerParseInt(NULL) == 0);
+    return true;
+}
+
+int main() {
+    RUN_TEST(testReaderCreate);
+    RUN_TEST(testReaderNextLine);
+    RUN_TEST(testReaderLongInput);
+    RUN_TEST(testReaderNextToken);
+    RUN_TEST(testReaderParseInt);
+    return 0;
+}
@@ -91,6 +91,15 @@ int compareIdx(MapKeyElement idx1, MapKeyElement idx2) {
 }
 /*----------------------------------------------------------------------------*/
 /**
+* An integer hash function to pass to Map.
+* @param index
+* @return the integer itself, which the Map mixes.
+*/
+unsigned int hashIdx(MapKeyElement idx) {
+    return (unsigned int) *(int *) idx;
+}
+/*----------------------------------------------------------------------------*/
+/**
 * An -item value- compare function to pass to List. (for ascending order sort)
 * @param item1, item2
 * @return a positive value if arg1 is bigger than arg2,
@@ -159,8 +168,8 @@ Trainer trainerCreate(char *name, int budget, char *starting_location,
         return NULL;
     }
     trainer->trainer_items = store;
-    Map pokemons = mapCreate(copyIdx, pokemonMapCopy, freeIdx,
-                             pokemonMapDestroy, compareIdx);
+    Map pokemons = mapCreateHashed(copyIdx, pokemonMapCopy, freeIdx,
+                                   pokemonMapDestroy, compareIdx, hashIdx);
     if (!pokemons) {
         free(trainer->name);
         free(trainer->current_location);
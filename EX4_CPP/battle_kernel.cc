@@ -0,0 +1,124 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include "battle_kernel.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const double MAX_HP = 100;
+static const double NO_HP = 0;
+static const int WIN_BONUS = 2;
+static const int LOSS_PENALTY = -1;
+static const int TEAMS_NUM = RED + 1;
+static const int SELF_WON = 1;
+static const int RIVAL_WON = -1;
+
+// The arrays of a batch never overlap. Telling the compiler so lets it
+// vectorise the loops without runtime overlap checks.
+#define RESTRICT __restrict
+// -------------------------------------------------------------------------- //
+//                             AUX FUNCTIONS                                  //
+// -------------------------------------------------------------------------- //
+namespace {
+    // Uses the item of side on its Pokemon, then hits that Pokemon with the
+    // Pokemon of other. As in Trainer::Battle, the Pokemon of other is the one
+    // removed when the hit it dealt brings side's Pokemon to zero HP.
+    void ResolveHits(BattleSide& side, const BattleSide& other,
+                     int* RESTRICT other_removed, int battles) {
+        const int* RESTRICT has = side.has_pokemon.data();
+        const int* RESTRICT other_has = other.has_pokemon.data();
+        const int* RESTRICT item = side.item.data();
+        const int* RESTRICT pokemon_level = side.pokemon_level.data();
+        const double* RESTRICT other_hit_power = other.hit_power.data();
+        double* RESTRICT hp = side.hp.data();
+        double* RESTRICT cp = side.cp.data();
+        for (int i = 0; i < battles; ++i) {
+            // The masks are 0 or 1, so multiplying by them selects exactly.
+            const int fight = (has[i] != 0) & (other_has[i] != 0);
+            const double candy = (double)(fight & (item[i] == CANDY));
+            const double potion = (double)(fight & (item[i] == POTION));
+            const double healed = potion * MAX_HP + (1 - potion) * hp[i];
+            const double hit_hp = healed - (double)fight * other_hit_power[i];
+            cp[i] *= 1 + candy * (pokemon_level[i] / 10.0);
+            hp[i] = hit_hp;
+            other_removed[i] = fight & (int)(hit_hp <= NO_HP);
+        }
+    }
+
+    // Rewards side for the battles it won and penalises it for the battles
+    // it lost.
+    void RewardBattles(BattleSide& side, const BattleSide& other,
+                       const int* RESTRICT winner, int side_won,
+                       int other_won, int battles) {
+        const int* RESTRICT other_level = other.level.data();
+        int* RESTRICT level = side.level.data();
+        int* RESTRICT score = side.score.data();
+        for (int i = 0; i < battles; ++i) {
+            const int won = winner[i] == side_won;
+            const int lost = winner[i] == other_won;
+            level[i] += won * ((other_level[i] + 1) / 2);
+            score[i] += won * WIN_BONUS + lost * LOSS_PENALTY;
+        }
+    }
+}
+// -------------------------------------------------------------------------- //
+//                                FUNCTIONS                                   //
+// -------------------------------------------------------------------------- //
+void BattleSide::Resize(int battles) {
+    has_pokemon.resize(battles);
+    hp.resize(battles);
+    cp.resize(battles);
+    hit_power.resize(battles);
+    pokemon_level.resize(battles);
+    item.resize(battles);
+    team.resize(battles);
+    level.resize(battles);
+    score.resize(battles);
+}
+//------------------------------------------------------------------------------
+void mtm::pokemongo::ResolveBattles(BattleSide& self, BattleSide& rival,
+                                    BattleResults& results) {
+    const int battles = (int)self.has_pokemon.size();
+    results.winner.resize(battles);
+    results.self_pokemon_removed.resize(battles);
+    results.rival_pokemon_removed.resize(battles);
+
+    // Items and hits. Only battles in which both trainers own a Pokemon use
+    // items and hit; the others keep their HP and CP.
+    ResolveHits(self, rival, results.rival_pokemon_removed.data(), battles);
+    ResolveHits(rival, self, results.self_pokemon_removed.data(), battles);
+
+    // Winners. A trainer without Pokemons loses; otherwise the stronger
+    // Pokemon wins and equal Pokemons are decided by team colors.
+    int* RESTRICT winner = results.winner.data();
+    const int* RESTRICT self_has = self.has_pokemon.data();
+    const int* RESTRICT rival_has = rival.has_pokemon.data();
+    const double* RESTRICT self_hit_power = self.hit_power.data();
+    const double* RESTRICT rival_hit_power = rival.hit_power.data();
+    const int* RESTRICT self_team = self.team.data();
+    const int* RESTRICT rival_team = rival.team.data();
+    for (int i = 0; i < battles; ++i) {
+        // A team beats the team that follows it by two places modulo
+        // TEAMS_NUM, i.e. the team whose color is 1 lower or 2 higher.
+        const int team_diff = self_team[i] - rival_team[i];
+        const int tie_winner =
+                ((team_diff == 1) | (team_diff == 1 - TEAMS_NUM)) -
+                ((team_diff == -1) | (team_diff == TEAMS_NUM - 1));
+        // The comparison masks are double wide, so they are turned into
+        // 1.0 / 0.0 and converted once: SSE2 cannot narrow them to int lanes.
+        const double power_diff = self_hit_power[i] - rival_hit_power[i];
+        const int power_sign = (int)((double)(power_diff > 0) -
+                                     (double)(power_diff < 0));
+        const int fight_winner = power_sign + (power_sign == 0) * tie_winner;
+        const int self_has_pokemon = self_has[i] != 0;
+        const int rival_has_pokemon = rival_has[i] != 0;
+        winner[i] = self_has_pokemon * (rival_has_pokemon * fight_winner +
+                                        (1 - rival_has_pokemon) * SELF_WON) +
+                    (1 - self_has_pokemon) * RIVAL_WON;
+    }
+
+    RewardBattles(self, rival, winner, SELF_WON, RIVAL_WON, battles);
+    RewardBattles(rival, self, winner, RIVAL_WON, SELF_WON, battles);
+}
+//------------------------------------------------------------------------------
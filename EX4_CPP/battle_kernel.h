@@ -0,0 +1,63 @@
+#ifndef BATTLE_KERNEL_H
+#define BATTLE_KERNEL_H
+
+#include <vector>
+#include "item.h"
+#include "trainer.h"
+
+namespace mtm {
+namespace pokemongo {
+
+// The item effect of a side that uses no item in battle.
+static const int NO_ITEM = -1;
+
+// One side of a batch of battles, in structure-of-arrays layout: entry i of
+// every array describes the side's trainer in battle i and the strongest
+// Pokemon it owns. All the arrays must have the same size.
+struct BattleSide {
+  // 1 if the trainer owns a Pokemon, 0 otherwise. When it is 0 the Pokemon
+  // entries of the battle are ignored.
+  std::vector<int> has_pokemon;
+  std::vector<double> hp;
+  std::vector<double> cp;
+  std::vector<double> hit_power;
+  std::vector<int> pokemon_level;
+  // The type (CANDY or POTION) of the oldest item of the trainer, or NO_ITEM.
+  std::vector<int> item;
+  std::vector<int> team;
+  std::vector<int> level;
+  std::vector<int> score;
+
+  // Resizes all the arrays of the side to the given number of battles.
+  void Resize(int battles);
+};
+
+// The results of a batch of battles. Entry i of every array describes battle
+// i.
+struct BattleResults {
+  // 1 if self won, -1 if the rival won, 0 if nobody did.
+  std::vector<int> winner;
+  // 1 if the side's Pokemon is removed after the battle, 0 otherwise.
+  std::vector<int> self_pokemon_removed;
+  std::vector<int> rival_pokemon_removed;
+};
+
+// Resolves a batch of independent battles. Battle i is resolved the way
+// self.Battle(rival) resolves it for trainers described by entry i of self and
+// rival: items are used, Pokemons hit each other, and the HP, CP, level and
+// score arrays of both sides are updated in place.
+//
+// The loops select with 0/1 masks instead of branching and their arrays are
+// __restrict, so GCC vectorises all three at -O3: with SSE2 on x86-64, or
+// with AVX2 when built with -mavx2.
+//
+// @param self the sides whose trainers start the battles.
+// @param rival the sides whose trainers are challenged.
+// @param results the results of the battles. Resized to the number of battles.
+void ResolveBattles(BattleSide& self, BattleSide& rival,
+                    BattleResults& results);
+
+}  // namespace pokemongo
+}  // namespace mtm
+
+#endif  // BATTLE_KERNEL_H
@@ -0,0 +1,223 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "event_log.h"
+#include "exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const char MAGIC[] = {'P', 'G', 'E', 'L'};
+static const int WRITER_IDLE_MICROSECONDS = 100;
+// -------------------------------------------------------------------------- //
+//                             AUX FUNCTIONS                                  //
+// -------------------------------------------------------------------------- //
+namespace {
+    void readRecord(istream& input, Event& event) {
+        if (!input.read((char*)&event, sizeof(Event))) {
+            throw EventLogInvalidFileException();
+        }
+    }
+
+    // Returns the number of bytes left in a stream, or -1 if the stream
+    // cannot tell.
+    streamoff bytesLeft(istream& input) {
+        streampos position = input.tellg();
+        if (position == streampos(-1) || !input.seekg(0, ios::end)) {
+            input.clear();
+            return -1;
+        }
+        streamoff left = input.tellg() - position;
+        input.seekg(position);
+        return left;
+    }
+
+    void readName(istream& input, const Event& record,
+                  vector<string>& names) {
+        if (record.trainer != names.size()) {
+            throw EventLogInvalidFileException();
+        }
+        // The length comes from the file, so it is checked against the bytes
+        // which are there before anything is allocated for it. The name is
+        // grown by the records actually read where the stream cannot tell.
+        streamoff left = bytesLeft(input);
+        if (left != -1 && (uint64_t)record.location > (uint64_t)left) {
+            throw EventLogInvalidFileException();
+        }
+        string name;
+        Event payload;
+        for (size_t i = 0; i < record.location; i += sizeof(Event)) {
+            readRecord(input, payload);
+            name.append((const char*)&payload,
+                        min(sizeof(Event), record.location - i));
+        }
+        names.push_back(name);
+    }
+}
+// -------------------------------------------------------------------------- //
+//                                EVENT RING                                  //
+// -------------------------------------------------------------------------- //
+EventRing::EventRing(size_t capacity) : head_(0), tail_(0) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    this->events_.resize(size);
+    this->mask_ = size - 1;
+}
+//------------------------------------------------------------------------------
+bool EventRing::TryPush(const Event& event) {
+    size_t head = head_.load(memory_order_relaxed);
+    if (head - tail_.load(memory_order_acquire) == events_.size()) {
+        return false;
+    }
+    events_[head & mask_] = event;
+    head_.store(head + 1, memory_order_release);
+    return true;
+}
+//------------------------------------------------------------------------------
+size_t EventRing::Drain(std::vector<Event>& events) {
+    size_t tail = tail_.load(memory_order_relaxed);
+    size_t head = head_.load(memory_order_acquire);
+    for (size_t i = tail; i != head; ++i) {
+        events.push_back(events_[i & mask_]);
+    }
+    tail_.store(head, memory_order_release);
+    return head - tail;
+}
+// -------------------------------------------------------------------------- //
+//                                 EVENT LOG                                  //
+// -------------------------------------------------------------------------- //
+EventLog::EventLog(std::ostream& output, size_t capacity) :
+        output_(output), ring_(capacity), closing_(false) {
+    uint32_t version = VERSION;
+    output_.write(MAGIC, sizeof(MAGIC));
+    output_.write((const char*)&version, sizeof(version));
+    writer_ = thread(&EventLog::Write, this);
+}
+//------------------------------------------------------------------------------
+EventLog::~EventLog() {
+    Close();
+}
+//------------------------------------------------------------------------------
+void EventLog::LogAddTrainer(const std::string& name, const Team& team,
+                             const std::string& location) {
+    Event event = {EVENT_ADD_TRAINER, (uint8_t)team, 0, 0,
+                   Intern(trainer_ids_, EVENT_TRAINER_NAME, name),
+                   Intern(location_ids_, EVENT_LOCATION_NAME, location)};
+    Push(event);
+}
+//------------------------------------------------------------------------------
+void EventLog::LogMoveTrainer(const std::string& name, int dir,
+                              const std::string& location) {
+    Event event = {EVENT_MOVE_TRAINER, 0, (uint8_t)dir, 0,
+                   Intern(trainer_ids_, EVENT_TRAINER_NAME, name),
+                   Intern(location_ids_, EVENT_LOCATION_NAME, location)};
+    Push(event);
+}
+//------------------------------------------------------------------------------
+void EventLog::Close() {
+    if (!writer_.joinable()) {
+        return;
+    }
+    closing_.store(true, memory_order_release);
+    writer_.join();
+    output_.flush();
+}
+//------------------------------------------------------------------------------
+void EventLog::Push(const Event& event) {
+    if (!writer_.joinable()) {
+        return;
+    }
+    while (!ring_.TryPush(event)) {
+        this_thread::yield();
+    }
+}
+//------------------------------------------------------------------------------
+uint32_t EventLog::Intern(std::unordered_map<std::string,uint32_t>& ids,
+                          EventType name_type, const std::string& name) {
+    unordered_map<string,uint32_t>::const_iterator it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    uint32_t id = (uint32_t)ids.size();
+    ids.insert({name, id});
+    Event record = {(uint8_t)name_type, 0, 0, 0, id, (uint32_t)name.size()};
+    Push(record);
+    for (size_t i = 0; i < name.size(); i += sizeof(Event)) {
+        Event payload = {0, 0, 0, 0, 0, 0};
+        memcpy(&payload, name.data() + i, min(sizeof(Event), name.size() - i));
+        Push(payload);
+    }
+    return id;
+}
+//------------------------------------------------------------------------------
+void EventLog::Write() {
+    vector<Event> events;
+    bool closing;
+    do {
+        // Every event is pushed before closing_ is set, so the events are all
+        // drained by the time a drain that started after closing finds none.
+        closing = closing_.load(memory_order_acquire);
+        events.clear();
+        if (ring_.Drain(events) != 0) {
+            output_.write((const char*)events.data(),
+                          events.size() * sizeof(Event));
+        } else if (!closing) {
+            this_thread::sleep_for(
+                    chrono::microseconds(WRITER_IDLE_MICROSECONDS));
+        }
+    } while (!closing || !events.empty());
+}
+// -------------------------------------------------------------------------- //
+//                                EVENT READER                                //
+// -------------------------------------------------------------------------- //
+EventReader::EventReader(std::istream& input) {
+    char magic[sizeof(MAGIC)];
+    uint32_t version;
+    if (!input.read(magic, sizeof(magic)) ||
+        !input.read((char*)&version, sizeof(version)) ||
+        !equal(magic, magic + sizeof(magic), MAGIC) ||
+        version != EventLog::VERSION) {
+        throw EventLogInvalidFileException();
+    }
+    Event event;
+    while (input.peek() != EOF) {
+        readRecord(input, event);
+        switch (event.type) {
+            case EVENT_TRAINER_NAME:
+                readName(input, event, trainer_names_);
+                break;
+            case EVENT_LOCATION_NAME:
+                readName(input, event, location_names_);
+                break;
+            case EVENT_ADD_TRAINER:
+            case EVENT_MOVE_TRAINER:
+                if (event.trainer >= trainer_names_.size() ||
+                    event.location >= location_names_.size() ||
+                    (event.type == EVENT_ADD_TRAINER && event.team > RED)) {
+                    throw EventLogInvalidFileException();
+                }
+                events_.push_back(event);
+                break;
+            default:
+                throw EventLogInvalidFileException();
+        }
+    }
+}
+//------------------------------------------------------------------------------
+const vector<Event>& EventReader::Events() const {
+    return events_;
+}
+//------------------------------------------------------------------------------
+const vector<string>& EventReader::TrainerNames() const {
+    return trainer_names_;
+}
+//------------------------------------------------------------------------------
+const vector<string>& EventReader::LocationNames() const {
+    return location_names_;
+}
+//------------------------------------------------------------------------------
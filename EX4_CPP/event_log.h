@@ -0,0 +1,144 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "trainer.h"
+
+namespace mtm {
+namespace pokemongo {
+
+// Types of the records of an event log.
+typedef enum {
+  // A trainer was added to the game at a location.
+  EVENT_ADD_TRAINER,
+  // A trainer moved in a direction to a location.
+  EVENT_MOVE_TRAINER,
+  // Introduces the name of a trainer / location id. The name follows the
+  // record, in ceil(length / sizeof(Event)) records padded with zeros.
+  EVENT_TRAINER_NAME,
+  EVENT_LOCATION_NAME,
+} EventType;
+
+// A fixed-size record of an event log. Trainers and locations are referred to
+// by ids, interned in the order they first appear in the log. Name records
+// use trainer for the named id and location for the length of the name.
+struct Event {
+  uint8_t type;
+  uint8_t team;
+  uint8_t direction;
+  uint8_t reserved;
+  uint32_t trainer;
+  uint32_t location;
+};
+
+// A lock-free ring of events for a single producer thread and a single
+// consumer thread.
+class EventRing {
+ public:
+  // @param capacity the maximal number of events in the ring. Rounded up to a
+  //        power of two.
+  explicit EventRing(size_t capacity);
+
+  // Adds an event to the ring. Called only by the producer.
+  //
+  // @return false if the ring is full, true otherwise.
+  bool TryPush(const Event& event);
+
+  // Moves all the events in the ring to the end of events. Called only by
+  // the consumer.
+  //
+  // @return the number of events moved.
+  size_t Drain(std::vector<Event>& events);
+
+ private:
+  std::vector<Event> events_;
+  size_t mask_;
+  // Positions of the next event to push / pop. Only the producer writes
+  // head_ and only the consumer writes tail_.
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+};
+
+// An append-only binary log of the changes to the state of a PokemonGo game.
+// The game thread appends events to a ring, and a writer thread owned by the
+// log writes them to the output stream.
+//
+// The file is a header ("PGEL" and the format version, 4 bytes each) followed
+// by Event records, in the byte order of the machine that wrote it.
+class EventLog {
+ public:
+  static const uint32_t VERSION = 1;
+
+  // @param output the stream the log is written to. Must outlive the log.
+  // @param capacity the number of events buffered before the game thread
+  //        waits for the writer thread.
+  explicit EventLog(std::ostream& output, size_t capacity = 1 << 16);
+
+  // Closes the log.
+  ~EventLog();
+
+  EventLog(const EventLog&) = delete;
+  EventLog& operator=(const EventLog&) = delete;
+
+  // Appends an event. Called only from a single thread.
+  //
+  // @param name the name of the trainer.
+  // @param team the team of an added trainer.
+  // @param dir the direction in which a trainer moved.
+  // @param location the location where the trainer is after the event.
+  void LogAddTrainer(const std::string& name, const Team& team,
+                     const std::string& location);
+  void LogMoveTrainer(const std::string& name, int dir,
+                      const std::string& location);
+
+  // Writes all the appended events, stops the writer thread and flushes the
+  // output stream. Events appended after Close are ignored.
+  void Close();
+
+ private:
+  std::ostream& output_;
+  EventRing ring_;
+  std::unordered_map<std::string,uint32_t> trainer_ids_;
+  std::unordered_map<std::string,uint32_t> location_ids_;
+  std::atomic<bool> closing_;
+  std::thread writer_;
+
+  void Push(const Event& event);
+  uint32_t Intern(std::unordered_map<std::string,uint32_t>& ids,
+                  EventType name_type, const std::string& name);
+  void Write();
+};
+
+// An event log read back into memory.
+class EventReader {
+ public:
+  // Reads a whole log.
+  //
+  // @param input the stream the log was written to.
+  // @throw EventLogInvalidFileException if the stream does not hold a log of
+  //        this version, the log is truncated, or an event refers to a name
+  //        the log did not introduce or to a team which does not exist.
+  explicit EventReader(std::istream& input);
+
+  // Returns the EVENT_ADD_TRAINER and EVENT_MOVE_TRAINER events of the log in
+  // the order they were logged. The ids in the events index the names below.
+  const std::vector<Event>& Events() const;
+  const std::vector<std::string>& TrainerNames() const;
+  const std::vector<std::string>& LocationNames() const;
+
+ private:
+  std::vector<Event> events_;
+  std::vector<std::string> trainer_names_;
+  std::vector<std::string> location_names_;
+};
+
+}  // namespace pokemongo
+}  // namespace mtm
+
+#endif  // EVENT_LOG_H
@@ -40,6 +40,18 @@ namespace pokemongo {
   class PokemonGoInvalidArgsException : public PokemonGoException {};
   class PokemonGoReachedDeadEndException : public PokemonGoException {};
   class PokemonGoTrainerNotFoundExcpetion : public PokemonGoException {};
+  class PokemonGoGymNotFoundException : public PokemonGoException {};
+
+	class SimulatorException : public MtmException {};
+  class SimulatorInvalidArgsException : public SimulatorException {};
+  class SimulatorLocationNotFoundException : public SimulatorException {};
+
+	class EventLogException : public MtmException {};
+  class EventLogInvalidFileException : public EventLogException {};
+
+	class SnapshotException : public MtmException {};
+  class SnapshotIOException : public SnapshotException {};
+  class SnapshotInvalidFileException : public SnapshotException {};
 
 }  //  namespace pokemongo
 }  //  namespace mtm
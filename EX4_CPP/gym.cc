@@ -2,60 +2,98 @@
 //                             INCLUDES & DEFINES                             //
 // -------------------------------------------------------------------------- //
 #include "gym.h"
+#include "instrumentation.h"
 
 using namespace mtm::pokemongo;
 using namespace std;
 
-typedef vector<Trainer*>::const_iterator Vec_Iterator;
-
-#define VEC_FOREACH(vec_type,itr,vec_name) \
-        for (vector<vec_type>::iterator itr = vec_name.begin(); \
-             itr!=vec_name.end() ; ++itr)
+// The strength of a trainer without Pokemons, weaker than any Pokemon.
+static const double NO_POKEMONS_STRENGTH = -1;
 
 // -------------------------------------------------------------------------- //
 //                                FUNCTIONS                                   //
 // -------------------------------------------------------------------------- //
 void Gym::SetNewGymLeader(Trainer* trainer) {
+    POKEMONGO_COUNT(COUNTER_LEADER_CHANGES);
     this->is_taken = true;
     trainer->SetAsGymLeader();
     this->gym_team_color = trainer->GetTeam();
     this->gym_leader = trainer;
 }
 //------------------------------------------------------------------------------
+namespace {
+    double trainerStrength(const Trainer& trainer) {
+        return trainer.HasPokemons() ? trainer.GetStrongestPokemon().HitPower()
+                                     : NO_POKEMONS_STRENGTH;
+    }
+}
+//------------------------------------------------------------------------------
+void Gym::AddToIndex(Trainer& trainer) {
+    LeaderKey key = {trainerStrength(trainer), arrivals++, &trainer};
+    team_index[trainer.GetTeam()].insert(key);
+    index_keys[&trainer] = key;
+}
+//------------------------------------------------------------------------------
+void Gym::RemoveFromIndex(const Trainer& trainer) {
+    std::unordered_map<const Trainer*,LeaderKey>::iterator it =
+            index_keys.find(&trainer);
+    if (it == index_keys.end()) {
+        return;
+    }
+    team_index[trainer.GetTeam()].erase(it->second);
+    index_keys.erase(it);
+}
+//------------------------------------------------------------------------------
+void Gym::UpdateIndex(Trainer& trainer) {
+    std::unordered_map<const Trainer*,LeaderKey>::iterator it =
+            index_keys.find(&trainer);
+    if (it == index_keys.end()) {
+        return;
+    }
+    LeaderKey& key = it->second;
+    team_index[trainer.GetTeam()].erase(key);
+    key.strength = trainerStrength(trainer);
+    team_index[trainer.GetTeam()].insert(key);
+}
+//------------------------------------------------------------------------------
 bool Gym::SameTeamTrainerExist(const Trainer& trainer) {
-    int same_team_trainers = 0;
-    VEC_FOREACH(Trainer*,vec_itr,trainers_) {
-         Trainer& current_trainer = **vec_itr;
-         if (current_trainer.GetTeam() == trainer.GetTeam() && current_trainer!= trainer){
-             same_team_trainers++;
-         }
+    size_t same_team_trainers = team_index[trainer.GetTeam()].size();
+    if (index_keys.count(&trainer) != 0) {
+        same_team_trainers--;
     }
     return same_team_trainers != 0;
 }
 //------------------------------------------------------------------------------
 void Gym::ReplaceGymLeader(const Trainer &trainer) {
-    bool same_team_trainers = SameTeamTrainerExist(trainer);
-    Trainer *strongest_trainer = trainers_.front();
-    VEC_FOREACH(Trainer*, vec_itr, trainers_) {
-        Trainer &current_trainer = **vec_itr;
-        if (same_team_trainers) {
-            if ((current_trainer > *strongest_trainer) &&
-                (current_trainer.GetTeam() == trainer.GetTeam())) {
-                *strongest_trainer = current_trainer;
-            }
-        } else {
-            *strongest_trainer = current_trainer;
+    const std::set<LeaderKey,StrongerFirst>& same_team =
+            team_index[trainer.GetTeam()];
+    if (!same_team.empty()) {
+        SetNewGymLeader(same_team.begin()->trainer);
+        return;
+    }
+    const LeaderKey* strongest = nullptr;
+    StrongerFirst stronger_first;
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        if (team_index[team].empty()) continue;
+        const LeaderKey& candidate = *team_index[team].begin();
+        if (strongest == nullptr || stronger_first(candidate, *strongest)) {
+            strongest = &candidate;
         }
     }
-    SetNewGymLeader(strongest_trainer);
+    if (strongest != nullptr) {
+        SetNewGymLeader(strongest->trainer);
+    }
 }
 //------------------------------------------------------------------------------
 void Gym::Arrive(Trainer& trainer) {
+    POKEMONGO_TIME(OPERATION_GYM_ARRIVE);
     if (trainers_.empty()) {
         SetNewGymLeader(&trainer);
     } else {
         if (trainer.GetTeam() != gym_leader->GetTeam()) {
+            POKEMONGO_COUNT(COUNTER_BATTLES);
             gym_leader->Battle(trainer);
+            UpdateIndex(*gym_leader);
             if (trainer.HasWonLastBattle()) {
                 gym_leader->UnsetAsGymLeader();
                 SetNewGymLeader(&trainer);
@@ -63,17 +101,24 @@ void Gym::Arrive(Trainer& trainer) {
         }
     }
     Location::Arrive(trainer);
+    AddToIndex(trainer);
 }
 //------------------------------------------------------------------------------
 void Gym::Leave(Trainer& trainer) {
-    if (is_taken == true) {
-        if (gym_leader == &trainer && trainers_.size() == 1) {
+    POKEMONGO_TIME(OPERATION_GYM_LEAVE);
+    Location::Leave(trainer);
+    RemoveFromIndex(trainer);
+    if (is_taken == true && gym_leader == &trainer) {
+        trainer.UnsetAsGymLeader();
+        if (trainers_.empty()) {
             is_taken = false;
-        }
-        if (gym_leader == &trainer && trainers_.size() > 1) {
+        } else {
             ReplaceGymLeader(trainer);
         }
     }
-    Location::Leave(trainer);
+}
+//------------------------------------------------------------------------------
+const Trainer* Gym::GetLeader() const {
+    return is_taken ? gym_leader : nullptr;
 }
 //------------------------------------------------------------------------------
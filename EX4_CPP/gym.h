@@ -2,6 +2,8 @@
 #define GYM_H
 
 #include <iostream>
+#include <set>
+#include <unordered_map>
 #include "location.h"
 #include "trainer.h"
 
@@ -10,14 +12,54 @@ namespace mtm {
         class Gym : public Location {
 
         private:
+            // Key of a trainer in the leader index: the hit power of its
+            // strongest Pokemon and the order in which it arrived.
+            struct LeaderKey {
+                double strength;
+                unsigned long long arrival;
+                Trainer* trainer;
+            };
+
+            // Orders trainers from the strongest to the weakest. Trainers of
+            // equal strength are ordered by arrival, earliest first.
+            struct StrongerFirst {
+                bool operator()(const LeaderKey& lhs,
+                                const LeaderKey& rhs) const {
+                    if (lhs.strength != rhs.strength) {
+                        return lhs.strength > rhs.strength;
+                    }
+                    return lhs.arrival < rhs.arrival;
+                }
+            };
+
+            static const int TEAMS_NUM = RED + 1;
+
             const std::string name;
             Team gym_team_color;
             Trainer* gym_leader;
             bool is_taken;
+            // The trainers in the gym, one index per team, and the key of
+            // every trainer in its team index.
+            std::set<LeaderKey,StrongerFirst> team_index[TEAMS_NUM];
+            std::unordered_map<const Trainer*,LeaderKey> index_keys;
+            unsigned long long arrivals = 0;
+
+            void AddToIndex(Trainer& trainer);
+            void RemoveFromIndex(const Trainer& trainer);
+            void UpdateIndex(Trainer& trainer);
 
         public:
-            Gym() {}
-            Gym(const std::string& name): name(name), gym_leader(NULL), is_taken(false) {}
+            // Saves and restores the state of the location.
+            friend class SnapshotFile;
+            // Copies the location on write and points it at copied trainers.
+            friend class PokemonGoFork;
+
+            // The team color of a gym is meaningful only while it is taken.
+            Gym(): Location(GYM), gym_team_color(BLUE), gym_leader(NULL), is_taken(false) {}
+            Gym(const std::string& name): Location(GYM), name(name), gym_team_color(BLUE), gym_leader(NULL), is_taken(false) {}
+            // Copies the state of the gym, pointing at the same trainers.
+            // World::CopyOf uses it.
+            Gym(const Gym& gym) = default;
             ~Gym() {}
             Gym &operator=(const Gym &gym);
             bool SameTeamTrainerExist(const Trainer& trainer);
@@ -25,6 +67,9 @@ namespace mtm {
             void ReplaceGymLeader(const Trainer& trainer);
             void Arrive(Trainer& trainer) override;
             void Leave(Trainer& trainer) override;
+
+            // Returns the leader of the gym, or nullptr if the gym is empty.
+            const Trainer* GetLeader() const;
             };
     }  // namespace pokemongo
 }  // namespace mtm
@@ -0,0 +1,319 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "instrumentation.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static const char* OPERATION_NAMES[] = {
+        "add_trainer", "move_trainer", "gym_arrive", "gym_leave",
+        "pokestop_arrive", "pokestop_leave", "starbucks_arrive",
+        "starbucks_leave"};
+static const char* COUNTER_NAMES[] = {
+        "battles", "leader_changes", "pokemons_caught", "items_picked",
+        "dead_ends"};
+static const double P50 = 0.5;
+static const double P90 = 0.9;
+static const double P99 = 0.99;
+
+const bool Instrumentation::ENABLED;
+const int Instrumentation::SAMPLE_PERIOD;
+// -------------------------------------------------------------------------- //
+//                             AUX FUNCTIONS                                  //
+// -------------------------------------------------------------------------- //
+namespace {
+    // A latency of v ticks falls in bucket v if v < SUB_BUCKETS. Otherwise,
+    // if 2^e <= v < 2^(e+1), it falls in one of SUB_BUCKETS buckets of equal
+    // width splitting [2^e, 2^(e+1)).
+    const int SUB_BUCKET_BITS = 4;
+    const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    const int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+#ifdef POKEMONGO_INSTRUMENTATION
+    int bucketOf(uint64_t ticks) {
+        if (ticks < (uint64_t)SUB_BUCKETS) {
+            return (int)ticks;
+        }
+        int exponent = 63 - __builtin_clzll(ticks);
+        int shift = exponent - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKETS +
+               (int)((ticks >> shift) & (SUB_BUCKETS - 1));
+    }
+#endif
+
+    // Returns the middle of the range of latencies of a bucket.
+    double bucketMiddle(int bucket) {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        int shift = bucket / SUB_BUCKETS - 1;
+        uint64_t lowest = (uint64_t)(SUB_BUCKETS + bucket % SUB_BUCKETS)
+                          << shift;
+        return lowest + (((uint64_t)1 << shift) - 1) / 2.0;
+    }
+
+    // A counter written by a single thread. Writes are plain loads and
+    // stores, so they cost no more than on a plain integer, and other threads
+    // may read the counter at any time.
+    class ThreadCounter {
+    public:
+        void Add(uint64_t value) {
+            this->value.store(this->value.load(memory_order_relaxed) + value,
+                              memory_order_relaxed);
+        }
+        void Max(uint64_t value) {
+            if (value > this->value.load(memory_order_relaxed)) {
+                this->value.store(value, memory_order_relaxed);
+            }
+        }
+        uint64_t Get() const {
+            return value.load(memory_order_relaxed);
+        }
+        void Reset() {
+            value.store(0, memory_order_relaxed);
+        }
+    private:
+        atomic<uint64_t> value{0};
+    };
+
+    struct Histogram {
+        ThreadCounter calls;
+        ThreadCounter buckets[BUCKETS];
+        ThreadCounter sum;
+        ThreadCounter max;
+    };
+
+    struct ThreadStats {
+        ThreadCounter counters[COUNTERS_NUM];
+        Histogram histograms[OPERATIONS_NUM];
+        // The calls of every operation left until the next timed call.
+        // Written by the thread and by Reset.
+        atomic<int> until_sample[OPERATIONS_NUM];
+
+        ThreadStats() {
+            for (atomic<int>& calls : until_sample) {
+                calls.store(Instrumentation::SAMPLE_PERIOD - 1,
+                            memory_order_relaxed);
+            }
+        }
+    };
+
+    // The stats of all the threads that ever recorded. The stats of a thread
+    // are kept after it exits, so its events are still counted.
+    struct Registry {
+        mutex threads_mutex;
+        vector<unique_ptr<ThreadStats>> threads;
+        // The clocks when the registry was created, to convert ticks to
+        // nanoseconds.
+        uint64_t start_ticks = Instrumentation::Ticks();
+        Clock::time_point start_time = Clock::now();
+    };
+
+    Registry& registry() {
+        static Registry registry;
+        return registry;
+    }
+
+#ifdef POKEMONGO_INSTRUMENTATION
+    ThreadStats* registerThread() {
+        Registry& threads = registry();
+        lock_guard<mutex> lock(threads.threads_mutex);
+        threads.threads.push_back(unique_ptr<ThreadStats>(new ThreadStats()));
+        return threads.threads.back().get();
+    }
+
+    ThreadStats& threadStats() {
+        static thread_local ThreadStats* stats = registerThread();
+        return *stats;
+    }
+#endif
+
+    double nanosecondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+        Registry& threads = registry();
+        uint64_t ticks = Instrumentation::Ticks() - threads.start_ticks;
+        chrono::duration<double,nano> elapsed =
+                Clock::now() - threads.start_time;
+        return ticks == 0 ? 1 : elapsed.count() / ticks;
+#else
+        return 1;
+#endif
+    }
+
+    // Returns the latency below which the given fraction of the recorded
+    // latencies lie (nearest rank), in ticks.
+    double percentile(const vector<uint64_t>& buckets, uint64_t count,
+                      double fraction) {
+        uint64_t rank = max((uint64_t)1, (uint64_t)(fraction * count + 0.5));
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += buckets[bucket];
+            if (seen >= rank) {
+                return bucketMiddle(bucket);
+            }
+        }
+        return 0;
+    }
+
+    void printLatency(ostream& output, const LatencyStats& latency,
+                      bool is_json) {
+        const char* separator = is_json ? ", \"" : " ";
+        const char* unit = is_json ? "_ns\": " : "=";
+        output << (is_json ? "{\"count\": " : "count=") << latency.count
+               << separator << (is_json ? "samples\": " : "samples=")
+               << latency.samples
+               << separator << "mean" << unit << latency.mean
+               << separator << "p50" << unit << latency.p50
+               << separator << "p90" << unit << latency.p90
+               << separator << "p99" << unit << latency.p99
+               << separator << "max" << unit << latency.max
+               << (is_json ? "}" : "");
+    }
+}
+// -------------------------------------------------------------------------- //
+//                                FUNCTIONS                                   //
+// -------------------------------------------------------------------------- //
+void Instrumentation::Increment(const Counter& counter) {
+#ifdef POKEMONGO_INSTRUMENTATION
+    threadStats().counters[counter].Add(1);
+#else
+    (void)counter;
+#endif
+}
+//------------------------------------------------------------------------------
+bool Instrumentation::Call(const Operation& operation) {
+#ifdef POKEMONGO_INSTRUMENTATION
+    ThreadStats& stats = threadStats();
+    stats.histograms[operation].calls.Add(1);
+    int until_sample = stats.until_sample[operation].load(memory_order_relaxed);
+    if (until_sample != 0) {
+        stats.until_sample[operation].store(until_sample - 1,
+                                            memory_order_relaxed);
+        return false;
+    }
+    stats.until_sample[operation].store(SAMPLE_PERIOD - 1,
+                                        memory_order_relaxed);
+    return true;
+#else
+    (void)operation;
+    return false;
+#endif
+}
+//------------------------------------------------------------------------------
+void Instrumentation::Record(const Operation& operation, uint64_t ticks) {
+#ifdef POKEMONGO_INSTRUMENTATION
+    Histogram& histogram = threadStats().histograms[operation];
+    histogram.buckets[bucketOf(ticks)].Add(1);
+    histogram.sum.Add(ticks);
+    histogram.max.Max(ticks);
+#else
+    (void)operation;
+    (void)ticks;
+#endif
+}
+//------------------------------------------------------------------------------
+uint64_t Instrumentation::Count(const Counter& counter) {
+    Registry& threads = registry();
+    lock_guard<mutex> lock(threads.threads_mutex);
+    uint64_t count = 0;
+    for (const unique_ptr<ThreadStats>& stats : threads.threads) {
+        count += stats->counters[counter].Get();
+    }
+    return count;
+}
+//------------------------------------------------------------------------------
+LatencyStats Instrumentation::Latency(const Operation& operation) {
+    LatencyStats latency = {0, 0, 0, 0, 0, 0, 0};
+    vector<uint64_t> buckets(BUCKETS, 0);
+    uint64_t sum = 0, max_ticks = 0;
+    {
+        Registry& threads = registry();
+        lock_guard<mutex> lock(threads.threads_mutex);
+        for (const unique_ptr<ThreadStats>& stats : threads.threads) {
+            const Histogram& histogram = stats->histograms[operation];
+            latency.count += histogram.calls.Get();
+            for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+                uint64_t samples = histogram.buckets[bucket].Get();
+                buckets[bucket] += samples;
+                latency.samples += samples;
+            }
+            sum += histogram.sum.Get();
+            max_ticks = max(max_ticks, histogram.max.Get());
+        }
+    }
+    if (latency.samples == 0) {
+        return latency;
+    }
+    double tick = nanosecondsPerTick();
+    latency.mean = tick * sum / latency.samples;
+    latency.p50 = tick * percentile(buckets, latency.samples, P50);
+    latency.p90 = tick * percentile(buckets, latency.samples, P90);
+    latency.p99 = tick * percentile(buckets, latency.samples, P99);
+    latency.max = tick * max_ticks;
+    return latency;
+}
+//------------------------------------------------------------------------------
+void Instrumentation::Reset() {
+    Registry& threads = registry();
+    lock_guard<mutex> lock(threads.threads_mutex);
+    for (const unique_ptr<ThreadStats>& stats : threads.threads) {
+        for (ThreadCounter& counter : stats->counters) {
+            counter.Reset();
+        }
+        for (Histogram& histogram : stats->histograms) {
+            histogram.calls.Reset();
+            for (ThreadCounter& bucket : histogram.buckets) {
+                bucket.Reset();
+            }
+            histogram.sum.Reset();
+            histogram.max.Reset();
+        }
+        for (atomic<int>& calls : stats->until_sample) {
+            calls.store(SAMPLE_PERIOD - 1, memory_order_relaxed);
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void Instrumentation::DumpText(std::ostream& output) {
+    if (!ENABLED) {
+        output << "instrumentation disabled" << endl;
+        return;
+    }
+    for (int counter = 0; counter < COUNTERS_NUM; ++counter) {
+        output << COUNTER_NAMES[counter] << ": "
+               << Count((Counter)counter) << endl;
+    }
+    for (int operation = 0; operation < OPERATIONS_NUM; ++operation) {
+        output << OPERATION_NAMES[operation] << ": ";
+        printLatency(output, Latency((Operation)operation), false);
+        output << " (ns)" << endl;
+    }
+}
+//------------------------------------------------------------------------------
+void Instrumentation::DumpJson(std::ostream& output) {
+    output << "{\"enabled\": " << (ENABLED ? "true" : "false");
+    if (ENABLED) {
+        output << ", \"counters\": {";
+        for (int counter = 0; counter < COUNTERS_NUM; ++counter) {
+            output << (counter == 0 ? "\"" : ", \"") << COUNTER_NAMES[counter]
+                   << "\": " << Count((Counter)counter);
+        }
+        output << "}, \"operations\": {";
+        for (int operation = 0; operation < OPERATIONS_NUM; ++operation) {
+            output << (operation == 0 ? "\"" : ", \"")
+                   << OPERATION_NAMES[operation] << "\": ";
+            printLatency(output, Latency((Operation)operation), true);
+        }
+        output << "}";
+    }
+    output << "}" << endl;
+}
+//------------------------------------------------------------------------------
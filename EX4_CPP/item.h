@@ -8,38 +8,47 @@
 
 namespace mtm {
     namespace pokemongo {
+        // Kinds of items.
+        typedef enum {
+            CANDY,
+            POTION,
+        } ItemType;
+
+        // An item. Items are plain values tagged with their kind, so they are
+        // stored and passed around by value and useItem needs no virtual call.
+        // Candy and Potion only construct an Item of their kind.
         class Item {
 
         protected:
+            ItemType type;
             int level;
 
-        public:
-            Item(const int& level): level(level) {
+            Item(const ItemType& type, const int& level):
+                    type(type), level(level) {
                 if (level < 1) throw ItemInvalidArgsException();
             }
+
+        public:
             Item(const Item& item) = default;
-            virtual ~Item() {};
-            virtual void useItem(Pokemon& pokemon) = 0;
+            Item& operator=(const Item& item) = default;
+            void useItem(Pokemon& pokemon) const {
+                switch (type) {
+                    case CANDY: pokemon.Train(1+pokemon.Level()/10.0); break;
+                    case POTION: pokemon.Heal(); break;
+                }
+            }
+            ItemType Type() const { return type; }
             const int& Level() const { return level; }
-            const int& Level() { return level; }
         };
 
         class Candy: public Item {
         public:
-            Candy(const int& level): Item(level) {}
-            Candy(const Candy& candy) = default;
-            void useItem(Pokemon& pokemon) override {
-                pokemon.Train(1+pokemon.Level()/10.0);
-            }
+            Candy(const int& level): Item(CANDY, level) {}
         };
 
         class Potion: public Item {
         public:
-            Potion(const int& level): Item(level) {}
-            Potion(const Potion& potion) = default;
-            void useItem(Pokemon& pokemon) override {
-                pokemon.Heal();
-            }
+            Potion(const int& level): Item(POTION, level) {}
         };
     }
 }
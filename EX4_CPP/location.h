@@ -10,9 +10,24 @@
 namespace mtm {
 namespace pokemongo {
 
+// Kinds of locations. The kinds are a closed set, so code can tell the kind of
+// a location without a dynamic_cast (see World::CopyOf).
+typedef enum {
+  GYM,
+  POKESTOP,
+  STARBUCKS,
+} LocationKind;
+
 class Location {
  public:
+  explicit Location(const LocationKind& kind) : kind_(kind) {}
   virtual ~Location() {};
+
+  // Returns the kind of the location.
+  LocationKind Kind() const {
+    return kind_;
+  }
+
   virtual void Arrive(Trainer& trainer) {
     if (std::find(trainers_.begin(), trainers_.end(), &trainer) !=
             trainers_.end()) {
@@ -34,8 +49,16 @@ class Location {
     return trainers_;
   }
 
+  // Saves and restores the trainers in locations.
+  friend class SnapshotFile;
+  // Copies the location on write and points it at copied trainers.
+  friend class PokemonGoFork;
+
  protected:
   std::vector<Trainer*> trainers_;
+
+ private:
+  LocationKind kind_;
 };
 
 }  // pokemongo
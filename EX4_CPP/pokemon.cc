@@ -1,6 +1,9 @@
 // -------------------------------------------------------------------------- //
 //                             INCLUDES & DEFINES                             //
 // -------------------------------------------------------------------------- //
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include "pokemon.h"
 
 using namespace mtm::pokemongo;
@@ -8,20 +11,130 @@ using namespace std;
 
 static const int MAX_HP = 100;
 static const int NO_HP = 0;
+static const int TYPES_NUM = PSYCHIC + 1;
 
 #define SET_FOREACH(set_type,itr,set_name) \
-        for (set<set_type>::iterator itr = set_name.begin(); \
+        for (set<set_type>::const_iterator itr = set_name.begin(); \
              itr!=set_name.end() ; ++itr)
 // -------------------------------------------------------------------------- //
 //                             AUX FUNCTIONS                                  //
 // -------------------------------------------------------------------------- //
-double Pokemon::calcTypesValue(const Pokemon& pokemon) {
-    double sum = 0;
-    SET_FOREACH(PokemonType,type_iterator,pokemon.types) {
-        sum += *type_iterator;
+namespace {
+    const int32_t SPECIES_HASH_SEED = 7;
+    const int32_t SPECIES_HASH_MULTIPLIER = 31;
+
+    // A species has the type i by default iff the hash of its name modulo
+    // TYPE_MODULI[i] is one of i, i+1, i+2 or i+3 (modulo TYPE_MODULI[i]); a
+    // negative remainder gives no types.
+    // The types are grouped by modulus, so RESIDUE_MASKS[m][r] holds the mask
+    // of the types a species gets when its hash modulo DEFAULT_MODULI[m] is r.
+    constexpr int TYPE_MODULI[] = {5, 7, 7, 11, 11, 17, 17, 17, 17,
+                                   19, 19, 19, 19, 19};
+    constexpr int DEFAULT_MODULI[] = {5, 7, 11, 17, 19};
+    const int MODULI_NUM = sizeof(DEFAULT_MODULI) / sizeof(*DEFAULT_MODULI);
+    const int MAX_MODULUS = 19;
+
+    constexpr bool hasDefaultType(int type, int modulus, int residue) {
+        return TYPE_MODULI[type] == modulus && residue < modulus &&
+               (residue == type % modulus || residue == (type + 1) % modulus ||
+                residue == (type + 2) % modulus ||
+                residue == (type + 3) % modulus);
+    }
+    constexpr uint16_t residueMask(int modulus, int residue, int type = 0) {
+        return type > PSYCHIC ? 0 :
+               (uint16_t)((hasDefaultType(type, modulus, residue) ?
+                           1 << type : 0) |
+                          residueMask(modulus, residue, type + 1));
+    }
+
+#define RESIDUE_MASKS_OF(m) { \
+        residueMask(m,0),  residueMask(m,1),  residueMask(m,2), \
+        residueMask(m,3),  residueMask(m,4),  residueMask(m,5), \
+        residueMask(m,6),  residueMask(m,7),  residueMask(m,8), \
+        residueMask(m,9),  residueMask(m,10), residueMask(m,11), \
+        residueMask(m,12), residueMask(m,13), residueMask(m,14), \
+        residueMask(m,15), residueMask(m,16), residueMask(m,17), \
+        residueMask(m,18) }
+
+    constexpr uint16_t RESIDUE_MASKS[MODULI_NUM][MAX_MODULUS] = {
+        RESIDUE_MASKS_OF(5), RESIDUE_MASKS_OF(7), RESIDUE_MASKS_OF(11),
+        RESIDUE_MASKS_OF(17), RESIDUE_MASKS_OF(19)
+    };
+
+#undef RESIDUE_MASKS_OF
+
+    // Hashes a species name. The arithmetic is done on unsigned integers so
+    // overflow wraps around instead of being undefined.
+    int32_t speciesHash(const string& species) {
+        uint32_t hash = SPECIES_HASH_SEED;
+        for (string::const_iterator it = species.begin();
+             it != species.end(); ++it) {
+            hash = hash * SPECIES_HASH_MULTIPLIER + (uint32_t)(signed char)*it;
+        }
+        return (int32_t)hash;
+    }
+
+    // The table of interned species names, shared by the Pokemons of all
+    // threads. Names are kept in a deque so references to them stay valid
+    // while new species are interned. The mutex guards both containers.
+    struct SpeciesTable {
+        mutex lock;
+        deque<string> names;
+        unordered_map<string,uint32_t> ids;
+    };
+    SpeciesTable& speciesTable() {
+        static SpeciesTable table;
+        return table;
+    }
+    uint32_t internSpecies(const string& species) {
+        SpeciesTable& table = speciesTable();
+        lock_guard<mutex> guard(table.lock);
+        unordered_map<string,uint32_t>::const_iterator it =
+                table.ids.find(species);
+        if (it != table.ids.end()) {
+            return it->second;
+        }
+        uint32_t id = (uint32_t)table.names.size();
+        table.names.push_back(species);
+        table.ids.insert({species,id});
+        return id;
+    }
+}
+//------------------------------------------------------------------------------
+uint16_t Pokemon::typesToMask(const std::set<PokemonType>& types) {
+    uint16_t mask = 0;
+    SET_FOREACH(PokemonType,type_iterator,types) {
+        mask |= (uint16_t)(1 << *type_iterator);
+    }
+    return mask;
+}
+//------------------------------------------------------------------------------
+uint16_t Pokemon::calcTypesValue(uint16_t types) {
+    uint16_t sum = 0;
+    for (int type = 0; type < TYPES_NUM; ++type) {
+        if (types & (1 << type)) sum += type;
     }
     return sum;
 }
+//------------------------------------------------------------------------------
+uint16_t Pokemon::getDefaultTypesMask(const std::string& species) {
+    int32_t hash = speciesHash(species);
+    uint16_t mask = 0;
+    for (int i = 0; i < MODULI_NUM; ++i) {
+        int32_t residue = hash % DEFAULT_MODULI[i];
+        if (residue >= 0) mask |= RESIDUE_MASKS[i][residue];
+    }
+    return mask;
+}
+//------------------------------------------------------------------------------
+std::set<PokemonType> Pokemon::GetDefaultTypes(const std::string& species) {
+    uint16_t mask = getDefaultTypesMask(species);
+    std::set<PokemonType> types;
+    for (int type = 0; type < TYPES_NUM; ++type) {
+        if (mask & (1 << type)) types.insert((PokemonType)type);
+    }
+    return types;
+}
 // -------------------------------------------------------------------------- //
 //                             CONSTRUCTORS                                   //
 // -------------------------------------------------------------------------- //
@@ -31,8 +144,9 @@ Pokemon::Pokemon(const std::string& species,
     if (species.empty() || cp < 0 || level <= 0) {
         throw PokemonInvalidArgsException();
     }
-    this->species = species;
-    this->types = types;
+    this->species_id = internSpecies(species);
+    this->types = typesToMask(types);
+    this->types_value = calcTypesValue(this->types);
     this->cp = cp;
     this->hp = MAX_HP;
     this->level = level;
@@ -44,22 +158,14 @@ Pokemon::Pokemon(const std::string& species, const double& cp,
     if (species.empty() || cp < 0 || level <= 0) {
         throw PokemonInvalidArgsException();
     }
-    this->species = species;
+    this->species_id = internSpecies(species);
     this->cp = cp;
     this->hp = MAX_HP;
     this->level = level;
-    this->types = GetDefaultTypes(species);
+    this->types = getDefaultTypesMask(species);
+    this->types_value = calcTypesValue(this->types);
     this->hit_power = cp*level;
 }
-//------------------------------------------------------------------------------
-Pokemon::Pokemon(const Pokemon& pokemon) {
-    this->species = pokemon.species;
-    this->level = pokemon.level;
-    this->cp = pokemon.cp;
-    this->hp = pokemon.hp;
-    this->types = pokemon.types;
-    this->hit_power = pokemon.hit_power;
-}
 // -------------------------------------------------------------------------- //
 //                                FUNCTIONS                                   //
 // -------------------------------------------------------------------------- //
@@ -82,32 +188,9 @@ bool Pokemon::Hit(Pokemon& victim) {
 // -------------------------------------------------------------------------- //
 //                                OPERATORS                                   //
 // -------------------------------------------------------------------------- //
-Pokemon& Pokemon::operator=(const Pokemon& pokemon) {
-    int new_level = pokemon.level;
-    double new_hp = pokemon.hp;
-    double new_cp = pokemon.cp;
-
-    if (this == &pokemon) { // Self check
-        return *this;
-    }
-
-    // Clear old data
-    this->types.clear();
-    this->species.clear();
-
-    // Hard copy of data
-    this->species = pokemon.species;
-    this->types = pokemon.types;
-    this->hp = new_hp;
-    this->cp = new_cp;
-    this->level = new_level;
-    this->hit_power = new_hp*new_level;
-    return *this;
-}
-//------------------------------------------------------------------------------
 bool Pokemon::operator==(const Pokemon& rhs) const {
     if (this->hit_power == rhs.hit_power ) {
-        if (calcTypesValue(*this) == calcTypesValue(rhs)) {
+        if (this->types_value == rhs.types_value) {
             return true;
         }
     }
@@ -135,11 +218,12 @@ bool Pokemon::operator>=(const Pokemon& rhs) const {
 }
 //------------------------------------------------------------------------------
 ostream& mtm::pokemongo::operator<<(ostream& output, const Pokemon& pokemon) {
-    output << pokemon.species << "(" << pokemon.level << "/"
+    output << pokemon.Species() << "(" << pokemon.level << "/"
            << pokemon.cp << "/" << pokemon.hp << ")";
-    SET_FOREACH (PokemonType,iterator,pokemon.types) {
+    for (int type = 0; type < TYPES_NUM; ++type) {
+        if (!(pokemon.types & (1 << type))) continue;
         output << " ";
-        switch (*iterator) {
+        switch ((PokemonType)type) {
             case NORMAL:   output << "NORMAL"; break;
             case ROCK:     output << "ROCK"; break;
             case BUG:      output << "BUG"; break;
@@ -159,7 +243,17 @@ ostream& mtm::pokemongo::operator<<(ostream& output, const Pokemon& pokemon) {
     return output;
 }
 //------------------------------------------------------------------------------
+const string& Pokemon::Species() const {
+    SpeciesTable& table = speciesTable();
+    lock_guard<mutex> guard(table.lock);
+    return table.names[species_id];
+}
+//------------------------------------------------------------------------------
 int Pokemon::Level() const {
     return level;
 }
+//------------------------------------------------------------------------------
+double Pokemon::HitPower() const {
+    return hit_power;
+}
 //------------------------------------------------------------------------------
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef POKEMON_H
 #define POKEMON_H
 
+#include <cstdint>
 #include <iostream>
 #include <set>
 #include <string>
@@ -9,6 +10,8 @@
 namespace mtm {
 namespace pokemongo {
 
+class SnapshotFile;
+
 // Possible Pokemon types.
 typedef enum {
   NORMAL = 0,
@@ -27,16 +30,22 @@ typedef enum {
   PSYCHIC = 13,
 } PokemonType;
 
+// Pokemons are trivially copyable: the species is kept as an id into a table
+// of interned species names shared by all Pokemons, and the types are kept as
+// a bitmask in which bit i is set iff the Pokemon has the type i.
 class Pokemon {
  private:
-  std::string species;
-  std::set<PokemonType> types;
+  uint32_t species_id;
+  uint16_t types;
+  uint16_t types_value;
   int level;
   double hp;
   double cp;
   double hit_power;
 
-  static double calcTypesValue(const Pokemon& pokemon);
+  static uint16_t typesToMask(const std::set<PokemonType>& types);
+  static uint16_t calcTypesValue(uint16_t types);
+  static uint16_t getDefaultTypesMask(const std::string& species);
 //------------------------------------------------------------------------------
  public:
   // Computes the default set of Pokemon types for a given species of Pokemons.
@@ -71,12 +80,12 @@ class Pokemon {
   // Copy constructor.
   //
   // @param pokemon the pokemon to copy.
-  Pokemon(const Pokemon& pokemon);
+  Pokemon(const Pokemon& pokemon) = default;
 
   // Assignment operator.
   //
   // @param pokemon assignee.
-  Pokemon& operator=(const Pokemon& pokemon);
+  Pokemon& operator=(const Pokemon& pokemon) = default;
 
   // Comparison operators for Pokemons. Pokemons are compared as described in
   // the exercise sheet.
@@ -103,11 +112,24 @@ class Pokemon {
   // @return the output stream to which the data is printed.
   friend std::ostream& operator<<(std::ostream& output, const Pokemon& pokemon);
 
+  // Saves and restores the fields of Pokemons.
+  friend class SnapshotFile;
+
+  // Returns the species of the Pokemon.
+  //
+  // @return the species of the Pokemon.
+  const std::string& Species() const;
+
   // Returns the level of the Pokemon.
   //
   // @return the level of the Pokemon.
   int Level() const;
 
+  // Returns the hit power of the Pokemon.
+  //
+  // @return the hit power of the Pokemon.
+  double HitPower() const;
+
   // "Hits" the given Pokemon by reducing its HP value by the hit power of this
   // Pokemon.
   //
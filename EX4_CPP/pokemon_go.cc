@@ -3,12 +3,13 @@
 // -------------------------------------------------------------------------- //
 #include <fstream>
 #include <list>
+#include "instrumentation.h"
 #include "pokemon_go.h"
+#include "snapshot.h"
 
 using namespace mtm::pokemongo;
 using namespace std;
 
-static const int LEADER_BONUS = 10;
 typedef map<string,Trainer>::iterator Trainers_Itr;
 typedef mtm::KGraph<std::string,Location*,4>::const_iterator World_Itr;
 // -------------------------------------------------------------------------- //
@@ -18,6 +19,7 @@ PokemonGo::PokemonGo(const World* world): world_ptr(world) {}
 //------------------------------------------------------------------------------
 void PokemonGo::AddTrainer(const std::string& name, const Team& team,
                            const std::string& location) {
+    POKEMONGO_TIME(OPERATION_ADD_TRAINER);
     if (name.empty()) {
         throw PokemonGoInvalidArgsException();
     }
@@ -32,25 +34,89 @@ void PokemonGo::AddTrainer(const std::string& name, const Team& team,
     Trainer& trainer = trainers.at(name);
     (*world_ptr)[location]->Arrive(trainer);
     trainer.SetLocation(location);
+    if (event_log != nullptr) {
+        event_log->LogAddTrainer(name, team, location);
+    }
 }
 //------------------------------------------------------------------------------
 void PokemonGo::MoveTrainer(const std::string& trainer_name, const Direction& dir) {
+    POKEMONGO_TIME(OPERATION_MOVE_TRAINER);
     Trainers_Itr it = trainers.find(trainer_name);
     if (it == trainers.end()) {
         throw PokemonGoTrainerNotFoundExcpetion();
     }
     Trainer& trainer = it->second;
-    World_Itr world_itr = world_ptr->BeginAt(trainer.Location());
-    world_itr.Move(dir);
-    try {
-        *world_itr;
-    }
-    catch (KGraphIteratorReachedEnd) {
-        throw PokemonGoReachedDeadEndException();
-    }
+    string destination = Destination(*world_ptr, trainer.Location(), dir);
     (*world_ptr)[trainer.Location()]->Leave(trainer);
-    trainer.SetLocation(*world_itr);
+    trainer.SetLocation(destination);
     (*world_ptr)[trainer.Location()]->Arrive(trainer);
+    if (event_log != nullptr) {
+        event_log->LogMoveTrainer(trainer_name, dir, trainer.Location());
+    }
+}
+//------------------------------------------------------------------------------
+const WorldIndex& PokemonGo::Index() const {
+    call_once(world_index_built, [this]() {
+        world_index.reset(new WorldIndex(*world_ptr));
+    });
+    return *world_index;
+}
+//------------------------------------------------------------------------------
+vector<Trainer*> PokemonGo::GetTrainersWithin(const std::string& location,
+                                              int radius) const {
+    return Index().TrainersWithin(location, radius);
+}
+//------------------------------------------------------------------------------
+string PokemonGo::GetNearestGym(const std::string& location,
+                                const Team& team) const {
+    return Index().NearestGym(location, team);
+}
+//------------------------------------------------------------------------------
+void PokemonGo::SetEventLog(EventLog* log) {
+    this->event_log = log;
+}
+//------------------------------------------------------------------------------
+void PokemonGo::Replay(const EventReader& log, size_t events) {
+    const vector<Event>& log_events = log.Events();
+    const vector<string>& trainer_names = log.TrainerNames();
+    const vector<string>& location_names = log.LocationNames();
+    if (events > log_events.size()) {
+        throw PokemonGoInvalidArgsException();
+    }
+    vector<Location*> locations(location_names.size());
+    for (size_t i = 0; i < location_names.size(); ++i) {
+        if (!world_ptr->Contains(location_names[i])) {
+            throw PokemonGoLocationNotFoundException();
+        }
+        locations[i] = (*world_ptr)[location_names[i]];
+    }
+    vector<Trainer*> logged_trainers(trainer_names.size(), nullptr);
+    vector<uint32_t> trainer_locations(trainer_names.size());
+    for (size_t i = 0; i < events; ++i) {
+        const Event& event = log_events[i];
+        Location& location = *locations[event.location];
+        if (event.type == EVENT_ADD_TRAINER) {
+            const string& name = trainer_names[event.trainer];
+            pair<Trainers_Itr,bool> added =
+                    trainers.insert({name,Trainer(name,(Team)event.team)});
+            if (!added.second) {
+                throw PokemonGoTrainerNameAlreadyUsedExcpetion();
+            }
+            Trainer& trainer = added.first->second;
+            logged_trainers[event.trainer] = &trainer;
+            location.Arrive(trainer);
+            trainer.SetLocation(location_names[event.location]);
+        } else {
+            Trainer* trainer = logged_trainers[event.trainer];
+            if (trainer == nullptr) {
+                throw PokemonGoTrainerNotFoundExcpetion();
+            }
+            locations[trainer_locations[event.trainer]]->Leave(*trainer);
+            trainer->SetLocation(location_names[event.location]);
+            location.Arrive(*trainer);
+        }
+        trainer_locations[event.trainer] = event.location;
+    }
 }
 //------------------------------------------------------------------------------
 string PokemonGo::WhereIs(const std::string& trainer_name) {
@@ -68,14 +134,12 @@ const std::vector<Trainer*>& PokemonGo::GetTrainersIn(const std::string& locatio
     return (*world_ptr)[location]->GetTrainers();
 }
 //------------------------------------------------------------------------------
-int PokemonGo::numT(Team team) {
-    int counter = 0;
-    for (Trainers_Itr it = trainers.begin(); it != trainers.end(); ++it) {
-        if (it->second.GetTeam() == team) {
-            counter++;
-        }
-    }
-    return counter;
+void PokemonGo::Snapshot(const std::string& path) const {
+    SnapshotFile::Write(*this, path);
+}
+//------------------------------------------------------------------------------
+void PokemonGo::Restore(const std::string& path) {
+    SnapshotFile::Read(*this, path);
 }
 //------------------------------------------------------------------------------
 void PokemonGo::PrintTrainersByTeam(Team team) {
@@ -87,18 +151,32 @@ void PokemonGo::PrintTrainersByTeam(Team team) {
 }
 //------------------------------------------------------------------------------
 const int PokemonGo::GetScore(const Team& team) {
-    int total_score, total_trainer_lvls, num_of_leaders;
-    total_score = 0 ; total_trainer_lvls = 0 ; num_of_leaders = 0;
+    int score = 0;
     for (Trainers_Itr it = trainers.begin(); it != trainers.end(); ++it) {
         Trainer& curr_trainer = it->second;
         if (curr_trainer.GetTeam() == team) {
-            if (curr_trainer.IsGymLeader()) num_of_leaders++;
-            total_trainer_lvls += curr_trainer.Level();
-            total_score += curr_trainer.Score();
+            score += ScoreOf(curr_trainer);
         }
     }
     PrintTrainersByTeam(team);
-    cout << "(Num of trainers:" << numT(team) << ") | Total trainers score: " << total_score << " | Sum lvls:" << total_trainer_lvls << " | Num leaders: " << num_of_leaders << endl;
-    return total_score + total_trainer_lvls + num_of_leaders * LEADER_BONUS;
+    return score;
+}
+//------------------------------------------------------------------------------
+int PokemonGo::ScoreOf(const Trainer& trainer) {
+    return trainer.Score() + trainer.Level() +
+           (trainer.IsGymLeader() ? LEADER_BONUS : 0);
+}
+//------------------------------------------------------------------------------
+string PokemonGo::Destination(const World& world, const std::string& location,
+                              const Direction& dir) {
+    World_Itr world_itr = world.BeginAt(location);
+    world_itr.Move(dir);
+    try {
+        return *world_itr;
+    }
+    catch (KGraphIteratorReachedEnd) {
+        POKEMONGO_COUNT(COUNTER_DEAD_ENDS);
+        throw PokemonGoReachedDeadEndException();
+    }
 }
 //------------------------------------------------------------------------------
\ No newline at end of file
@@ -1,20 +1,40 @@
 #ifndef POKEMON_GO_H
 #define POKEMON_GO_H
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "event_log.h"
 #include "world.h"
+#include "world_index.h"
 
 namespace mtm {
 namespace pokemongo {
 
+class PokemonGoFork;
+
 class PokemonGo {
  private:
     const World* world_ptr;
     std::map<std::string,Trainer> trainers;
+    EventLog* event_log = nullptr;
+    // Built by the first spatial query.
+    mutable std::unique_ptr<WorldIndex> world_index;
+    mutable std::once_flag world_index_built;
+
+    const WorldIndex& Index() const;
+
+    // Saves and restores the state of games.
+    friend class SnapshotFile;
+    // Reads the state of games it forks.
+    friend class PokemonGoFork;
 
 public:
+  // The score a team gets for every gym led by one of its trainers.
+  static const int LEADER_BONUS = 10;
+
   // Initilaizes a new game with the given world. This passes ownership of
   // world, meaning the constructed PokemonGo is responsible for deleting all
   // memory allocated by world.
@@ -73,12 +93,114 @@ public:
   //        not exist.
   const std::vector<Trainer*>& GetTrainersIn(const std::string& location);
 
+  // Returns the trainers that are found at most radius moves away from the
+  // specified location: the trainers of the nearest locations first, and the
+  // trainers of every location ordered as by GetTrainersIn. Locations at the
+  // same distance are ordered by a breadth-first search that tries the
+  // directions from NORTH to WEST.
+  //
+  // The first spatial query indexes the world; later queries only walk the
+  // locations within the radius. Spatial queries may run in parallel with
+  // each other, but not with commands that change the game.
+  //
+  // @param location the name of the location.
+  // @param radius the largest number of moves.
+  // @return the trainers found within radius moves of the location.
+  // @throw PokemonGoLocationNotFoundException if the specified location does
+  //        not exist.
+  // @throw PokemonGoInvalidArgsException if radius is negative.
+  std::vector<Trainer*> GetTrainersWithin(const std::string& location,
+                                          int radius) const;
+
+  // Returns the name of the nearest gym to the specified location, in moves,
+  // whose leader belongs to the given team. Gyms at the same distance are
+  // ordered as by GetTrainersWithin.
+  //
+  // @param location the name of the location.
+  // @param team the team of the leader.
+  // @return the name of the gym.
+  // @throw PokemonGoLocationNotFoundException if the specified location does
+  //        not exist.
+  // @throw PokemonGoGymNotFoundException if no gym led by the team can be
+  //        reached from the location.
+  std::string GetNearestGym(const std::string& location,
+                            const Team& team) const;
+
+  // Makes the game append every trainer added or moved to the given log.
+  //
+  // @param log the log, or nullptr to stop logging. Not owned by the game.
+  void SetEventLog(EventLog* log);
+
+  // Replays the first events of a log: adds and moves trainers as logged,
+  // with the names and locations resolved once per log instead of once per
+  // event, and without searching the world for the destination of moves.
+  // Battles, catches and item pickups happen again as they did when logged,
+  // given the game is replayed over a new world built as the logged one was.
+  //
+  // @param log the log.
+  // @param events the number of events to replay.
+  // @throw PokemonGoInvalidArgsException if the log has less events.
+  // @throw PokemonGoLocationNotFoundException if a location of the log does
+  //        not exist.
+  // @throw PokemonGoTrainerNameAlreadyUsedExcpetion if a trainer added by the
+  //        log is already in the game.
+  // @throw PokemonGoTrainerNotFoundExcpetion if the log moves a trainer it did
+  //        not add.
+  void Replay(const EventReader& log, size_t events);
+
+  // Writes the state of the game to a file: the trainers (level, score,
+  // Pokemons, items, location and leader flags) and the state of every
+  // location (its trainers, gym leader, and Starbucks / Pokestop inventory).
+  // The world itself is not written.
+  //
+  // @param path the path of the file.
+  // @throw SnapshotIOException if the file cannot be written.
+  void Snapshot(const std::string& path) const;
+
+  // Replaces the state of the game with the one written to a file by
+  // Snapshot. The world of the game must have been built as the world of the
+  // game that wrote the file. The game is left unchanged if an exception is
+  // thrown.
+  //
+  // @param path the path of the file.
+  // @throw SnapshotIOException if the file cannot be read.
+  // @throw SnapshotInvalidFileException if the file is not a valid snapshot of
+  //        this version, or its locations are not the locations of the world.
+  void Restore(const std::string& path);
+
+  // Returns a copy-on-write fork of the game (see PokemonGoFork). The game
+  // must not change while the fork is in use.
+  //
+  // @return the fork.
+  std::unique_ptr<PokemonGoFork> Fork() const;
+
   // Returns the score of a given team in the game.
   //
   // @param team
   // @return the score of team.
   const int GetScore(const Team& team);
-  int numT(Team team);
+
+  // Returns the part of the score of its team a trainer is responsible for:
+  // its score and level, and LEADER_BONUS if it leads a gym. GetScore sums
+  // it over the trainers of the team, as do forks and simulations.
+  //
+  // @param trainer
+  // @return the score of the trainer.
+  static int ScoreOf(const Trainer& trainer);
+
+  // Returns the name of the location reached by moving from a location of a
+  // world in a direction. MoveTrainer, forks and simulations move trainers
+  // there.
+  //
+  // @param world the world.
+  // @param location the name of the location.
+  // @param dir the direction.
+  // @return the name of the location the direction leads to.
+  // @throw PokemonGoReachedDeadEndException if the direction specified does not
+  //        lead to any other location.
+  static std::string Destination(const World& world,
+                                 const std::string& location,
+                                 const Direction& dir);
   void PrintTrainersByTeam (Team team);
 };
 
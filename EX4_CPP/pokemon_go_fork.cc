@@ -0,0 +1,237 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include "pokemon_go_fork.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+// -------------------------------------------------------------------------- //
+//                             CONSTRUCTORS                                   //
+// -------------------------------------------------------------------------- //
+PokemonGoFork::PokemonGoFork(const PokemonGo& game,
+                             const PokemonGoFork* parent)
+        : game(game), parent(parent) {}
+//------------------------------------------------------------------------------
+unique_ptr<PokemonGoFork> PokemonGo::Fork() const {
+    return unique_ptr<PokemonGoFork>(new PokemonGoFork(*this, nullptr));
+}
+//------------------------------------------------------------------------------
+unique_ptr<PokemonGoFork> PokemonGoFork::Fork() const {
+    return unique_ptr<PokemonGoFork>(new PokemonGoFork(game, this));
+}
+// -------------------------------------------------------------------------- //
+//                                FUNCTIONS                                   //
+// -------------------------------------------------------------------------- //
+const Trainer* PokemonGoFork::FindTrainer(const std::string& name) const {
+    for (const PokemonGoFork* fork = this; fork != nullptr;
+         fork = fork->parent) {
+        unordered_map<string,ForkTrainer>::const_iterator it =
+                fork->trainers.find(name);
+        if (it != fork->trainers.end()) {
+            return &it->second.trainer;
+        }
+    }
+    map<string,Trainer>::const_iterator it = game.trainers.find(name);
+    return it != game.trainers.end() ? &it->second : nullptr;
+}
+//------------------------------------------------------------------------------
+const Location& PokemonGoFork::FindLocation(const Location* location) const {
+    for (const PokemonGoFork* fork = this; fork != nullptr;
+         fork = fork->parent) {
+        unordered_map<const Location*,unique_ptr<Location>>::const_iterator
+                it = fork->locations.find(location);
+        if (it != fork->locations.end()) {
+            return *it->second;
+        }
+    }
+    return *location;
+}
+//------------------------------------------------------------------------------
+Location& PokemonGoFork::OwnLocation(const Location* location) {
+    unordered_map<const Location*,unique_ptr<Location>>::iterator it =
+            locations.find(location);
+    if (it != locations.end()) {
+        return *it->second;
+    }
+    unique_ptr<Location> copy = World::CopyOf(FindLocation(location));
+    Location& owned = *copy;
+    locations[location] = std::move(copy);
+    return owned;
+}
+//------------------------------------------------------------------------------
+// The location of a trainer is copied along with the trainer, and the copy of
+// the location is made to point at the copy of the trainer. Hence a location
+// the fork did not copy holds none of the trainers the fork did.
+Trainer& PokemonGoFork::OwnTrainer(const Trainer& trainer) {
+    unordered_map<string,ForkTrainer>::iterator it =
+            trainers.find(trainer.GetName());
+    if (it != trainers.end()) {
+        return it->second.trainer;
+    }
+    Trainer& copy = trainers.emplace(piecewise_construct,
+                                     forward_as_tuple(trainer.GetName()),
+                                     forward_as_tuple(trainer, &trainer))
+                            .first->second.trainer;
+    Location& location = OwnLocation((*game.world_ptr)[copy.Location()]);
+    ReplaceTrainer(location, &trainer, &copy);
+    return copy;
+}
+//------------------------------------------------------------------------------
+void PokemonGoFork::ReplaceTrainer(Location& location, const Trainer* trainer,
+                                   Trainer* copy) {
+    vector<Trainer*>::iterator position =
+            find(location.trainers_.begin(), location.trainers_.end(), trainer);
+    if (position != location.trainers_.end()) {
+        *position = copy;
+    }
+    if (location.Kind() != GYM) {
+        return;
+    }
+    Gym& gym = static_cast<Gym&>(location);
+    if (gym.gym_leader == trainer) {
+        gym.gym_leader = copy;
+    }
+    unordered_map<const Trainer*,Gym::LeaderKey>::iterator it =
+            gym.index_keys.find(trainer);
+    if (it == gym.index_keys.end()) {
+        return;
+    }
+    Gym::LeaderKey key = it->second;
+    gym.index_keys.erase(it);
+    gym.team_index[copy->GetTeam()].erase(key);
+    key.trainer = copy;
+    gym.team_index[copy->GetTeam()].insert(key);
+    gym.index_keys[copy] = key;
+}
+//------------------------------------------------------------------------------
+// A trainer arriving at a gym may battle its leader.
+void PokemonGoFork::OwnGymLeader(Location& location) {
+    if (location.Kind() != GYM || location.trainers_.empty()) {
+        return;
+    }
+    OwnTrainer(*static_cast<Gym&>(location).gym_leader);
+}
+//------------------------------------------------------------------------------
+// A leader leaving a gym is replaced by the strongest trainer of one of the
+// teams.
+void PokemonGoFork::OwnLeaderCandidates(Location& location,
+                                        const Trainer& leaving) {
+    if (location.Kind() != GYM) {
+        return;
+    }
+    Gym& gym = static_cast<Gym&>(location);
+    if (!gym.is_taken || gym.gym_leader != &leaving) {
+        return;
+    }
+    vector<const Trainer*> candidates;
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        for (const Gym::LeaderKey& key : gym.team_index[team]) {
+            if (key.trainer != &leaving) {
+                candidates.push_back(key.trainer);
+                break;
+            }
+        }
+    }
+    for (const Trainer* candidate : candidates) {
+        OwnTrainer(*candidate);
+    }
+}
+//------------------------------------------------------------------------------
+void PokemonGoFork::AddTrainer(const std::string& name, const Team& team,
+                               const std::string& location) {
+    if (name.empty()) {
+        throw PokemonGoInvalidArgsException();
+    }
+    if (FindTrainer(name) != nullptr) {
+        throw PokemonGoTrainerNameAlreadyUsedExcpetion();
+    }
+    if (!game.world_ptr->Contains(location)) {
+        throw PokemonGoLocationNotFoundException();
+    }
+    Location& arrival = OwnLocation((*game.world_ptr)[location]);
+    OwnGymLeader(arrival);
+    Trainer& trainer = trainers.emplace(piecewise_construct,
+                                        forward_as_tuple(name),
+                                        forward_as_tuple(Trainer(name,team),
+                                                         nullptr))
+                               .first->second.trainer;
+    arrival.Arrive(trainer);
+    trainer.SetLocation(location);
+}
+//------------------------------------------------------------------------------
+void PokemonGoFork::MoveTrainer(const std::string& trainer_name,
+                                const Direction& dir) {
+    const Trainer* found = FindTrainer(trainer_name);
+    if (found == nullptr) {
+        throw PokemonGoTrainerNotFoundExcpetion();
+    }
+    string destination =
+            PokemonGo::Destination(*game.world_ptr, found->Location(), dir);
+    Trainer& trainer = OwnTrainer(*found);
+    Location& departure = OwnLocation((*game.world_ptr)[trainer.Location()]);
+    OwnLeaderCandidates(departure, trainer);
+    departure.Leave(trainer);
+    trainer.SetLocation(destination);
+    Location& arrival = OwnLocation((*game.world_ptr)[destination]);
+    OwnGymLeader(arrival);
+    arrival.Arrive(trainer);
+}
+//------------------------------------------------------------------------------
+string PokemonGoFork::WhereIs(const std::string& trainer_name) const {
+    const Trainer* trainer = FindTrainer(trainer_name);
+    if (trainer == nullptr) {
+        throw PokemonGoTrainerNotFoundExcpetion();
+    }
+    return trainer->Location();
+}
+//------------------------------------------------------------------------------
+vector<const Trainer*> PokemonGoFork::GetTrainersIn(
+        const std::string& location) const {
+    if (!game.world_ptr->Contains(location)) {
+        throw PokemonGoLocationNotFoundException();
+    }
+    const vector<Trainer*>& trainers =
+            FindLocation((*game.world_ptr)[location]).trainers_;
+    return vector<const Trainer*>(trainers.begin(), trainers.end());
+}
+//------------------------------------------------------------------------------
+int PokemonGoFork::GetScore(const Team& team) const {
+    int score = 0;
+    if (parent != nullptr) {
+        score = parent->GetScore(team);
+    } else {
+        for (const pair<const string,Trainer>& trainer : game.trainers) {
+            if (trainer.second.GetTeam() == team) {
+                score += PokemonGo::ScoreOf(trainer.second);
+            }
+        }
+    }
+    return score + GetScoreChange(team);
+}
+//------------------------------------------------------------------------------
+int PokemonGoFork::GetScoreChange(const Team& team) const {
+    int change = 0;
+    for (const pair<const string,ForkTrainer>& trainer : trainers) {
+        const ForkTrainer& fork_trainer = trainer.second;
+        if (fork_trainer.trainer.GetTeam() != team) continue;
+        change += PokemonGo::ScoreOf(fork_trainer.trainer);
+        if (fork_trainer.origin != nullptr) {
+            change -= PokemonGo::ScoreOf(*fork_trainer.origin);
+        }
+    }
+    return change;
+}
+//------------------------------------------------------------------------------
+size_t PokemonGoFork::CopiedTrainers() const {
+    return trainers.size();
+}
+//------------------------------------------------------------------------------
+size_t PokemonGoFork::CopiedLocations() const {
+    return locations.size();
+}
+//------------------------------------------------------------------------------
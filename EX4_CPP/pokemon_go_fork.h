@@ -0,0 +1,93 @@
+#ifndef POKEMON_GO_FORK_H
+#define POKEMON_GO_FORK_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pokemon_go.h"
+
+namespace mtm {
+namespace pokemongo {
+
+// A copy-on-write fork of a PokemonGo game, for "what if" queries. A fork
+// starts with the state of its parent (a game or another fork) and shares
+// every trainer and location with it. The first time a command changes a
+// trainer or a location, the fork copies it and changes the copy, so the
+// parent is never written. Arriving at a gym may change its leader and
+// leaving it may elect one of the strongest trainers of every team, so these
+// are copied as well. Discarding a fork frees only the copies it made.
+//
+// The parent must not change, move or be destroyed while the fork is in use.
+class PokemonGoFork {
+ public:
+  // Disable copy and assignment.
+  PokemonGoFork(const PokemonGoFork&) = delete;
+  PokemonGoFork& operator=(const PokemonGoFork&) = delete;
+
+  // Returns a new fork of this fork.
+  std::unique_ptr<PokemonGoFork> Fork() const;
+
+  // Same as PokemonGo::AddTrainer.
+  void AddTrainer(
+      const std::string& name, const Team& team, const std::string& location);
+
+  // Same as PokemonGo::MoveTrainer.
+  void MoveTrainer(const std::string& trainer_name, const Direction& dir);
+
+  // Same as PokemonGo::WhereIs.
+  std::string WhereIs(const std::string& trainer_name) const;
+
+  // Same as PokemonGo::GetTrainersIn. The trainers may be shared with the
+  // parent, so they cannot be changed.
+  std::vector<const Trainer*> GetTrainersIn(const std::string& location) const;
+
+  // Same as PokemonGo::GetScore, without printing the trainers. Scans all the
+  // trainers of the game the fork was made of.
+  int GetScore(const Team& team) const;
+
+  // Returns how much the score of a team changed since the fork was made.
+  // Only looks at the trainers copied by the fork.
+  //
+  // @param team
+  // @return the score of team in the fork minus its score in the parent.
+  int GetScoreChange(const Team& team) const;
+
+  // Returns the number of trainers / locations copied by the fork.
+  size_t CopiedTrainers() const;
+  size_t CopiedLocations() const;
+
+ private:
+  // A trainer of the fork, and the trainer of the parent it was copied from
+  // (nullptr for trainers added by the fork).
+  struct ForkTrainer {
+    ForkTrainer(const Trainer& trainer, const Trainer* origin)
+        : trainer(trainer), origin(origin) {}
+    Trainer trainer;
+    const Trainer* origin;
+  };
+
+  const PokemonGo& game;
+  const PokemonGoFork* parent;
+  std::unordered_map<std::string,ForkTrainer> trainers;
+  // The copied locations, by the location of the world they are copies of.
+  std::unordered_map<const Location*,std::unique_ptr<Location>> locations;
+
+  PokemonGoFork(const PokemonGo& game, const PokemonGoFork* parent);
+
+  const Trainer* FindTrainer(const std::string& name) const;
+  const Location& FindLocation(const Location* location) const;
+  Trainer& OwnTrainer(const Trainer& trainer);
+  Location& OwnLocation(const Location* location);
+  void OwnGymLeader(Location& location);
+  void OwnLeaderCandidates(Location& location, const Trainer& leaving);
+  static void ReplaceTrainer(Location& location, const Trainer* trainer,
+                             Trainer* copy);
+
+  friend class PokemonGo;
+};
+
+}  // namespace pokemongo
+}  // namespace mtm
+
+#endif  // POKEMON_GO_FORK_H
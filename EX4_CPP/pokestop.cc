@@ -1,27 +1,27 @@
 // -------------------------------------------------------------------------- //
 //                             INCLUDES & DEFINES                             //
 // -------------------------------------------------------------------------- //
+#include "instrumentation.h"
 #include "pokestop.h"
 
 using namespace mtm::pokemongo;
 using namespace std;
 
-typedef list<Item*>::iterator Items_Iterator;
-
 // -------------------------------------------------------------------------- //
 //                                FUNCTIONS                                   //
 // -------------------------------------------------------------------------- //
 void Pokestop::Arrive(Trainer& trainer) {
-    Items_Iterator first_item_ptr = items.begin();
-    const Item& first_item = **first_item_ptr;
-    if (trainer.Level() > first_item.Level()) {
-        trainer.GetItems().push_front(*first_item_ptr);
-        items.remove(*first_item_ptr);
+    POKEMONGO_TIME(OPERATION_POKESTOP_ARRIVE);
+    if (!items.empty() && trainer.Level() > items.front().Level()) {
+        POKEMONGO_COUNT(COUNTER_ITEMS_PICKED);
+        trainer.AddItem(items.front());
+        items.pop_front();
     }
     Location::Arrive(trainer);
 }
 //------------------------------------------------------------------------------
 void Pokestop::Leave(Trainer& trainer) {
+    POKEMONGO_TIME(OPERATION_POKESTOP_LEAVE);
     Location::Leave(trainer);
 }
 //------------------------------------------------------------------------------
\ No newline at end of file
@@ -2,7 +2,8 @@
 #define POKESTOP_H
 
 #include <iostream>
-#include <list>
+#include <deque>
+#include <vector>
 #include "location.h"
 #include "trainer.h"
 #include "item.h"
@@ -13,17 +14,16 @@ namespace mtm {
         class Pokestop : public Location {
         private:
             std::string name;
-            std::list<Item*> items;
+            std::deque<Item> items;
 
         public:
-            Pokestop(const std::string& name, std::list<Item*> items):
-                     name(name), items(items) {};
-            ~Pokestop() {
-                for (std::list<Item*>::iterator it = items.begin();
-                        it != items.end(); ++it) {
-                    delete *it;
-                }
-            }
+            // Saves and restores the state of the location.
+            friend class SnapshotFile;
+
+            Pokestop(const std::string& name, const std::vector<Item>& items):
+                     Location(POKESTOP), name(name),
+                     items(items.begin(), items.end()) {};
+            ~Pokestop() = default;
             void Arrive(Trainer& trainer) override;
             void Leave(Trainer& trainer) override;
         };
@@ -0,0 +1,254 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "pokemon_go.h"
+#include "simulator.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const int DIRECTIONS_NUM = 4;
+static const double MEDIAN = 0.5;
+static const double P90 = 0.9;
+// -------------------------------------------------------------------------- //
+//                             AUX FUNCTIONS                                  //
+// -------------------------------------------------------------------------- //
+namespace {
+    // The state of a single trial: its trainers, and its own copies of the
+    // locations they visited. The world itself is only read.
+    class Trial {
+    public:
+        Trial(const World& world, int trainers, EventLog* log)
+                : world(world), log(log) {
+            // Locations keep pointers to the trainers, so the trainers must
+            // never move.
+            this->trainers.reserve(trainers);
+        }
+
+        // Same as PokemonGo::AddTrainer.
+        void AddTrainer(const string& name, const Team& team,
+                        const string& location) {
+            if (!world.Contains(location)) {
+                throw SimulatorLocationNotFoundException();
+            }
+            trainers.push_back(Trainer(name, team));
+            Trainer& trainer = trainers.back();
+            At(location).Arrive(trainer);
+            trainer.SetLocation(location);
+            if (log != nullptr) {
+                log->LogAddTrainer(name, team, location);
+            }
+        }
+
+        // Same as PokemonGo::MoveTrainer, except that a move to a dead end
+        // is skipped.
+        void MoveTrainer(Trainer& trainer, const Direction& dir) {
+            string destination;
+            try {
+                destination =
+                        PokemonGo::Destination(world, trainer.Location(), dir);
+            }
+            catch (PokemonGoReachedDeadEndException) {
+                return;
+            }
+            At(trainer.Location()).Leave(trainer);
+            trainer.SetLocation(destination);
+            At(destination).Arrive(trainer);
+            if (log != nullptr) {
+                log->LogMoveTrainer(trainer.GetName(), dir, destination);
+            }
+        }
+
+        // Same as PokemonGo::GetScore.
+        int Score(const Team& team) const {
+            int score = 0;
+            for (const Trainer& trainer : trainers) {
+                if (trainer.GetTeam() == team) {
+                    score += PokemonGo::ScoreOf(trainer);
+                }
+            }
+            return score;
+        }
+
+        vector<Trainer>& Trainers() {
+            return trainers;
+        }
+
+    private:
+        const World& world;
+        EventLog* log;
+        vector<Trainer> trainers;
+        unordered_map<const Location*,unique_ptr<Location>> locations;
+
+        // Returns the copy of the location with the given name, copying the
+        // location of the world on first use.
+        Location& At(const string& name) {
+            Location* shared = world[name];
+            unordered_map<const Location*,unique_ptr<Location>>::iterator it =
+                    locations.find(shared);
+            if (it != locations.end()) {
+                return *it->second;
+            }
+            if (!shared->GetTrainers().empty()) {
+                throw SimulatorInvalidArgsException();
+            }
+            unique_ptr<Location> copy = World::CopyOf(*shared);
+            Location& location = *copy;
+            locations[shared] = std::move(copy);
+            return location;
+        }
+    };
+
+    void runTrial(const World& world, const SimulationConfig& config,
+                  int trial, SimulationResults& results) {
+        seed_seq seeds = {(uint32_t)config.seed,
+                          (uint32_t)(config.seed >> 32), (uint32_t)trial};
+        TrialRandom random(seeds);
+        Trial state(world, config.trainers_per_team * TEAMS_NUM,
+                    trial == config.logged_trial ? config.log : nullptr);
+        for (int i = 0; i < config.trainers_per_team; ++i) {
+            for (int team = 0; team < TEAMS_NUM; ++team) {
+                state.AddTrainer(to_string(i * TEAMS_NUM + team), (Team)team,
+                                 config.spawn(random));
+            }
+        }
+        vector<Trainer>& trainers = state.Trainers();
+        if (!trainers.empty()) {
+            uniform_int_distribution<int> pick(0, (int)trainers.size() - 1);
+            for (int i = 0; i < config.moves; ++i) {
+                Trainer& trainer = trainers[pick(random)];
+                state.MoveTrainer(trainer, config.move(random, trainer));
+            }
+        }
+        for (int team = 0; team < TEAMS_NUM; ++team) {
+            results.scores[team][trial] = state.Score((Team)team);
+        }
+    }
+
+    // Returns the score below which the given fraction of the sorted scores
+    // lie (nearest rank).
+    int percentile(const vector<int>& sorted_scores, double fraction) {
+        int rank = (int)ceil(fraction * sorted_scores.size());
+        return sorted_scores[max(rank, 1) - 1];
+    }
+}
+// -------------------------------------------------------------------------- //
+//                                FUNCTIONS                                   //
+// -------------------------------------------------------------------------- //
+SpawnPolicy mtm::pokemongo::SpawnUniformly(
+        const std::vector<std::string>& locations) {
+    if (locations.empty()) {
+        throw SimulatorInvalidArgsException();
+    }
+    return [locations](TrialRandom& random) {
+        uniform_int_distribution<size_t> pick(0, locations.size() - 1);
+        return locations[pick(random)];
+    };
+}
+//------------------------------------------------------------------------------
+MovePolicy mtm::pokemongo::MoveUniformly() {
+    return [](TrialRandom& random, const Trainer&) {
+        uniform_int_distribution<Direction> pick(0, DIRECTIONS_NUM - 1);
+        return pick(random);
+    };
+}
+//------------------------------------------------------------------------------
+ScoreSummary SimulationResults::Summarize(const Team& team) const {
+    ScoreSummary summary = {0, 0, 0, 0, 0, 0};
+    vector<int> sorted_scores(this->scores[team]);
+    if (sorted_scores.empty()) {
+        return summary;
+    }
+    sort(sorted_scores.begin(), sorted_scores.end());
+    double sum = 0, squares_sum = 0;
+    for (int score : sorted_scores) {
+        sum += score;
+        squares_sum += (double)score * score;
+    }
+    summary.mean = sum / sorted_scores.size();
+    summary.stddev = sqrt(max(0.0, squares_sum / sorted_scores.size() -
+                                   summary.mean * summary.mean));
+    summary.min = sorted_scores.front();
+    summary.median = percentile(sorted_scores, MEDIAN);
+    summary.p90 = percentile(sorted_scores, P90);
+    summary.max = sorted_scores.back();
+    return summary;
+}
+//------------------------------------------------------------------------------
+SimulationResults mtm::pokemongo::Simulate(const World& world,
+                                           const SimulationConfig& config) {
+    if (config.trials < 0 || config.trainers_per_team < 0 ||
+        config.moves < 0 || config.threads < 0 || !config.spawn ||
+        !config.move || (config.log != nullptr &&
+                         (config.logged_trial < 0 ||
+                          config.logged_trial >= config.trials))) {
+        throw SimulatorInvalidArgsException();
+    }
+    SimulationResults results;
+    results.scores.assign(TEAMS_NUM, vector<int>(config.trials));
+    results.wins.assign(TEAMS_NUM, 0);
+
+    // Trials are handed out one at a time. Each trial writes only its own
+    // entries of the results, so the threads share nothing else.
+    int threads = config.threads != 0 ? config.threads :
+                  max(1, (int)thread::hardware_concurrency());
+    threads = max(1, min(threads, config.trials));
+    atomic<int> next_trial(0);
+    exception_ptr error;
+    mutex error_mutex;
+    auto worker = [&]() {
+        try {
+            for (int trial = next_trial++; trial < config.trials;
+                 trial = next_trial++) {
+                runTrial(world, config, trial, results);
+            }
+        }
+        catch (...) {
+            lock_guard<mutex> lock(error_mutex);
+            if (!error) {
+                error = current_exception();
+            }
+            next_trial = config.trials;
+        }
+    };
+    vector<thread> workers;
+    for (int i = 1; i < threads; ++i) {
+        workers.push_back(thread(worker));
+    }
+    worker();
+    for (thread& worker_thread : workers) {
+        worker_thread.join();
+    }
+    if (error) {
+        rethrow_exception(error);
+    }
+
+    for (int trial = 0; trial < config.trials; ++trial) {
+        int winner = 0;
+        bool is_tie = false;
+        for (int team = 1; team < TEAMS_NUM; ++team) {
+            int score = results.scores[team][trial];
+            if (score > results.scores[winner][trial]) {
+                winner = team;
+                is_tie = false;
+            } else if (score == results.scores[winner][trial]) {
+                is_tie = true;
+            }
+        }
+        if (!is_tie) {
+            results.wins[winner]++;
+        }
+    }
+    return results;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "event_log.h"
+#include "world.h"
+
+namespace mtm {
+namespace pokemongo {
+
+// The random number generator of a single trial. Every trial has its own
+// generator, seeded from the simulation seed and the number of the trial.
+typedef std::mt19937_64 TrialRandom;
+
+// Returns the name of the location where a new trainer starts a trial.
+typedef std::function<std::string(TrialRandom& random)> SpawnPolicy;
+
+// Returns the direction in which a trainer moves.
+typedef std::function<Direction(TrialRandom& random, const Trainer& trainer)>
+    MovePolicy;
+
+// Returns a policy that spawns trainers uniformly at the given locations.
+SpawnPolicy SpawnUniformly(const std::vector<std::string>& locations);
+
+// Returns a policy that moves trainers in a uniformly chosen direction.
+MovePolicy MoveUniformly();
+
+struct SimulationConfig {
+  int trials = 1;
+  // Trainers of every team added at the beginning of each trial.
+  int trainers_per_team = 1;
+  // Trainer moves made in each trial. Every move is made by a uniformly
+  // chosen trainer.
+  int moves = 0;
+  unsigned long long seed = 0;
+  // Threads running the trials. 0 means one thread per hardware thread.
+  int threads = 0;
+  // The policies are called concurrently from all the threads.
+  SpawnPolicy spawn;
+  MovePolicy move = MoveUniformly();
+  // If set, the trainers added and moved in trial logged_trial are appended
+  // to this log, as PokemonGo appends them, so that PokemonGo::Replay over a
+  // new world can reproduce the trial. Not owned by the simulation.
+  EventLog* log = nullptr;
+  int logged_trial = 0;
+};
+
+// The distribution of the scores of a team over all the trials.
+struct ScoreSummary {
+  double mean;
+  double stddev;
+  int min;
+  int median;
+  int p90;
+  int max;
+};
+
+struct SimulationResults {
+  // The score of every team at the end of every trial, as returned by
+  // PokemonGo::GetScore: scores[team][trial].
+  std::vector<std::vector<int>> scores;
+  // The number of trials each team ended with the highest score. Trials in
+  // which several teams share the highest score count for none of them.
+  std::vector<int> wins;
+
+  // Returns the distribution of the scores of the given team.
+  ScoreSummary Summarize(const Team& team) const;
+};
+
+// Runs independent randomized trials of a PokemonGo game over the given world
+// in parallel. Each trial adds config.trainers_per_team trainers of every team
+// at locations chosen by config.spawn, one trainer of every team at a time in
+// the order BLUE, YELLOW, RED, and names every trainer after the number of
+// trainers added before it ("0", "1", ...). It then makes config.moves moves
+// in directions chosen by config.move. Moves to a dead end are skipped.
+//
+// The world is shared by all the trials and is never written: a trial copies
+// the state of a location (gym leader, Pokemons, items) the first time one of
+// its trainers arrives there. The results depend only on the world, the
+// config and the seed, and not on the number of threads.
+//
+// @param world the world, without trainers.
+// @param config the simulation parameters.
+// @return the scores of all the trials.
+// @throw SimulatorInvalidArgsException if the number of trials, trainers or
+//        moves is negative, config.spawn is not set, config.log is set and
+//        config.logged_trial is not one of the trials, or the world already
+//        has trainers in one of the visited locations.
+// @throw SimulatorLocationNotFoundException if config.spawn returns a location
+//        which does not exist.
+SimulationResults Simulate(const World& world, const SimulationConfig& config);
+
+}  // namespace pokemongo
+}  // namespace mtm
+
+#endif  // SIMULATOR_H
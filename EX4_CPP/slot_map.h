@@ -0,0 +1,281 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <climits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace mtm {
+
+// A slot map. Stores elements in fixed-size chunks of slots, so an element
+// never moves while it is in the map, and reuses the slots of removed elements.
+// Every element is identified by an Id made of the index of its slot and a
+// stamp drawn from a monotonic counter, so ids are never reused and compare by
+// insertion order. Insert, Remove and Find take O(1).
+//
+// Requirements: T copy c'tor.
+template<typename T> class SlotMap {
+ public:
+  // Identifies an element in the map. A default constructed Id identifies no
+  // element.
+  class Id {
+   public:
+    Id(): stamp_(0), index_(0) {}
+
+    // Ids are equal iff they identify the same element.
+    bool operator==(const Id& rhs) const {
+      return stamp_ == rhs.stamp_ && index_ == rhs.index_;
+    }
+    bool operator!=(const Id& rhs) const { return !(*this == rhs); }
+
+    // An id is smaller than another iff its element was inserted earlier.
+    bool operator<(const Id& rhs) const { return stamp_ < rhs.stamp_; }
+
+   private:
+    friend class SlotMap;
+    Id(unsigned long long stamp, unsigned int index):
+        stamp_(stamp), index_(index) {}
+
+    unsigned long long stamp_;
+    unsigned int index_;
+  };
+
+  // A const iterator. Visits the elements of the map from the least recently
+  // inserted to the most recently inserted.
+  class const_iterator {
+   public:
+    const T& operator*() const { return map_->GetSlot(index_).Value(); }
+    const T* operator->() const { return &map_->GetSlot(index_).Value(); }
+    const_iterator& operator++() {
+      index_ = map_->GetSlot(index_).next;
+      return *this;
+    }
+    bool operator==(const const_iterator& rhs) const {
+      return map_ == rhs.map_ && index_ == rhs.index_;
+    }
+    bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+    // Returns the id of the element the iterator points to.
+    Id GetId() const {
+      return Id(map_->GetSlot(index_).stamp, index_);
+    }
+
+   private:
+    friend class SlotMap;
+    const_iterator(const SlotMap* map, unsigned int index):
+        map_(map), index_(index) {}
+
+    const SlotMap* map_;
+    unsigned int index_;
+  };
+
+  // Constructs a new empty slot map.
+  SlotMap(): slot_count_(0), size_(0), free_head_(NONE), first_(NONE),
+             last_(NONE), next_stamp_(1) {}
+
+  // A copy constructor. The copy keeps the ids of the copied elements.
+  //
+  // @param other the slot map to copy.
+  SlotMap(const SlotMap& other): SlotMap() {
+    CopyFrom(other);
+  }
+
+  // Assignment operator. The assigned map keeps the ids of the copied
+  // elements.
+  //
+  // @param other the slot map to copy.
+  SlotMap& operator=(const SlotMap& other) {
+    if (this != &other) {
+      Clear();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+
+  // A destructor.
+  ~SlotMap() {
+    Clear();
+  }
+
+  // Inserts a copy of the given value to the map.
+  //
+  // @param value the value to insert.
+  // @return the id of the new element.
+  Id Insert(const T& value) {
+    unsigned int index = free_head_;
+    if (index == NONE) {
+      if (slot_count_ % CHUNK_SIZE == 0) {
+        chunks_.push_back(std::unique_ptr<Slot[]>(new Slot[CHUNK_SIZE]));
+      }
+      index = slot_count_++;
+      GetSlot(index).next = NONE;
+    } else {
+      free_head_ = GetSlot(index).next;
+    }
+    Slot& slot = GetSlot(index);
+    try {
+      new (&slot.storage) T(value);
+    } catch (...) {
+      slot.next = free_head_;
+      free_head_ = index;
+      throw;
+    }
+    slot.stamp = next_stamp_++;
+    slot.prev = last_;
+    slot.next = NONE;
+    if (last_ == NONE) {
+      first_ = index;
+    } else {
+      GetSlot(last_).next = index;
+    }
+    last_ = index;
+    size_++;
+    return Id(slot.stamp, index);
+  }
+
+  // Removes the element with the given id from the map.
+  //
+  // @param id the id of the element to remove.
+  // @return true iff the map contained the element.
+  bool Remove(const Id& id) {
+    if (!Contains(id)) {
+      return false;
+    }
+    Slot& slot = GetSlot(id.index_);
+    slot.Value().~T();
+    slot.stamp = 0;
+    if (slot.prev == NONE) {
+      first_ = slot.next;
+    } else {
+      GetSlot(slot.prev).next = slot.next;
+    }
+    if (slot.next == NONE) {
+      last_ = slot.prev;
+    } else {
+      GetSlot(slot.next).prev = slot.prev;
+    }
+    slot.next = free_head_;
+    free_head_ = id.index_;
+    size_--;
+    return true;
+  }
+
+  // Returns a pointer to the element with the given id.
+  //
+  // @param id the id of the element.
+  // @return a pointer to the element, or nullptr if the map does not contain
+  //         an element with the given id.
+  T* Find(const Id& id) {
+    return Contains(id) ? &GetSlot(id.index_).Value() : nullptr;
+  }
+  const T* Find(const Id& id) const {
+    return Contains(id) ? &GetSlot(id.index_).Value() : nullptr;
+  }
+
+  // Checks whether the map contains an element with the given id.
+  //
+  // @param id
+  // @return true iff the map contains an element with the given id.
+  bool Contains(const Id& id) const {
+    return id.stamp_ != 0 && id.index_ < slot_count_ &&
+           GetSlot(id.index_).stamp == id.stamp_;
+  }
+
+  // Returns the number of elements in the map.
+  int Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+
+  // Returns an iterator to the least recently inserted element, or to the end
+  // of the map if it is empty.
+  const_iterator Begin() const { return const_iterator(this, first_); }
+
+  // Returns an iterator to the end of the map.
+  const_iterator End() const { return const_iterator(this, NONE); }
+
+ private:
+  static const unsigned int NONE = UINT_MAX;
+  static const unsigned int CHUNK_SIZE = 64;
+
+  // A slot. A free slot has a zero stamp and links to the next free slot
+  // through next. A used slot holds a value and is linked to its neighbours
+  // in insertion order through prev and next.
+  struct Slot {
+    unsigned long long stamp = 0;
+    unsigned int prev = NONE;
+    unsigned int next = NONE;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T& Value() { return *reinterpret_cast<T*>(&storage); }
+    const T& Value() const { return *reinterpret_cast<const T*>(&storage); }
+  };
+
+  std::vector<std::unique_ptr<Slot[]>> chunks_;
+  unsigned int slot_count_;
+  int size_;
+  unsigned int free_head_;
+  unsigned int first_;
+  unsigned int last_;
+  unsigned long long next_stamp_;
+
+  Slot& GetSlot(unsigned int index) {
+    return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+  }
+  const Slot& GetSlot(unsigned int index) const {
+    return chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+  }
+
+  // Destroys all the elements and releases all the slots.
+  void Clear() {
+    for (unsigned int index = first_; index != NONE;
+         index = GetSlot(index).next) {
+      GetSlot(index).Value().~T();
+    }
+    chunks_.clear();
+    slot_count_ = 0;
+    size_ = 0;
+    free_head_ = first_ = last_ = NONE;
+  }
+
+  // Copies the slot layout of an empty map from other, so ids stay valid.
+  void CopyFrom(const SlotMap& other) {
+    for (unsigned int i = 0; i < other.slot_count_; i += CHUNK_SIZE) {
+      chunks_.push_back(std::unique_ptr<Slot[]>(new Slot[CHUNK_SIZE]));
+    }
+    for (unsigned int index = 0; index < other.slot_count_; ++index) {
+      const Slot& source = other.GetSlot(index);
+      Slot& slot = GetSlot(index);
+      slot.prev = source.prev;
+      slot.next = source.next;
+      slot.stamp = 0;
+    }
+    slot_count_ = other.slot_count_;
+    free_head_ = other.free_head_;
+    first_ = last_ = NONE;
+    try {
+      for (unsigned int index = other.first_; index != NONE;
+           index = other.GetSlot(index).next) {
+        Slot& slot = GetSlot(index);
+        new (&slot.storage) T(other.GetSlot(index).Value());
+        slot.stamp = other.GetSlot(index).stamp;
+        slot.next = NONE;
+        if (last_ == NONE) {
+          first_ = index;
+        } else {
+          GetSlot(last_).next = index;
+        }
+        last_ = index;
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    size_ = other.size_;
+    next_stamp_ = other.next_stamp_;
+  }
+};
+
+}  // namespace mtm
+
+#endif  // SLOT_MAP_H
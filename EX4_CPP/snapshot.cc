@@ -0,0 +1,602 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include "pokemon_go.h"
+#include "snapshot.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const char MAGIC[] = {'P', 'G', 'S', 'S'};
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+static const size_t ALIGNMENT = sizeof(uint64_t);
+static const int32_t NO_LEADER = -1;
+static const uint32_t NO_LOCATION = UINT32_MAX;
+static const int TEAMS_NUM = RED + 1;
+static const int TYPES_NUM = PSYCHIC + 1;
+static const int LOCATION_KINDS_NUM = STARBUCKS + 1;
+typedef map<string,Trainer>::iterator Trainers_Itr;
+typedef mtm::SlotMap<Pokemon>::const_iterator Pokemons_Iterator;
+// -------------------------------------------------------------------------- //
+//                                  RECORDS                                   //
+// -------------------------------------------------------------------------- //
+namespace {
+    // The sections of a snapshot, in the order they are written.
+    typedef enum {
+        STRINGS,
+        TRAINERS,
+        POKEMONS,
+        ITEMS,
+        LOCATIONS,
+        LOCATION_TRAINERS,
+        SECTIONS_NUM,
+    } Section;
+
+    struct Header {
+        char magic[sizeof(MAGIC)];
+        uint32_t version;
+        // The checksum of all the sections.
+        uint64_t checksum;
+        // The number of records in every section.
+        uint64_t counts[SECTIONS_NUM];
+    };
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    // The Pokemons and items of a trainer follow those of the trainers
+    // before it in the Pokemons and items sections.
+    struct TrainerRecord {
+        StringRef name;
+        int32_t team;
+        int32_t level;
+        int32_t score;
+        uint8_t is_gym_leader;
+        uint8_t has_won_last_battle;
+        uint16_t reserved;
+        uint32_t pokemons;
+        uint32_t items;
+    };
+
+    struct PokemonRecord {
+        double hp;
+        double cp;
+        double hit_power;
+        StringRef species;
+        int32_t level;
+        uint16_t types;
+        uint16_t reserved;
+    };
+
+    struct ItemRecord {
+        int32_t type;
+        int32_t level;
+    };
+
+    // The trainers of a location follow those of the locations before it in
+    // the location trainers section. The inventory of a Starbucks / Pokestop
+    // follows the Pokemons / items of all the trainers and of the locations
+    // before it.
+    struct LocationRecord {
+        StringRef name;
+        uint32_t kind;
+        uint32_t trainers;
+        uint32_t inventory;
+        int32_t leader;
+        int32_t gym_team;
+        uint32_t is_taken;
+    };
+
+    const size_t RECORD_SIZES[SECTIONS_NUM] = {
+        sizeof(char), sizeof(TrainerRecord), sizeof(PokemonRecord),
+        sizeof(ItemRecord), sizeof(LocationRecord), sizeof(uint32_t)};
+
+    size_t padding(size_t bytes) {
+        return (ALIGNMENT - bytes % ALIGNMENT) % ALIGNMENT;
+    }
+
+    // 64-bit FNV-1a over 8-byte words. Every chunk added is padded with zeros
+    // to a whole number of words, as sections are in the file.
+    class Checksum {
+    public:
+        void Add(const void* data, size_t bytes) {
+            const char* begin = (const char*)data;
+            for (size_t i = 0; i < bytes; i += ALIGNMENT) {
+                uint64_t word = 0;
+                memcpy(&word, begin + i, min(ALIGNMENT, bytes - i));
+                hash = (hash ^ word) * FNV_PRIME;
+            }
+        }
+        uint64_t Value() const {
+            return hash;
+        }
+    private:
+        uint64_t hash = FNV_OFFSET_BASIS;
+    };
+
+    // A file mapped read-only into memory.
+    class MappedFile {
+    public:
+        explicit MappedFile(const string& path) {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw SnapshotIOException();
+            }
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) != 0) {
+                close(fd);
+                throw SnapshotIOException();
+            }
+            size = (size_t)file_stat.st_size;
+            if (size < sizeof(Header)) {
+                close(fd);
+                throw SnapshotInvalidFileException();
+            }
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (mapped == MAP_FAILED) {
+                throw SnapshotIOException();
+            }
+            data = (const char*)mapped;
+        }
+        ~MappedFile() {
+            munmap((void*)data, size);
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data;
+        size_t size;
+    };
+}
+// -------------------------------------------------------------------------- //
+//                                  WRITER                                    //
+// -------------------------------------------------------------------------- //
+class SnapshotFile::Writer {
+public:
+    explicit Writer(const PokemonGo& game) {
+        trainer_indices.reserve(game.trainers.size());
+        for (const pair<const string,Trainer>& entry : game.trainers) {
+            const Trainer& trainer = entry.second;
+            trainer_indices[&trainer] = (uint32_t)trainers.size();
+            TrainerRecord record = {AddString(trainer.name), trainer.team,
+                                    trainer.level, trainer.score,
+                                    trainer.is_a_gym_leader,
+                                    trainer.has_won_last_battle, 0,
+                                    (uint32_t)trainer.pokemons.Size(),
+                                    (uint32_t)trainer.items.size()};
+            trainers.push_back(record);
+            for (Pokemons_Iterator it = trainer.pokemons.Begin();
+                 it != trainer.pokemons.End(); ++it) {
+                AddPokemon(*it);
+            }
+            for (const Item& item : trainer.items) {
+                AddItem(item);
+            }
+        }
+        const World& world = *game.world_ptr;
+        for (const Gym& gym : world.gyms) {
+            LocationRecord& record = AddLocation(gym, gym.name, 0);
+            if (gym.is_taken) {
+                record.leader = (int32_t)trainer_indices.at(gym.gym_leader);
+                record.gym_team = gym.gym_team_color;
+                record.is_taken = true;
+            }
+        }
+        for (const Pokestop& pokestop : world.pokestops) {
+            AddLocation(pokestop, pokestop.name, pokestop.items.size());
+            for (const Item& item : pokestop.items) {
+                AddItem(item);
+            }
+        }
+        for (const Starbucks& starbucks : world.starbucks) {
+            AddLocation(starbucks, starbucks.name, starbucks.pokemons.size());
+            for (const Pokemon& pokemon : starbucks.pokemons) {
+                AddPokemon(pokemon);
+            }
+        }
+    }
+
+    void WriteTo(const string& path) const {
+        const void* sections[SECTIONS_NUM] = {
+            strings.data(), trainers.data(), pokemons.data(), items.data(),
+            locations.data(), location_trainers.data()};
+        const size_t counts[SECTIONS_NUM] = {
+            strings.size(), trainers.size(), pokemons.size(), items.size(),
+            locations.size(), location_trainers.size()};
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        Checksum checksum;
+        for (int section = 0; section < SECTIONS_NUM; ++section) {
+            header.counts[section] = counts[section];
+            checksum.Add(sections[section],
+                         counts[section] * RECORD_SIZES[section]);
+        }
+        header.checksum = checksum.Value();
+
+        // The snapshot is written beside the destination and renamed over it
+        // once complete, so a failed write never leaves a truncated snapshot
+        // in place of the previous one.
+        string temporary_path = path + ".tmp";
+        ofstream file(temporary_path.c_str(), ios::binary | ios::trunc);
+        if (!file) {
+            throw SnapshotIOException();
+        }
+        file.write((const char*)&header, sizeof(header));
+        const char zeros[ALIGNMENT] = {0};
+        for (int section = 0; section < SECTIONS_NUM; ++section) {
+            size_t bytes = counts[section] * RECORD_SIZES[section];
+            file.write((const char*)sections[section], bytes);
+            file.write(zeros, padding(bytes));
+        }
+        file.flush();
+        file.close();
+        if (!file || rename(temporary_path.c_str(), path.c_str()) != 0) {
+            remove(temporary_path.c_str());
+            throw SnapshotIOException();
+        }
+    }
+
+private:
+    vector<char> strings;
+    unordered_map<string,StringRef> interned_strings;
+    vector<TrainerRecord> trainers;
+    vector<PokemonRecord> pokemons;
+    vector<ItemRecord> items;
+    vector<LocationRecord> locations;
+    vector<uint32_t> location_trainers;
+    unordered_map<const Trainer*,uint32_t> trainer_indices;
+
+    StringRef AddString(const string& str) {
+        StringRef ref = {(uint32_t)strings.size(), (uint32_t)str.size()};
+        strings.insert(strings.end(), str.begin(), str.end());
+        return ref;
+    }
+
+    // Adds a string shared by many records (species and location names)
+    // only once.
+    StringRef InternString(const string& str) {
+        unordered_map<string,StringRef>::const_iterator it =
+                interned_strings.find(str);
+        if (it != interned_strings.end()) {
+            return it->second;
+        }
+        StringRef ref = AddString(str);
+        interned_strings.insert({str, ref});
+        return ref;
+    }
+
+    void AddPokemon(const Pokemon& pokemon) {
+        PokemonRecord record = {pokemon.hp, pokemon.cp, pokemon.hit_power,
+                                InternString(pokemon.Species()), pokemon.level,
+                                pokemon.types, 0};
+        pokemons.push_back(record);
+    }
+
+    void AddItem(const Item& item) {
+        ItemRecord record = {item.Type(), item.Level()};
+        items.push_back(record);
+    }
+
+    LocationRecord& AddLocation(const Location& location, const string& name,
+                                size_t inventory) {
+        LocationRecord record = {InternString(name), location.Kind(),
+                                 (uint32_t)location.trainers_.size(),
+                                 (uint32_t)inventory, NO_LEADER, 0, false};
+        locations.push_back(record);
+        for (const Trainer* trainer : location.trainers_) {
+            location_trainers.push_back(trainer_indices.at(trainer));
+        }
+        return locations.back();
+    }
+};
+// -------------------------------------------------------------------------- //
+//                                  READER                                    //
+// -------------------------------------------------------------------------- //
+class SnapshotFile::Reader {
+public:
+    Reader(PokemonGo& game, const MappedFile& file) :
+            game(game), world(*game.world_ptr) {
+        memcpy(&header, file.data, sizeof(header));
+        if (!equal(header.magic, header.magic + sizeof(MAGIC), MAGIC) ||
+            header.version != VERSION) {
+            throw SnapshotInvalidFileException();
+        }
+        // Finds the sections, checking their sizes before multiplying them.
+        const char* section = file.data + sizeof(header);
+        size_t remaining = file.size - sizeof(header);
+        for (int i = 0; i < SECTIONS_NUM; ++i) {
+            if (header.counts[i] > remaining / RECORD_SIZES[i] ||
+                header.counts[i] > UINT32_MAX) {
+                throw SnapshotInvalidFileException();
+            }
+            size_t bytes = header.counts[i] * RECORD_SIZES[i];
+            if (bytes + padding(bytes) > remaining) {
+                throw SnapshotInvalidFileException();
+            }
+            sections[i] = section;
+            section += bytes + padding(bytes);
+            remaining -= bytes + padding(bytes);
+        }
+        if (remaining != 0) {
+            throw SnapshotInvalidFileException();
+        }
+        Checksum checksum;
+        checksum.Add(file.data + sizeof(header),
+                     file.size - sizeof(header));
+        if (checksum.Value() != header.checksum) {
+            throw SnapshotInvalidFileException();
+        }
+        strings = sections[STRINGS];
+        trainers = (const TrainerRecord*)sections[TRAINERS];
+        pokemons = (const PokemonRecord*)sections[POKEMONS];
+        items = (const ItemRecord*)sections[ITEMS];
+        locations = (const LocationRecord*)sections[LOCATIONS];
+        location_trainers = (const uint32_t*)sections[LOCATION_TRAINERS];
+    }
+
+    // Checks every record of the file, before anything in the game changes.
+    void Check() {
+        uint64_t trainer_pokemons = 0, trainer_items = 0;
+        for (uint32_t i = 0; i < Count(TRAINERS); ++i) {
+            const TrainerRecord& record = trainers[i];
+            CheckString(record.name, true);
+            // Names are unique and in the order of the trainers map.
+            if ((i > 0 && !IsLess(trainers[i - 1].name, record.name)) ||
+                record.team < 0 || record.team >= TEAMS_NUM) {
+                throw SnapshotInvalidFileException();
+            }
+            trainer_pokemons += record.pokemons;
+            trainer_items += record.items;
+        }
+        for (uint32_t i = 0; i < Count(POKEMONS); ++i) {
+            const PokemonRecord& record = pokemons[i];
+            CheckString(record.species, true);
+            if (record.level <= 0 || !(record.cp >= 0) ||
+                (record.types >> TYPES_NUM) != 0) {
+                throw SnapshotInvalidFileException();
+            }
+        }
+        for (uint32_t i = 0; i < Count(ITEMS); ++i) {
+            if ((items[i].type != CANDY && items[i].type != POTION) ||
+                items[i].level < 1) {
+                throw SnapshotInvalidFileException();
+            }
+        }
+        CheckLocations(trainer_pokemons, trainer_items);
+    }
+
+    // Replaces the state of the game with the checked records.
+    void Apply() {
+        game.trainers.clear();
+        const PokemonRecord* pokemon = pokemons;
+        const ItemRecord* item = items;
+        vector<Trainer*> restored_trainers(Count(TRAINERS));
+        for (uint32_t i = 0; i < Count(TRAINERS); ++i) {
+            const TrainerRecord& record = trainers[i];
+            string name = String(record.name);
+            Trainers_Itr it = game.trainers.emplace_hint(
+                    game.trainers.end(), piecewise_construct,
+                    forward_as_tuple(name),
+                    forward_as_tuple(name, (Team)record.team));
+            Trainer& trainer = it->second;
+            trainer.level = record.level;
+            trainer.score = record.score;
+            trainer.is_a_gym_leader = record.is_gym_leader != 0;
+            trainer.has_won_last_battle = record.has_won_last_battle != 0;
+            trainer.location = String(locations[trainer_locations[i]].name);
+            for (uint32_t j = 0; j < record.pokemons; ++j) {
+                trainer.AddPokemon(MakePokemon(*pokemon++));
+            }
+            for (uint32_t j = 0; j < record.items; ++j) {
+                trainer.items.push_back(MakeItem(*item++));
+            }
+            restored_trainers[i] = &trainer;
+        }
+        const uint32_t* location_trainer = location_trainers;
+        for (uint32_t i = 0; i < Count(LOCATIONS); ++i) {
+            const LocationRecord& record = locations[i];
+            Location& location = *restored_locations[i];
+            location.trainers_.clear();
+            location.trainers_.reserve(record.trainers);
+            for (uint32_t j = 0; j < record.trainers; ++j) {
+                location.trainers_.push_back(
+                        restored_trainers[*location_trainer++]);
+            }
+            switch (record.kind) {
+                case GYM: {
+                    Gym& gym = static_cast<Gym&>(location);
+                    for (int team = 0; team < TEAMS_NUM; ++team) {
+                        gym.team_index[team].clear();
+                    }
+                    gym.index_keys.clear();
+                    gym.index_keys.reserve(record.trainers);
+                    gym.arrivals = 0;
+                    for (Trainer* trainer : gym.trainers_) {
+                        gym.AddToIndex(*trainer);
+                    }
+                    gym.is_taken = record.is_taken != 0;
+                    gym.gym_leader = record.is_taken != 0 ?
+                                     restored_trainers[record.leader] : NULL;
+                    gym.gym_team_color = (Team)record.gym_team;
+                    break;
+                }
+                case POKESTOP: {
+                    Pokestop& pokestop = static_cast<Pokestop&>(location);
+                    pokestop.items.clear();
+                    for (uint32_t j = 0; j < record.inventory; ++j) {
+                        pokestop.items.push_back(MakeItem(*item++));
+                    }
+                    break;
+                }
+                case STARBUCKS: {
+                    Starbucks& starbucks = static_cast<Starbucks&>(location);
+                    starbucks.pokemons.clear();
+                    for (uint32_t j = 0; j < record.inventory; ++j) {
+                        starbucks.pokemons.push_back(MakePokemon(*pokemon++));
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+private:
+    PokemonGo& game;
+    const World& world;
+    Header header;
+    const char* sections[SECTIONS_NUM];
+    const char* strings;
+    const TrainerRecord* trainers;
+    const PokemonRecord* pokemons;
+    const ItemRecord* items;
+    const LocationRecord* locations;
+    const uint32_t* location_trainers;
+    // The location of every trainer, and the location of the world of every
+    // location record.
+    vector<uint32_t> trainer_locations;
+    vector<Location*> restored_locations;
+    // A Pokemon of every species, keyed by the offset of the species name.
+    unordered_map<uint32_t,Pokemon> species_pokemons;
+
+    uint32_t Count(Section section) const {
+        return (uint32_t)header.counts[section];
+    }
+
+    void CheckString(const StringRef& ref, bool non_empty) const {
+        if (ref.offset > Count(STRINGS) ||
+            ref.length > Count(STRINGS) - ref.offset ||
+            (non_empty && ref.length == 0)) {
+            throw SnapshotInvalidFileException();
+        }
+    }
+
+    string String(const StringRef& ref) const {
+        return string(strings + ref.offset, ref.length);
+    }
+
+    // Same order as std::string::compare.
+    bool IsLess(const StringRef& lhs, const StringRef& rhs) const {
+        int compared = memcmp(strings + lhs.offset, strings + rhs.offset,
+                              min(lhs.length, rhs.length));
+        return compared < 0 || (compared == 0 && lhs.length < rhs.length);
+    }
+
+    // Checks that the location records are the locations of the world, and
+    // that every trainer is in exactly one of them.
+    void CheckLocations(uint64_t trainer_pokemons, uint64_t trainer_items) {
+        if (Count(LOCATIONS) != world.gyms.size() + world.pokestops.size() +
+                                world.starbucks.size()) {
+            throw SnapshotInvalidFileException();
+        }
+        trainer_locations.assign(Count(TRAINERS), NO_LOCATION);
+        restored_locations.resize(Count(LOCATIONS));
+        unordered_set<const Location*> seen_locations;
+        uint64_t location_trainers_count = 0;
+        uint64_t pokemons_count = trainer_pokemons;
+        uint64_t items_count = trainer_items;
+        for (uint32_t i = 0; i < Count(LOCATIONS); ++i) {
+            const LocationRecord& record = locations[i];
+            CheckString(record.name, true);
+            string name = String(record.name);
+            if (record.kind >= LOCATION_KINDS_NUM || !world.Contains(name) ||
+                world[name]->Kind() != (LocationKind)record.kind ||
+                !seen_locations.insert(world[name]).second ||
+                record.trainers > Count(LOCATION_TRAINERS) -
+                                  location_trainers_count) {
+                throw SnapshotInvalidFileException();
+            }
+            restored_locations[i] = world[name];
+            for (uint32_t j = 0; j < record.trainers; ++j) {
+                uint32_t trainer =
+                        location_trainers[location_trainers_count++];
+                if (trainer >= Count(TRAINERS) ||
+                    trainer_locations[trainer] != NO_LOCATION) {
+                    throw SnapshotInvalidFileException();
+                }
+                trainer_locations[trainer] = i;
+            }
+            switch (record.kind) {
+                case GYM:
+                    if (record.inventory != 0 || (record.is_taken != 0 && (
+                            record.leader < 0 ||
+                            (uint32_t)record.leader >= Count(TRAINERS) ||
+                            trainer_locations[record.leader] != i ||
+                            record.gym_team < 0 ||
+                            record.gym_team >= TEAMS_NUM))) {
+                        throw SnapshotInvalidFileException();
+                    }
+                    break;
+                case POKESTOP:
+                    items_count += record.inventory;
+                    break;
+                case STARBUCKS:
+                    pokemons_count += record.inventory;
+                    break;
+            }
+        }
+        if (location_trainers_count != Count(LOCATION_TRAINERS) ||
+            pokemons_count != Count(POKEMONS) || items_count != Count(ITEMS)) {
+            throw SnapshotInvalidFileException();
+        }
+        for (uint32_t location : trainer_locations) {
+            if (location == NO_LOCATION) {
+                throw SnapshotInvalidFileException();
+            }
+        }
+    }
+
+    Pokemon MakePokemon(const PokemonRecord& record) {
+        unordered_map<uint32_t,Pokemon>::iterator it =
+                species_pokemons.find(record.species.offset);
+        if (it == species_pokemons.end()) {
+            it = species_pokemons.insert(
+                    {record.species.offset,
+                     Pokemon(String(record.species), 0, 1)}).first;
+        }
+        Pokemon pokemon(it->second);
+        pokemon.types = record.types;
+        pokemon.types_value = Pokemon::calcTypesValue(record.types);
+        pokemon.level = record.level;
+        pokemon.hp = record.hp;
+        pokemon.cp = record.cp;
+        pokemon.hit_power = record.hit_power;
+        return pokemon;
+    }
+
+    static Item MakeItem(const ItemRecord& record) {
+        if (record.type == CANDY) {
+            return Candy(record.level);
+        }
+        return Potion(record.level);
+    }
+};
+// -------------------------------------------------------------------------- //
+//                                FUNCTIONS                                   //
+// -------------------------------------------------------------------------- //
+void SnapshotFile::Write(const PokemonGo& game, const std::string& path) {
+    Writer(game).WriteTo(path);
+}
+//------------------------------------------------------------------------------
+void SnapshotFile::Read(PokemonGo& game, const std::string& path) {
+    MappedFile file(path);
+    Reader reader(game, file);
+    reader.Check();
+    reader.Apply();
+}
+//------------------------------------------------------------------------------
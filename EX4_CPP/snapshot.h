@@ -0,0 +1,51 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+namespace mtm {
+namespace pokemongo {
+
+class PokemonGo;
+
+// Reads and writes snapshot files of the state of PokemonGo games (see
+// PokemonGo::Snapshot and PokemonGo::Restore).
+//
+// A snapshot is a header followed by sections of fixed-size records: the
+// strings, the trainers, the Pokemons and items of the trainers followed by
+// those of the locations, the locations, and the trainers of every location.
+// Records refer to each other by index, and to strings by offset. The header
+// holds the format version, the size of every section and a checksum of the
+// sections. Numbers are written in the byte order of the writing machine.
+//
+// Restoring maps the file into memory and checks it whole before building the
+// new state from the records in place.
+class SnapshotFile {
+ public:
+  static const uint32_t VERSION = 1;
+
+  // Writes the snapshot to path + ".tmp" and renames it to path, so path
+  // holds either the previous snapshot or the whole new one.
+  //
+  // @param game the game to write.
+  // @param path the path of the file.
+  // @throw SnapshotIOException if the file cannot be written.
+  static void Write(const PokemonGo& game, const std::string& path);
+
+  // @param game the game whose state is replaced.
+  // @param path the path of the file.
+  // @throw SnapshotIOException if the file cannot be read.
+  // @throw SnapshotInvalidFileException if the file is not a valid snapshot,
+  //        or does not match the world of the game.
+  static void Read(PokemonGo& game, const std::string& path);
+
+ private:
+  class Writer;
+  class Reader;
+};
+
+}  // namespace pokemongo
+}  // namespace mtm
+
+#endif  // SNAPSHOT_H
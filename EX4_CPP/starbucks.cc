@@ -1,6 +1,7 @@
 // -------------------------------------------------------------------------- //
 //                             INCLUDES & DEFINES                             //
 // -------------------------------------------------------------------------- //
+#include "instrumentation.h"
 #include "starbucks.h"
 
 using namespace mtm::pokemongo;
@@ -9,15 +10,22 @@ using namespace std;
 // -------------------------------------------------------------------------- //
 //                                FUNCTIONS                                   //
 // -------------------------------------------------------------------------- //
+void Starbucks::Refill(const std::vector<Pokemon>& pokemons) {
+    this->pokemons.insert(this->pokemons.end(), pokemons.begin(),
+                          pokemons.end());
+}
+//------------------------------------------------------------------------------
 void Starbucks::Arrive(Trainer& trainer) {
-    Pokemon& first_pokemon = pokemons.front();
-    if (trainer.TryToCatch(first_pokemon)) {
-        this->pokemons.remove(first_pokemon);
+    POKEMONGO_TIME(OPERATION_STARBUCKS_ARRIVE);
+    if (!pokemons.empty() && trainer.TryToCatch(pokemons.front())) {
+        POKEMONGO_COUNT(COUNTER_POKEMONS_CAUGHT);
+        this->pokemons.pop_front();
     }
     Location::Arrive(trainer);
 }
 //------------------------------------------------------------------------------
 void Starbucks::Leave(Trainer& trainer) {
+    POKEMONGO_TIME(OPERATION_STARBUCKS_LEAVE);
     Location::Leave(trainer);
 }
 //------------------------------------------------------------------------------
\ No newline at end of file
@@ -2,7 +2,9 @@
 #define STARBUCKS_H
 
 #include <iostream>
+#include <deque>
 #include <list>
+#include <vector>
 #include "location.h"
 #include "trainer.h"
 #include "item.h"
@@ -13,12 +15,23 @@ namespace mtm {
 
         private:
             std::string name;
-            std::list<Pokemon> pokemons;
+            std::deque<Pokemon> pokemons;
 
         public:
+            // Saves and restores the state of the location.
+            friend class SnapshotFile;
+
             Starbucks(const std::string& name, std::list<Pokemon> pokemons):
-                    name(name), pokemons(pokemons) {};
+                    Location(STARBUCKS), name(name),
+                    pokemons(pokemons.begin(), pokemons.end()) {};
             ~Starbucks() = default;
+
+            // Adds Pokemons to the end of the Starbucks queue, after the
+            // Pokemons already waiting there.
+            //
+            // @param pokemons the Pokemons to add, in the order they should be
+            //        offered to arriving trainers.
+            void Refill(const std::vector<Pokemon>& pokemons);
             void Arrive(Trainer& trainer) override;
             void Leave(Trainer& trainer) override;
         };
@@ -0,0 +1,128 @@
+#include <cstdlib>
+#include "test_utils.h"
+#include "../battle_kernel.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int CROSS_CHECK_BATTLES = 10000;
+//------------------------------------------------------------------------------
+static void AddSide(BattleSide& side, int battle, bool has_pokemon, double cp,
+                    int item, Team team, int level) {
+    side.has_pokemon[battle] = has_pokemon;
+    side.hp[battle] = 100;
+    side.cp[battle] = cp;
+    side.hit_power[battle] = cp;
+    side.pokemon_level[battle] = 1;
+    side.item[battle] = item;
+    side.team[battle] = team;
+    side.level[battle] = level;
+    side.score[battle] = 0;
+}
+//------------------------------------------------------------------------------
+// Returns "<level>/<cp>/<hp>" as printed for the strongest Pokemon of trainer.
+static string PrintedStats(const Trainer& trainer) {
+    ostringstream output;
+    output << trainer.GetStrongestPokemon();
+    string printed = output.str();
+    size_t begin = printed.find('(') + 1;
+    return printed.substr(begin, printed.find(')') - begin);
+}
+//------------------------------------------------------------------------------
+static string PrintedStats(const BattleSide& side, int battle) {
+    ostringstream output;
+    output << side.pokemon_level[battle] << "/" << side.cp[battle] << "/"
+           << side.hp[battle];
+    return output.str();
+}
+//------------------------------------------------------------------------------
+bool TestResolveBattlesRewards() {
+    BattleSide self, rival;
+    BattleResults results;
+    self.Resize(4);
+    rival.Resize(4);
+    AddSide(self, 0, true, 50, NO_ITEM, RED, 3);
+    AddSide(rival, 0, true, 20, NO_ITEM, BLUE, 5);
+    AddSide(self, 1, false, 0, NO_ITEM, RED, 3);
+    AddSide(rival, 1, false, 0, NO_ITEM, BLUE, 4);
+    AddSide(self, 2, true, 20, NO_ITEM, RED, 2);
+    AddSide(rival, 2, true, 20, NO_ITEM, YELLOW, 2);
+    AddSide(self, 3, true, 20, NO_ITEM, RED, 2);
+    AddSide(rival, 3, true, 20, NO_ITEM, RED, 2);
+    ResolveBattles(self, rival, results);
+    ASSERT_EQUAL(1, results.winner[0]);
+    ASSERT_EQUAL(6, self.level[0]);
+    ASSERT_EQUAL(2, self.score[0]);
+    ASSERT_EQUAL(-1, rival.score[0]);
+    ASSERT_EQUAL(-1, results.winner[1]);
+    ASSERT_EQUAL(6, rival.level[1]);
+    ASSERT_EQUAL(1, results.winner[2]);
+    ASSERT_EQUAL(0, results.winner[3]);
+    ASSERT_EQUAL(2, self.level[3]);
+    ASSERT_EQUAL(0, rival.score[3]);
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestResolveBattlesMatchesTrainerBattle() {
+    const Team teams[] = {BLUE, YELLOW, RED};
+    const double cps[] = {20, 50, 50, 100, 150};
+    BattleSide self, rival;
+    BattleResults results;
+    self.Resize(CROSS_CHECK_BATTLES);
+    rival.Resize(CROSS_CHECK_BATTLES);
+    vector<Trainer> self_trainers, rival_trainers;
+    srand(234122);
+    for (int i = 0; i < CROSS_CHECK_BATTLES; ++i) {
+        BattleSide* sides[] = {&self, &rival};
+        vector<Trainer>* trainers[] = {&self_trainers, &rival_trainers};
+        for (int side = 0; side < 2; ++side) {
+            bool has_pokemon = rand() % 8 != 0;
+            double cp = cps[rand() % 5];
+            int item = rand() % 3 - 1;
+            Team team = teams[rand() % 3];
+            Trainer trainer("Ash", team);
+            if (has_pokemon) {
+                Pokemon pokemon("Pikachu", cp, 1);
+                trainer.TryToCatch(pokemon);
+            }
+            if (item == CANDY) trainer.AddItem(Candy(1));
+            if (item == POTION) trainer.AddItem(Potion(1));
+            trainers[side]->push_back(trainer);
+            AddSide(*sides[side], i, has_pokemon, cp, item, team, 1);
+        }
+    }
+    ResolveBattles(self, rival, results);
+    for (int i = 0; i < CROSS_CHECK_BATTLES; ++i) {
+        Trainer& self_trainer = self_trainers[i];
+        Trainer& rival_trainer = rival_trainers[i];
+        bool self_had_pokemon = self_trainer.HasPokemons();
+        bool rival_had_pokemon = rival_trainer.HasPokemons();
+        self_trainer.Battle(rival_trainer);
+        ASSERT_EQUAL(results.winner[i] == 1, self_trainer.HasWonLastBattle());
+        ASSERT_EQUAL(results.winner[i] == -1,
+                     rival_trainer.HasWonLastBattle());
+        ASSERT_EQUAL(self.level[i], self_trainer.Level());
+        ASSERT_EQUAL(rival.level[i], rival_trainer.Level());
+        ASSERT_EQUAL(self.score[i], self_trainer.Score());
+        ASSERT_EQUAL(rival.score[i], rival_trainer.Score());
+        ASSERT_EQUAL(self_had_pokemon && !results.self_pokemon_removed[i],
+                     self_trainer.HasPokemons());
+        ASSERT_EQUAL(rival_had_pokemon && !results.rival_pokemon_removed[i],
+                     rival_trainer.HasPokemons());
+        if (self_trainer.HasPokemons()) {
+            ASSERT_EQUAL(PrintedStats(self, i), PrintedStats(self_trainer));
+        }
+        if (rival_trainer.HasPokemons()) {
+            ASSERT_EQUAL(PrintedStats(rival, i), PrintedStats(rival_trainer));
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestResolveBattlesRewards);
+    RUN_TEST(TestResolveBattlesMatchesTrainerBattle);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,415 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../battle_kernel.h"
+#include "../instrumentation.h"
+#include "../pokemon_go.h"
+#include "../pokemon_go_fork.h"
+#include "../simulator.h"
+#include "../starbucks.h"
+#include "../trainer.h"
+#include "../world.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+#define RUN_BENCHMARK(b) do {\
+	Clock::time_point start = Clock::now(); \
+	b(); \
+	chrono::duration<double,milli> elapsed = Clock::now() - start; \
+	std::cerr << #b << ": " << elapsed.count() << " ms" << std::endl; \
+	} while (0)
+
+static const int TRAINER_POKEMONS = 10000;
+static const int BENCHMARK_ROUNDS = 100000;
+static const int CATCH_KILL_CYCLES = 5000000;
+static const int POKEMONS_NUM = 10000000;
+static const int STARBUCKS_POKEMONS = 1000000;
+static const int STARBUCKS_REFILL = 1000;
+static const int LOCATION_MOVES = 100000000;
+static const int KERNEL_BATTLES = 1000000;
+static const int KERNEL_ROUNDS = 100;
+static const int SIMULATION_TRIALS = 1000;
+static const int SIMULATION_LOCATIONS = 400;
+static const int SESSION_TRAINERS = 10000;
+static const int SESSION_MOVES = 1000000;
+static const int SNAPSHOT_TRAINERS = 1000000;
+static const int SNAPSHOT_LOCATIONS = 10000;
+static const int FORK_TRAINERS = 100000;
+static const int FORK_QUERIES = 1000;
+static const int FORK_MOVES = 100;
+static const int SPATIAL_LOCATIONS = 1000000;
+static const int SPATIAL_TRAINERS = 1000000;
+static const int SPATIAL_QUERIES = 100000;
+static const int SPATIAL_RADIUS = 5;
+static const int INSTRUMENTED_TRAINERS = 10000;
+static const int INSTRUMENTED_MOVES = 1000000;
+static const int INSTRUMENTED_RUNS = 5;
+//------------------------------------------------------------------------------
+static void FillTrainer(Trainer& trainer, int pokemons) {
+    for (int i = 0; i < pokemons; ++i) {
+        Pokemon pokemon("Pikachu", (i * 7919) % pokemons + 1, 1);
+        trainer.TryToCatch(pokemon);
+    }
+}
+//------------------------------------------------------------------------------
+void BenchmarkTrainerGetStrongestPokemon() {
+    Trainer ash("Ash", RED);
+    Trainer gary("Gary", BLUE);
+    FillTrainer(ash, TRAINER_POKEMONS);
+    FillTrainer(gary, TRAINER_POKEMONS);
+    int ash_stronger = 0;
+    for (int i = 0; i < BENCHMARK_ROUNDS; ++i) {
+        if (ash > gary || ash == gary) ash_stronger++;
+    }
+    cerr << "(" << ash_stronger << ") ";
+}
+//------------------------------------------------------------------------------
+void BenchmarkTrainerKillStrongestPokemon() {
+    Trainer ash("Ash", RED);
+    FillTrainer(ash, TRAINER_POKEMONS);
+    for (int i = 0; i < TRAINER_POKEMONS; ++i) {
+        ash.KillStrongestPokemon();
+    }
+}
+//------------------------------------------------------------------------------
+void BenchmarkTrainerCatchKillCycles() {
+    Trainer ash("Ash", RED);
+    FillTrainer(ash, TRAINER_POKEMONS);
+    Pokemon raichu("Raichu", 2.0 * TRAINER_POKEMONS, 1);
+    for (int i = 0; i < CATCH_KILL_CYCLES; ++i) {
+        ash.TryToCatch(raichu);
+        ash.KillStrongestPokemon();
+    }
+}
+//------------------------------------------------------------------------------
+void BenchmarkPokemonCopyAndCompare() {
+    const char* species[] = {"Pikachu", "Raichu", "Charmander", "Bulbasaur"};
+    vector<Pokemon> pokemons;
+    pokemons.reserve(POKEMONS_NUM);
+    for (int i = 0; i < POKEMONS_NUM; ++i) {
+        pokemons.push_back(Pokemon(species[i % 4], i % 100 + 1, 1));
+    }
+    vector<Pokemon> copies(pokemons);
+    int equal = 0;
+    for (int i = 0; i < POKEMONS_NUM; ++i) {
+        if (copies[i] == pokemons[(i + 100) % POKEMONS_NUM]) equal++;
+    }
+    cerr << "(" << equal << " equal, " << sizeof(Pokemon) << " bytes per "
+         << "Pokemon, " << POKEMONS_NUM * sizeof(Pokemon) / (1024 * 1024)
+         << " MB per copy) ";
+}
+//------------------------------------------------------------------------------
+void BenchmarkPokemonConstructFromSpecies() {
+    const string species[] = {"Pikachu", "Raichu", "Charmander", "Bulbasaur",
+                              "Squirtle", "Snorlax", "Mew", "Ditto"};
+    double total_hit_power = 0;
+    for (int i = 0; i < POKEMONS_NUM; ++i) {
+        Pokemon pokemon(species[i % 8], i % 100 + 1, 1);
+        total_hit_power += pokemon.HitPower();
+    }
+    cerr << "(" << total_hit_power << ") ";
+}
+//------------------------------------------------------------------------------
+void BenchmarkStarbucksArriveAndRefill() {
+    Starbucks starbucks("shani", list<Pokemon>());
+    vector<Pokemon> spawns(STARBUCKS_REFILL, Pokemon("Pikachu", 2.5, 1));
+    Trainer ash("Ash", RED);
+    for (int i = 0; i < STARBUCKS_POKEMONS; i += STARBUCKS_REFILL) {
+        starbucks.Refill(spawns);
+        for (int j = 0; j < STARBUCKS_REFILL; ++j) {
+            starbucks.Arrive(ash);
+            starbucks.Leave(ash);
+            ash.KillStrongestPokemon();
+        }
+    }
+}
+//------------------------------------------------------------------------------
+void BenchmarkLocationVirtualDispatch() {
+    Gym gym("taub");
+    Pokestop pokestop("mikhlol", vector<Item>());
+    Starbucks starbucks("shani", list<Pokemon>());
+    Location* const locations[] = {&gym, &pokestop, &starbucks};
+    Trainer ash("Ash", RED);
+    for (int i = 0; i < LOCATION_MOVES; ++i) {
+        Location* location = locations[i % 3];
+        location->Arrive(ash);
+        location->Leave(ash);
+    }
+}
+//------------------------------------------------------------------------------
+void BenchmarkResolveBattles() {
+    BattleSide self, rival;
+    BattleResults results;
+    self.Resize(KERNEL_BATTLES);
+    rival.Resize(KERNEL_BATTLES);
+    for (int i = 0; i < KERNEL_BATTLES; ++i) {
+        BattleSide* sides[] = {&self, &rival};
+        for (int side = 0; side < 2; ++side) {
+            sides[side]->has_pokemon[i] = (i + side) % 8 != 0;
+            sides[side]->hp[i] = 100;
+            sides[side]->cp[i] = (i * (side + 3)) % 150 + 1;
+            sides[side]->hit_power[i] = sides[side]->cp[i];
+            sides[side]->pokemon_level[i] = 1;
+            sides[side]->item[i] = (i + side) % 3 - 1;
+            sides[side]->team[i] = (i + side) % 3;
+            sides[side]->level[i] = 1;
+            sides[side]->score[i] = 0;
+        }
+    }
+    Clock::time_point start = Clock::now();
+    for (int round = 0; round < KERNEL_ROUNDS; ++round) {
+        ResolveBattles(self, rival, results);
+    }
+    chrono::duration<double> elapsed = Clock::now() - start;
+    cerr << "(" << KERNEL_BATTLES * (double)KERNEL_ROUNDS / elapsed.count()
+         << " battles/s) ";
+}
+//------------------------------------------------------------------------------
+// Builds a grid of gyms, Pokestops and Starbucks, one kind per row.
+static World* BuildSimulationWorld(vector<string>& locations,
+                                   int count = SIMULATION_LOCATIONS) {
+    const char* kinds[] = {"GYM ", "POKESTOP ", "STARBUCKS "};
+    const char* inventories[] = {"", " POTION 10 CANDY 20 CANDY 13",
+                                 " pikachu 2.5 1 squirtle 4 1 mew 10 1"};
+    const int columns = 20;
+    World* world = new World();
+    for (int i = 0; i < count; ++i) {
+        int kind = (i / columns) % 3;
+        locations.push_back("l" + to_string(i));
+        istringstream input(kinds[kind] + locations.back() + inventories[kind]);
+        input >> *world;
+        if (i % columns != 0) {
+            world->Connect(locations[i - 1], locations[i], EAST, WEST);
+        }
+        if (i >= columns) {
+            world->Connect(locations[i - columns], locations[i], SOUTH, NORTH);
+        }
+    }
+    return world;
+}
+//------------------------------------------------------------------------------
+static void RunSimulation(int threads) {
+    vector<string> locations;
+    World* world = BuildSimulationWorld(locations);
+    SimulationConfig config;
+    config.trials = SIMULATION_TRIALS;
+    config.trainers_per_team = 50;
+    config.moves = 2000;
+    config.seed = 234122;
+    config.threads = threads;
+    config.spawn = SpawnUniformly(locations);
+    SimulationResults results = Simulate(*world, config);
+    ScoreSummary red = results.Summarize(RED);
+    cerr << "(RED mean " << red.mean << ", p90 " << red.p90 << ", wins "
+         << results.wins[RED] << "/" << SIMULATION_TRIALS << ") ";
+    delete world;
+}
+//------------------------------------------------------------------------------
+void BenchmarkSimulateSerial() {
+    RunSimulation(1);
+}
+//------------------------------------------------------------------------------
+void BenchmarkSimulateParallel() {
+    RunSimulation(0);
+}
+//------------------------------------------------------------------------------
+void BenchmarkEventLogReplay() {
+    vector<string> locations;
+    vector<string> names;
+    stringstream file;
+    chrono::duration<double,milli> commands_time, replay_time;
+    {
+        PokemonGo pokemon_go(BuildSimulationWorld(locations));
+        EventLog log(file);
+        pokemon_go.SetEventLog(&log);
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < SESSION_TRAINERS; ++i) {
+            names.push_back("trainer" + to_string(i));
+            pokemon_go.AddTrainer(names.back(), (Team)(i % 3),
+                                  locations[(i * 7919) % locations.size()]);
+        }
+        srand(234122);
+        for (int i = 0; i < SESSION_MOVES; ++i) {
+            try {
+                pokemon_go.MoveTrainer(names[rand() % SESSION_TRAINERS],
+                                       rand() % 4);
+            }
+            catch (PokemonGoReachedDeadEndException) {}
+        }
+        log.Close();
+        commands_time = Clock::now() - start;
+    }
+    EventReader reader(file);
+    locations.clear();
+    PokemonGo replayed(BuildSimulationWorld(locations));
+    Clock::time_point start = Clock::now();
+    replayed.Replay(reader, reader.Events().size());
+    replay_time = Clock::now() - start;
+    cerr << "(" << reader.Events().size() << " events, "
+         << file.str().size() / (1024 * 1024) << " MB, commands "
+         << commands_time.count() << " ms, replay " << replay_time.count()
+         << " ms) ";
+}
+//------------------------------------------------------------------------------
+void BenchmarkSnapshotRestore() {
+    const char* path = "benchmark_snapshot.bin";
+    vector<string> locations;
+    chrono::duration<double,milli> snapshot_time, restore_time;
+    {
+        PokemonGo pokemon_go(BuildSimulationWorld(locations,
+                                                  SNAPSHOT_LOCATIONS));
+        for (int i = 0; i < SNAPSHOT_TRAINERS; ++i) {
+            pokemon_go.AddTrainer("trainer" + to_string(i), (Team)(i % 3),
+                                  locations[i % locations.size()]);
+        }
+        Clock::time_point start = Clock::now();
+        pokemon_go.Snapshot(path);
+        snapshot_time = Clock::now() - start;
+    }
+    locations.clear();
+    PokemonGo restored(BuildSimulationWorld(locations, SNAPSHOT_LOCATIONS));
+    Clock::time_point start = Clock::now();
+    restored.Restore(path);
+    restore_time = Clock::now() - start;
+    cerr << "(" << SNAPSHOT_TRAINERS << " trainers, snapshot "
+         << snapshot_time.count() << " ms, restore " << restore_time.count()
+         << " ms) ";
+    remove(path);
+}
+//------------------------------------------------------------------------------
+void BenchmarkForkWhatIf() {
+    vector<string> locations, names;
+    Clock::time_point start = Clock::now();
+    PokemonGo pokemon_go(BuildSimulationWorld(locations, SNAPSHOT_LOCATIONS));
+    for (int i = 0; i < FORK_TRAINERS; ++i) {
+        names.push_back("trainer" + to_string(i));
+        pokemon_go.AddTrainer(names.back(), (Team)(i % 3),
+                              locations[i % locations.size()]);
+    }
+    chrono::duration<double,milli> build_time = Clock::now() - start;
+    srand(234122);
+    size_t copied_trainers = 0;
+    int red_change = 0;
+    start = Clock::now();
+    for (int i = 0; i < FORK_QUERIES; ++i) {
+        unique_ptr<PokemonGoFork> fork = pokemon_go.Fork();
+        for (int j = 0; j < FORK_MOVES; ++j) {
+            try {
+                fork->MoveTrainer(names[rand() % FORK_TRAINERS], rand() % 4);
+            }
+            catch (PokemonGoReachedDeadEndException) {}
+        }
+        red_change += fork->GetScoreChange(RED);
+        copied_trainers += fork->CopiedTrainers();
+    }
+    chrono::duration<double,micro> query_time = Clock::now() - start;
+    cerr << "(" << FORK_TRAINERS << " trainers, build " << build_time.count()
+         << " ms, fork + " << FORK_MOVES << " moves "
+         << query_time.count() / FORK_QUERIES << " us, "
+         << copied_trainers / FORK_QUERIES << " trainers copied, RED "
+         << red_change << ") ";
+}
+//------------------------------------------------------------------------------
+void BenchmarkTrainersWithinRadius() {
+    vector<string> locations;
+    PokemonGo pokemon_go(BuildSimulationWorld(locations, SPATIAL_LOCATIONS));
+    for (int i = 0; i < SPATIAL_TRAINERS; ++i) {
+        pokemon_go.AddTrainer("trainer" + to_string(i), (Team)(i % 3),
+                              locations[i % locations.size()]);
+    }
+    Clock::time_point start = Clock::now();
+    size_t found = pokemon_go.GetTrainersWithin(locations[0], 0).size();
+    chrono::duration<double,milli> index_time = Clock::now() - start;
+    srand(234122);
+    start = Clock::now();
+    for (int i = 0; i < SPATIAL_QUERIES; ++i) {
+        found += pokemon_go.GetTrainersWithin(
+                locations[rand() % locations.size()], SPATIAL_RADIUS).size();
+    }
+    chrono::duration<double,micro> query_time = Clock::now() - start;
+    cerr << "(" << SPATIAL_LOCATIONS << " locations, index "
+         << index_time.count() << " ms, radius " << SPATIAL_RADIUS << " "
+         << query_time.count() / SPATIAL_QUERIES << " us, "
+         << found / SPATIAL_QUERIES << " trainers) ";
+}
+//------------------------------------------------------------------------------
+// Build with and without -DPOKEMONGO_INSTRUMENTATION to compare. Reports the
+// fastest of several runs. As the runs vary by more than the overhead, the
+// instrumented build also measures the cost of a timed scope on its own, and
+// estimates the overhead from the number of scopes timed per move.
+void BenchmarkInstrumentationOverhead() {
+    vector<string> locations, names;
+    PokemonGo pokemon_go(BuildSimulationWorld(locations));
+    for (int i = 0; i < INSTRUMENTED_TRAINERS; ++i) {
+        names.push_back("trainer" + to_string(i));
+        pokemon_go.AddTrainer(names.back(), (Team)(i % 3),
+                              locations[i % locations.size()]);
+    }
+    Instrumentation::Reset();
+    double fastest = 0;
+    for (int run = 0; run < INSTRUMENTED_RUNS; ++run) {
+        srand(234122);
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < INSTRUMENTED_MOVES; ++i) {
+            try {
+                pokemon_go.MoveTrainer(names[rand() % INSTRUMENTED_TRAINERS],
+                                       rand() % 4);
+            }
+            catch (PokemonGoReachedDeadEndException) {}
+        }
+        chrono::duration<double,nano> elapsed = Clock::now() - start;
+        double per_move = elapsed.count() / INSTRUMENTED_MOVES;
+        fastest = run == 0 ? per_move : min(fastest, per_move);
+    }
+    cerr << "(instrumentation "
+         << (Instrumentation::ENABLED ? "enabled" : "disabled") << ", "
+         << fastest << " ns per move";
+    if (Instrumentation::ENABLED) {
+        ostringstream dump;
+        Instrumentation::DumpText(dump);
+        double scopes = 0;
+        for (int operation = 0; operation < OPERATIONS_NUM; ++operation) {
+            scopes += Instrumentation::Latency((Operation)operation).count;
+        }
+        scopes /= (double)INSTRUMENTED_MOVES * INSTRUMENTED_RUNS;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < INSTRUMENTED_MOVES; ++i) {
+            POKEMONGO_TIME(OPERATION_ADD_TRAINER);
+        }
+        chrono::duration<double,nano> elapsed = Clock::now() - start;
+        double per_scope = elapsed.count() / INSTRUMENTED_MOVES;
+        cerr << ", " << per_scope << " ns per timed scope, " << scopes
+             << " scopes per move, overhead "
+             << 100 * scopes * per_scope / (fastest - scopes * per_scope)
+             << "%) " << endl << dump.str();
+    } else {
+        cerr << ") ";
+    }
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_BENCHMARK(BenchmarkTrainerGetStrongestPokemon);
+    RUN_BENCHMARK(BenchmarkTrainerKillStrongestPokemon);
+    RUN_BENCHMARK(BenchmarkTrainerCatchKillCycles);
+    RUN_BENCHMARK(BenchmarkPokemonCopyAndCompare);
+    RUN_BENCHMARK(BenchmarkPokemonConstructFromSpecies);
+    RUN_BENCHMARK(BenchmarkStarbucksArriveAndRefill);
+    RUN_BENCHMARK(BenchmarkLocationVirtualDispatch);
+    RUN_BENCHMARK(BenchmarkResolveBattles);
+    RUN_BENCHMARK(BenchmarkSimulateSerial);
+    RUN_BENCHMARK(BenchmarkSimulateParallel);
+    RUN_BENCHMARK(BenchmarkEventLogReplay);
+    RUN_BENCHMARK(BenchmarkSnapshotRestore);
+    RUN_BENCHMARK(BenchmarkForkWhatIf);
+    RUN_BENCHMARK(BenchmarkTrainersWithinRadius);
+    RUN_BENCHMARK(BenchmarkInstrumentationOverhead);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,183 @@
+#include <cstddef>
+#include <cstdlib>
+#include <sstream>
+#include "test_utils.h"
+#include "../event_log.h"
+#include "../pokemon_go.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const char* WORLD_LINES[] = {
+        "GYM taub",
+        "GYM ulman",
+        "POKESTOP mikhlol POTION 10 CANDY 20 CANDY 13 POTION 5",
+        "STARBUCKS shani pikachu 2.5 1 pikachu 1 1 charmander 3.45 1",
+        "STARBUCKS amado squirtle 4 1 bulbasaur 2 1 mew 10 1"};
+static const char* LOCATIONS[] = {"taub", "ulman", "mikhlol", "shani", "amado"};
+static const int LOCATIONS_NUM = 5;
+static const int TRAINERS_NUM = 12;
+static const int MOVES_NUM = 500;
+//------------------------------------------------------------------------------
+static World* BuildWorld() {
+    World* world = new World();
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        istringstream input(WORLD_LINES[i]);
+        input >> *world;
+    }
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        world->Connect(LOCATIONS[i], LOCATIONS[(i + 1) % LOCATIONS_NUM],
+                       NORTH, SOUTH);
+    }
+    world->Connect("mikhlol", "amado", EAST, WEST);
+    return world;
+}
+//------------------------------------------------------------------------------
+// Plays the first commands of a fixed random session. Returns the number of
+// commands that changed the game.
+static int PlaySession(PokemonGo& pokemon_go, int commands) {
+    srand(234122);
+    int played = 0;
+    for (int i = 0; i < TRAINERS_NUM + MOVES_NUM && played < commands; ++i) {
+        int trainer = i < TRAINERS_NUM ? i : rand() % TRAINERS_NUM;
+        try {
+            if (i < TRAINERS_NUM) {
+                pokemon_go.AddTrainer("trainer" + to_string(trainer),
+                                      (Team)(trainer % TEAMS_NUM),
+                                      LOCATIONS[rand() % LOCATIONS_NUM]);
+            } else {
+                pokemon_go.MoveTrainer("trainer" + to_string(trainer),
+                                       rand() % 4);
+            }
+            played++;
+        }
+        catch (PokemonGoReachedDeadEndException) {}
+    }
+    return played;
+}
+//------------------------------------------------------------------------------
+// Returns the scores, trainer locations and location trainers of a game.
+static string Describe(PokemonGo& pokemon_go) {
+    // GetScore prints the trainers of the game.
+    ostringstream description, ignored;
+    streambuf* cout_buffer = cout.rdbuf(ignored.rdbuf());
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        description << pokemon_go.GetScore((Team)team) << endl;
+    }
+    cout.rdbuf(cout_buffer);
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        try {
+            description << pokemon_go.WhereIs("trainer" + to_string(i)) << endl;
+        }
+        catch (PokemonGoTrainerNotFoundExcpetion) {}
+    }
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        for (Trainer* trainer : pokemon_go.GetTrainersIn(LOCATIONS[i])) {
+            description << trainer->GetName() << " " << trainer->Level() << " "
+                        << trainer->IsGymLeader() << " ";
+            if (trainer->HasPokemons()) description << *trainer;
+        }
+    }
+    return description.str();
+}
+//------------------------------------------------------------------------------
+bool TestEventLogReplay() {
+    stringstream file;
+    int played;
+    PokemonGo logged(BuildWorld());
+    {
+        EventLog log(file, 16);
+        logged.SetEventLog(&log);
+        played = PlaySession(logged, TRAINERS_NUM + MOVES_NUM);
+    }
+    EventReader reader(file);
+    ASSERT_EQUAL(played, (int)reader.Events().size());
+    ASSERT_EQUAL(TRAINERS_NUM, (int)reader.TrainerNames().size());
+    ASSERT_EQUAL("trainer0", reader.TrainerNames()[0]);
+    for (int events : {0, 1, TRAINERS_NUM, TRAINERS_NUM + 37, played}) {
+        PokemonGo replayed(BuildWorld());
+        replayed.Replay(reader, events);
+        PokemonGo played_again(BuildWorld());
+        PlaySession(played_again, events);
+        ASSERT_EQUAL(Describe(played_again), Describe(replayed));
+    }
+    PokemonGo replayed(BuildWorld());
+    replayed.Replay(reader, played);
+    ASSERT_EQUAL(Describe(logged), Describe(replayed));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestEventLogReplayInvalidArgs() {
+    stringstream file;
+    {
+        EventLog log(file);
+        log.LogAddTrainer("ash", RED, "technion");
+        log.LogMoveTrainer("gary", NORTH, "taub");
+    }
+    EventReader reader(file);
+    PokemonGo pokemon_go(BuildWorld());
+    ASSERT_THROW(PokemonGoInvalidArgsException, pokemon_go.Replay(reader, 3));
+    ASSERT_THROW(PokemonGoLocationNotFoundException,
+                 pokemon_go.Replay(reader, 1));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestEventReaderInvalidFile() {
+    stringstream empty;
+    ASSERT_THROW(EventLogInvalidFileException, EventReader(empty));
+    stringstream file;
+    {
+        EventLog log(file);
+        log.LogAddTrainer("ash", RED, "taub");
+    }
+    string contents = file.str();
+    stringstream truncated(contents.substr(0, contents.size() - 1));
+    ASSERT_THROW(EventLogInvalidFileException, EventReader(truncated));
+    // The last record is the added trainer.
+    string bad_team_contents(contents);
+    bad_team_contents[contents.size() - sizeof(Event) +
+                      offsetof(Event, team)] = RED + 1;
+    stringstream bad_team(bad_team_contents);
+    ASSERT_THROW(EventLogInvalidFileException, EventReader(bad_team));
+    // The first record, after the magic and the version, introduces the name
+    // of the trainer.
+    string huge_name_contents(contents);
+    uint32_t huge_length = 0xFFFFFFF0;
+    huge_name_contents.replace(4 + sizeof(uint32_t) + offsetof(Event, location),
+                               sizeof(huge_length),
+                               (const char*)&huge_length, sizeof(huge_length));
+    stringstream huge_name(huge_name_contents);
+    ASSERT_THROW(EventLogInvalidFileException, EventReader(huge_name));
+    contents[0] = 'X';
+    stringstream bad_magic(contents);
+    ASSERT_THROW(EventLogInvalidFileException, EventReader(bad_magic));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestEventRing() {
+    EventRing ring(3);
+    Event event = {EVENT_ADD_TRAINER, 0, 0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+        event.trainer = i;
+        ASSERT_TRUE(ring.TryPush(event));
+    }
+    ASSERT_FALSE(ring.TryPush(event));
+    vector<Event> events;
+    ASSERT_EQUAL(4, (int)ring.Drain(events));
+    ASSERT_EQUAL(3, (int)events[3].trainer);
+    ASSERT_TRUE(ring.TryPush(event));
+    ASSERT_EQUAL(1, (int)ring.Drain(events));
+    ASSERT_EQUAL(0, (int)ring.Drain(events));
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestEventLogReplay);
+    RUN_TEST(TestEventLogReplayInvalidArgs);
+    RUN_TEST(TestEventReaderInvalidFile);
+    RUN_TEST(TestEventRing);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include "test_utils.h"
+#include "../instrumentation.h"
+#include "../pokemon_go.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const char* WORLD_LINES[] = {
+        "GYM taub",
+        "GYM ulman",
+        "POKESTOP mikhlol POTION 10 CANDY 20 CANDY 13 POTION 5",
+        "STARBUCKS shani pikachu 2.5 1 pikachu 1 1 charmander 3.45 1",
+        "STARBUCKS amado squirtle 4 1 bulbasaur 2 1 mew 10 1"};
+static const char* LOCATIONS[] = {"taub", "ulman", "mikhlol", "shani", "amado"};
+static const int LOCATIONS_NUM = 5;
+static const int TRAINERS_NUM = 12;
+static const int MOVES_NUM = 200;
+//------------------------------------------------------------------------------
+static World* BuildWorld() {
+    World* world = new World();
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        istringstream input(WORLD_LINES[i]);
+        input >> *world;
+    }
+    for (int i = 0; i < LOCATIONS_NUM - 1; ++i) {
+        world->Connect(LOCATIONS[i], LOCATIONS[i + 1], NORTH, SOUTH);
+    }
+    return world;
+}
+//------------------------------------------------------------------------------
+// Plays a fixed random session. Returns the number of moves to a dead end.
+static int PlaySession() {
+    PokemonGo pokemon_go(BuildWorld());
+    srand(234122);
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        pokemon_go.AddTrainer("trainer" + to_string(i), (Team)(i % TEAMS_NUM),
+                              LOCATIONS[rand() % LOCATIONS_NUM]);
+    }
+    int dead_ends = 0;
+    for (int i = 0; i < MOVES_NUM; ++i) {
+        try {
+            pokemon_go.MoveTrainer("trainer" + to_string(rand() % TRAINERS_NUM),
+                                   rand() % 2);
+        }
+        catch (PokemonGoReachedDeadEndException) {
+            dead_ends++;
+        }
+    }
+    return dead_ends;
+}
+//------------------------------------------------------------------------------
+static uint64_t Calls(const Operation& operation) {
+    return Instrumentation::Latency(operation).count;
+}
+//------------------------------------------------------------------------------
+bool TestInstrumentationCounts() {
+    Instrumentation::Reset();
+    int dead_ends = PlaySession();
+    if (!Instrumentation::ENABLED) {
+        ASSERT_EQUAL(0, (int)Calls(OPERATION_MOVE_TRAINER));
+        ASSERT_EQUAL(0, (int)Instrumentation::Count(COUNTER_DEAD_ENDS));
+        return true;
+    }
+    ASSERT_EQUAL(TRAINERS_NUM, (int)Calls(OPERATION_ADD_TRAINER));
+    ASSERT_EQUAL(MOVES_NUM, (int)Calls(OPERATION_MOVE_TRAINER));
+    ASSERT_EQUAL(dead_ends, (int)Instrumentation::Count(COUNTER_DEAD_ENDS));
+    uint64_t arrivals = Calls(OPERATION_GYM_ARRIVE) +
+                        Calls(OPERATION_POKESTOP_ARRIVE) +
+                        Calls(OPERATION_STARBUCKS_ARRIVE);
+    uint64_t leaves = Calls(OPERATION_GYM_LEAVE) +
+                      Calls(OPERATION_POKESTOP_LEAVE) +
+                      Calls(OPERATION_STARBUCKS_LEAVE);
+    ASSERT_EQUAL(TRAINERS_NUM + MOVES_NUM - dead_ends, (int)arrivals);
+    ASSERT_EQUAL(MOVES_NUM - dead_ends, (int)leaves);
+    ASSERT_TRUE(Instrumentation::Count(COUNTER_BATTLES) > 0);
+    ASSERT_TRUE(Instrumentation::Count(COUNTER_LEADER_CHANGES) > 0);
+    ASSERT_TRUE(Instrumentation::Count(COUNTER_POKEMONS_CAUGHT) > 0);
+    ASSERT_TRUE(Instrumentation::Count(COUNTER_ITEMS_PICKED) <= 4);
+
+    LatencyStats moves = Instrumentation::Latency(OPERATION_MOVE_TRAINER);
+    ASSERT_EQUAL(MOVES_NUM / Instrumentation::SAMPLE_PERIOD,
+                 (int)moves.samples);
+    ASSERT_TRUE(moves.mean > 0);
+    ASSERT_TRUE(moves.p50 <= moves.p90);
+    ASSERT_TRUE(moves.p90 <= moves.p99);
+    // The percentiles are the middles of buckets at most 1/16 wide.
+    ASSERT_TRUE(moves.p99 <= moves.max * (1 + 1.0 / 16) + 1);
+
+    Instrumentation::Reset();
+    ASSERT_EQUAL(0, (int)Calls(OPERATION_MOVE_TRAINER));
+    ASSERT_EQUAL(0, (int)Instrumentation::Count(COUNTER_BATTLES));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestInstrumentationThreads() {
+    Instrumentation::Reset();
+    int other_dead_ends = 0;
+    thread other([&other_dead_ends]() { other_dead_ends = PlaySession(); });
+    int dead_ends = PlaySession();
+    other.join();
+    dead_ends += other_dead_ends;
+    // The stats of the other thread are kept after it exits.
+    if (Instrumentation::ENABLED) {
+        ASSERT_EQUAL(2 * MOVES_NUM, (int)Calls(OPERATION_MOVE_TRAINER));
+        ASSERT_EQUAL(dead_ends, (int)Instrumentation::Count(COUNTER_DEAD_ENDS));
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestInstrumentationDump() {
+    Instrumentation::Reset();
+    PlaySession();
+    ostringstream text, json;
+    Instrumentation::DumpText(text);
+    Instrumentation::DumpJson(json);
+    if (!Instrumentation::ENABLED) {
+        ASSERT_EQUAL("{\"enabled\": false}\n", json.str());
+        return true;
+    }
+    ASSERT_TRUE(text.str().find("move_trainer: count=200 ") !=
+                string::npos);
+    ASSERT_TRUE(text.str().find("battles: ") != string::npos);
+    ASSERT_EQUAL(0, (int)json.str().find("{\"enabled\": true, \"counters\": "
+                                         "{\"battles\": "));
+    ASSERT_TRUE(json.str().find("\"move_trainer\": {\"count\": 200, "
+                                "\"samples\": 12, \"mean_ns\": ") !=
+                string::npos);
+    ASSERT_EQUAL("}}\n", json.str().substr(json.str().size() - 3));
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestInstrumentationCounts);
+    RUN_TEST(TestInstrumentationThreads);
+    RUN_TEST(TestInstrumentationDump);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,190 @@
+#include <cstdlib>
+#include <sstream>
+#include "test_utils.h"
+#include "../pokemon_go_fork.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const char* WORLD_LINES[] = {
+        "GYM taub",
+        "GYM ulman",
+        "POKESTOP mikhlol POTION 10 CANDY 20 CANDY 13 POTION 5",
+        "STARBUCKS shani pikachu 2.5 1 pikachu 1 1 charmander 3.45 1",
+        "STARBUCKS amado squirtle 4 1 bulbasaur 2 1 mew 10 1"};
+static const char* LOCATIONS[] = {"taub", "ulman", "mikhlol", "shani", "amado"};
+static const int LOCATIONS_NUM = 5;
+static const int TRAINERS_NUM = 30;
+//------------------------------------------------------------------------------
+static World* BuildWorld() {
+    World* world = new World();
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        istringstream input(WORLD_LINES[i]);
+        input >> *world;
+    }
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        world->Connect(LOCATIONS[i], LOCATIONS[(i + 1) % LOCATIONS_NUM],
+                       NORTH, SOUTH);
+    }
+    return world;
+}
+//------------------------------------------------------------------------------
+// Adds the trainers prefix0, prefix1, ... to a game (or a fork of a game).
+template <typename Game>
+static void AddTrainers(Game& game, const string& prefix, int trainers,
+                        unsigned int seed) {
+    srand(seed);
+    for (int i = 0; i < trainers; ++i) {
+        game.AddTrainer(prefix + to_string(i), (Team)(i % TEAMS_NUM),
+                        LOCATIONS[rand() % LOCATIONS_NUM]);
+    }
+}
+//------------------------------------------------------------------------------
+template <typename Game>
+static void MoveTrainers(Game& game, unsigned int seed, int moves) {
+    srand(seed);
+    for (int i = 0; i < moves; ++i) {
+        game.MoveTrainer("trainer" + to_string(rand() % TRAINERS_NUM),
+                         rand() % 2);
+    }
+}
+//------------------------------------------------------------------------------
+// Returns the scores, trainers and location trainers of a game.
+template <typename Game>
+static string Describe(Game& game) {
+    // PokemonGo::GetScore prints the trainers of the game.
+    ostringstream description, ignored;
+    streambuf* cout_buffer = cout.rdbuf(ignored.rdbuf());
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        description << game.GetScore((Team)team) << endl;
+    }
+    cout.rdbuf(cout_buffer);
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        for (const Trainer* trainer : game.GetTrainersIn(LOCATIONS[i])) {
+            description << trainer->GetName() << " "
+                        << game.WhereIs(trainer->GetName()) << " "
+                        << trainer->Level() << " " << trainer->Score() << " "
+                        << trainer->IsGymLeader() << " "
+                        << trainer->GetItems().size() << endl;
+            if (trainer->HasPokemons()) description << *trainer;
+        }
+    }
+    return description.str();
+}
+//------------------------------------------------------------------------------
+bool TestForkMatchesRebuiltGame() {
+    PokemonGo pokemon_go(BuildWorld());
+    AddTrainers(pokemon_go, "trainer", TRAINERS_NUM, 234122);
+    MoveTrainers(pokemon_go, 1, 300);
+    string description = Describe(pokemon_go);
+
+    unique_ptr<PokemonGoFork> fork = pokemon_go.Fork();
+    ASSERT_EQUAL(description, Describe(*fork));
+    MoveTrainers(*fork, 2, 300);
+    AddTrainers(*fork, "rookie", 10, 3);
+    MoveTrainers(*fork, 4, 300);
+
+    PokemonGo rebuilt(BuildWorld());
+    AddTrainers(rebuilt, "trainer", TRAINERS_NUM, 234122);
+    MoveTrainers(rebuilt, 1, 300);
+    MoveTrainers(rebuilt, 2, 300);
+    AddTrainers(rebuilt, "rookie", 10, 3);
+    MoveTrainers(rebuilt, 4, 300);
+    ASSERT_EQUAL(Describe(rebuilt), Describe(*fork));
+    ASSERT_EQUAL(description, Describe(pokemon_go));
+
+    // The game goes on as before once the fork is discarded.
+    fork.reset();
+    MoveTrainers(pokemon_go, 2, 300);
+    PokemonGo replayed(BuildWorld());
+    AddTrainers(replayed, "trainer", TRAINERS_NUM, 234122);
+    MoveTrainers(replayed, 1, 300);
+    MoveTrainers(replayed, 2, 300);
+    ASSERT_EQUAL(Describe(replayed), Describe(pokemon_go));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestForkOfFork() {
+    PokemonGo pokemon_go(BuildWorld());
+    AddTrainers(pokemon_go, "trainer", TRAINERS_NUM, 234122);
+    MoveTrainers(pokemon_go, 1, 300);
+    string description = Describe(pokemon_go);
+    unique_ptr<PokemonGoFork> fork = pokemon_go.Fork();
+    MoveTrainers(*fork, 2, 100);
+    string fork_description = Describe(*fork);
+
+    unique_ptr<PokemonGoFork> inner_fork = fork->Fork();
+    MoveTrainers(*inner_fork, 3, 300);
+    PokemonGo rebuilt(BuildWorld());
+    AddTrainers(rebuilt, "trainer", TRAINERS_NUM, 234122);
+    MoveTrainers(rebuilt, 1, 300);
+    MoveTrainers(rebuilt, 2, 100);
+    MoveTrainers(rebuilt, 3, 300);
+    ASSERT_EQUAL(Describe(rebuilt), Describe(*inner_fork));
+    ASSERT_EQUAL(fork_description, Describe(*fork));
+    ASSERT_EQUAL(description, Describe(pokemon_go));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestForkScoreChange() {
+    PokemonGo pokemon_go(BuildWorld());
+    AddTrainers(pokemon_go, "trainer", TRAINERS_NUM, 234122);
+    MoveTrainers(pokemon_go, 1, 300);
+    unique_ptr<PokemonGoFork> fork = pokemon_go.Fork();
+    unique_ptr<PokemonGoFork> unchanged = pokemon_go.Fork();
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        ASSERT_EQUAL(0, fork->GetScoreChange((Team)team));
+    }
+    ASSERT_EQUAL(0, (int)fork->CopiedTrainers());
+    ASSERT_EQUAL(0, (int)fork->CopiedLocations());
+
+    // A move copies the trainer, its two locations and at most the trainers
+    // that may become gym leaders.
+    fork->MoveTrainer("trainer7", NORTH);
+    ASSERT_TRUE(fork->CopiedTrainers() >= 1);
+    ASSERT_TRUE(fork->CopiedTrainers() <= 1 + TEAMS_NUM + 1);
+    ASSERT_EQUAL(2, (int)fork->CopiedLocations());
+    MoveTrainers(*fork, 2, 300);
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        ASSERT_EQUAL(fork->GetScore((Team)team) -
+                     unchanged->GetScore((Team)team),
+                     fork->GetScoreChange((Team)team));
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestForkInvalidArgs() {
+    PokemonGo pokemon_go(BuildWorld());
+    AddTrainers(pokemon_go, "trainer", TRAINERS_NUM, 234122);
+    unique_ptr<PokemonGoFork> fork = pokemon_go.Fork();
+    ASSERT_THROW(PokemonGoInvalidArgsException,
+                 fork->AddTrainer("", RED, "taub"));
+    ASSERT_THROW(PokemonGoTrainerNameAlreadyUsedExcpetion,
+                 fork->AddTrainer("trainer3", RED, "taub"));
+    ASSERT_THROW(PokemonGoLocationNotFoundException,
+                 fork->AddTrainer("ash", RED, "technion"));
+    ASSERT_THROW(PokemonGoTrainerNotFoundExcpetion,
+                 fork->MoveTrainer("ash", NORTH));
+    ASSERT_THROW(PokemonGoReachedDeadEndException,
+                 fork->MoveTrainer("trainer3", EAST));
+    ASSERT_THROW(PokemonGoTrainerNotFoundExcpetion, fork->WhereIs("ash"));
+    ASSERT_THROW(PokemonGoLocationNotFoundException,
+                 fork->GetTrainersIn("technion"));
+    ASSERT_EQUAL(0, (int)fork->CopiedTrainers());
+    fork->AddTrainer("ash", RED, "taub");
+    ASSERT_THROW(PokemonGoTrainerNameAlreadyUsedExcpetion,
+                 fork->Fork()->AddTrainer("ash", BLUE, "ulman"));
+    ASSERT_THROW(PokemonGoTrainerNotFoundExcpetion, pokemon_go.WhereIs("ash"));
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestForkMatchesRebuiltGame);
+    RUN_TEST(TestForkOfFork);
+    RUN_TEST(TestForkScoreChange);
+    RUN_TEST(TestForkInvalidArgs);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -1,3 +1,6 @@
+#include <string>
+#include <thread>
+#include <vector>
 #include "test_utils.h"
 #include "../pokemon.h"
 #include "../exceptions.h"
@@ -169,4 +172,30 @@ bool TestPokemonTrain() {
     ASSERT_THROW(PokemonInvalidArgsException, pikachu.Train(1));
     return true;
 }
-//------------------------------------------------------------------------------
\ No newline at end of file
+//------------------------------------------------------------------------------
+bool TestPokemonSpeciesFromThreads() {
+    const int THREADS_NUM = 4;
+    const int SPECIES_NUM = 200;
+    // One int per thread, as vector<bool> packs the flags into shared bytes.
+    vector<int> matches(THREADS_NUM, true);
+    vector<thread> threads;
+    for (int t = 0; t < THREADS_NUM; ++t) {
+        threads.push_back(thread([t, &matches]() {
+            for (int i = 0; i < SPECIES_NUM; ++i) {
+                string species = "Threadmon" + to_string((i + t) % SPECIES_NUM);
+                Pokemon pokemon(species, 1.0, 1);
+                if (pokemon.Species() != species) {
+                    matches[t] = false;
+                }
+            }
+        }));
+    }
+    for (thread& species_thread : threads) {
+        species_thread.join();
+    }
+    for (int t = 0; t < THREADS_NUM; ++t) {
+        ASSERT_TRUE(matches[t]);
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
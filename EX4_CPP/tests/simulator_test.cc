@@ -0,0 +1,180 @@
+#include <sstream>
+#include "test_utils.h"
+#include "../pokemon_go.h"
+#include "../simulator.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const char* WORLD_LINES[] = {
+        "GYM taub",
+        "GYM ulman",
+        "POKESTOP mikhlol POTION 10 CANDY 20 CANDY 13 POTION 5",
+        "STARBUCKS shani pikachu 2.5 1 pikachu 1 1 charmander 3.45 1",
+        "STARBUCKS amado squirtle 4 1 bulbasaur 2 1 mew 10 1"};
+static const char* LOCATIONS[] = {"taub", "ulman", "mikhlol", "shani", "amado"};
+static const int LOCATIONS_NUM = 5;
+//------------------------------------------------------------------------------
+// Builds a ring of the locations, with a dead end to the west of taub.
+static World* BuildWorld() {
+    World* world = new World();
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        istringstream input(WORLD_LINES[i]);
+        input >> *world;
+    }
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        world->Connect(LOCATIONS[i], LOCATIONS[(i + 1) % LOCATIONS_NUM],
+                       NORTH, SOUTH);
+    }
+    world->Connect("mikhlol", "amado", EAST, WEST);
+    return world;
+}
+//------------------------------------------------------------------------------
+static SimulationConfig Config(int trials, int threads) {
+    SimulationConfig config;
+    config.trials = trials;
+    config.trainers_per_team = 4;
+    config.moves = 200;
+    config.seed = 234122;
+    config.threads = threads;
+    config.spawn = SpawnUniformly(vector<string>(LOCATIONS,
+                                                 LOCATIONS + LOCATIONS_NUM));
+    return config;
+}
+//------------------------------------------------------------------------------
+bool TestSimulateIsReproducible() {
+    World* world = BuildWorld();
+    SimulationResults serial = Simulate(*world, Config(64, 1));
+    SimulationResults parallel = Simulate(*world, Config(64, 4));
+    ASSERT_TRUE(serial.scores == parallel.scores);
+    ASSERT_TRUE(serial.wins == parallel.wins);
+    SimulationConfig other_seed = Config(64, 4);
+    other_seed.seed++;
+    ASSERT_FALSE(Simulate(*world, other_seed).scores == serial.scores);
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        ASSERT_TRUE((*world)[LOCATIONS[i]]->GetTrainers().empty());
+    }
+    delete world;
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestSimulateMatchesPokemonGo() {
+    vector<string> spawns;
+    vector<pair<string,Direction>> moves;
+    SimulationConfig config = Config(1, 1);
+    SpawnPolicy spawn_uniformly = config.spawn;
+    config.spawn = [&](TrialRandom& random) {
+        spawns.push_back(spawn_uniformly(random));
+        return spawns.back();
+    };
+    config.move = [&](TrialRandom& random, const Trainer& trainer) {
+        Direction dir = (Direction)(random() % 4);
+        moves.push_back({trainer.GetName(), dir});
+        return dir;
+    };
+    World* world = BuildWorld();
+    SimulationResults results = Simulate(*world, config);
+    delete world;
+
+    PokemonGo pokemon_go(BuildWorld());
+    for (int i = 0; i < (int)spawns.size(); ++i) {
+        pokemon_go.AddTrainer(to_string(i), (Team)(i % TEAMS_NUM), spawns[i]);
+    }
+    for (const pair<string,Direction>& move : moves) {
+        try {
+            pokemon_go.MoveTrainer(move.first, move.second);
+        }
+        catch (PokemonGoReachedDeadEndException) {}
+    }
+    // GetScore prints the trainers of the game.
+    ostringstream ignored;
+    streambuf* cout_buffer = cout.rdbuf(ignored.rdbuf());
+    int scores[TEAMS_NUM];
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        scores[team] = pokemon_go.GetScore((Team)team);
+    }
+    cout.rdbuf(cout_buffer);
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        ASSERT_EQUAL(scores[team], results.scores[team][0]);
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestSimulateLogReplaysTrial() {
+    const int logged_trial = 5;
+    stringstream file;
+    SimulationConfig config = Config(8, 2);
+    World* world = BuildWorld();
+    SimulationResults results;
+    {
+        EventLog log(file);
+        config.log = &log;
+        config.logged_trial = logged_trial;
+        results = Simulate(*world, config);
+    }
+    delete world;
+
+    EventReader reader(file);
+    PokemonGo pokemon_go(BuildWorld());
+    pokemon_go.Replay(reader, reader.Events().size());
+    // GetScore prints the trainers of the game.
+    ostringstream ignored;
+    streambuf* cout_buffer = cout.rdbuf(ignored.rdbuf());
+    int scores[TEAMS_NUM];
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        scores[team] = pokemon_go.GetScore((Team)team);
+    }
+    cout.rdbuf(cout_buffer);
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        ASSERT_EQUAL(scores[team], results.scores[team][logged_trial]);
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestSimulateSummarize() {
+    SimulationResults results;
+    results.scores.assign(TEAMS_NUM, vector<int>());
+    results.scores[RED] = {7, 1, 3, 5, 9, 2, 4, 8, 6, 10};
+    ScoreSummary summary = results.Summarize(RED);
+    ASSERT_EQUAL(5.5, summary.mean);
+    ASSERT_EQUAL(1, summary.min);
+    ASSERT_EQUAL(5, summary.median);
+    ASSERT_EQUAL(9, summary.p90);
+    ASSERT_EQUAL(10, summary.max);
+    ASSERT_EQUAL(0, results.Summarize(BLUE).max);
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestSimulateInvalidArgs() {
+    World* world = BuildWorld();
+    SimulationConfig config = Config(4, 2);
+    config.spawn = nullptr;
+    ASSERT_THROW(SimulatorInvalidArgsException, Simulate(*world, config));
+    config = Config(-1, 2);
+    ASSERT_THROW(SimulatorInvalidArgsException, Simulate(*world, config));
+    config = Config(4, 2);
+    config.spawn = SpawnUniformly(vector<string>(1, "technion"));
+    ASSERT_THROW(SimulatorLocationNotFoundException, Simulate(*world, config));
+    stringstream file;
+    EventLog log(file);
+    config = Config(4, 2);
+    config.log = &log;
+    config.logged_trial = 4;
+    ASSERT_THROW(SimulatorInvalidArgsException, Simulate(*world, config));
+    ASSERT_THROW(SimulatorInvalidArgsException,
+                 SpawnUniformly(vector<string>()));
+    delete world;
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestSimulateIsReproducible);
+    RUN_TEST(TestSimulateMatchesPokemonGo);
+    RUN_TEST(TestSimulateLogReplaysTrial);
+    RUN_TEST(TestSimulateSummarize);
+    RUN_TEST(TestSimulateInvalidArgs);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,158 @@
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "test_utils.h"
+#include "../pokemon_go.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const char* WORLD_LINES[] = {
+        "GYM taub",
+        "GYM ulman",
+        "POKESTOP mikhlol POTION 10 CANDY 20 CANDY 13 POTION 5",
+        "STARBUCKS shani pikachu 2.5 1 pikachu 1 1 charmander 3.45 1",
+        "STARBUCKS amado squirtle 4 1 bulbasaur 2 1 mew 10 1"};
+static const char* LOCATIONS[] = {"taub", "ulman", "mikhlol", "shani", "amado"};
+static const int LOCATIONS_NUM = 5;
+static const int TRAINERS_NUM = 30;
+static const char* SNAPSHOT_PATH = "snapshot_test.bin";
+static const char* SNAPSHOT_TEMPORARY_PATH = "snapshot_test.bin.tmp";
+//------------------------------------------------------------------------------
+static World* BuildWorld(int locations = LOCATIONS_NUM) {
+    World* world = new World();
+    for (int i = 0; i < locations; ++i) {
+        istringstream input(WORLD_LINES[i]);
+        input >> *world;
+    }
+    for (int i = 0; i < locations; ++i) {
+        world->Connect(LOCATIONS[i], LOCATIONS[(i + 1) % locations],
+                       NORTH, SOUTH);
+    }
+    return world;
+}
+//------------------------------------------------------------------------------
+static void AddTrainers(PokemonGo& pokemon_go, unsigned int seed) {
+    srand(seed);
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        pokemon_go.AddTrainer("trainer" + to_string(i), (Team)(i % TEAMS_NUM),
+                              LOCATIONS[rand() % LOCATIONS_NUM]);
+    }
+}
+//------------------------------------------------------------------------------
+static void MoveTrainers(PokemonGo& pokemon_go, unsigned int seed, int moves) {
+    srand(seed);
+    for (int i = 0; i < moves; ++i) {
+        pokemon_go.MoveTrainer("trainer" + to_string(rand() % TRAINERS_NUM),
+                               rand() % 2);
+    }
+}
+//------------------------------------------------------------------------------
+// Returns the scores, trainers and location trainers of a game.
+static string Describe(PokemonGo& pokemon_go) {
+    // GetScore prints the trainers of the game.
+    ostringstream description, ignored;
+    streambuf* cout_buffer = cout.rdbuf(ignored.rdbuf());
+    for (int team = 0; team < TEAMS_NUM; ++team) {
+        description << pokemon_go.GetScore((Team)team) << endl;
+    }
+    cout.rdbuf(cout_buffer);
+    for (int i = 0; i < LOCATIONS_NUM; ++i) {
+        for (Trainer* trainer : pokemon_go.GetTrainersIn(LOCATIONS[i])) {
+            description << trainer->GetName() << " " << trainer->Location()
+                        << " " << trainer->Level() << " " << trainer->Score()
+                        << " " << trainer->IsGymLeader() << " "
+                        << trainer->HasWonLastBattle() << " "
+                        << trainer->GetItems().size() << endl;
+            if (trainer->HasPokemons()) description << *trainer;
+        }
+    }
+    return description.str();
+}
+//------------------------------------------------------------------------------
+bool TestSnapshotRestore() {
+    PokemonGo original(BuildWorld());
+    AddTrainers(original, 234122);
+    MoveTrainers(original, 1, 300);
+    original.Snapshot(SNAPSHOT_PATH);
+
+    PokemonGo restored(BuildWorld());
+    restored.Restore(SNAPSHOT_PATH);
+    ASSERT_EQUAL(Describe(original), Describe(restored));
+    ASSERT_EQUAL(original.WhereIs("trainer7"), restored.WhereIs("trainer7"));
+
+    // Restoring replaces the trainers and locations of a played game.
+    PokemonGo replaced(BuildWorld());
+    AddTrainers(replaced, 2);
+    MoveTrainers(replaced, 3, 100);
+    replaced.Restore(SNAPSHOT_PATH);
+    ASSERT_EQUAL(Describe(original), Describe(replaced));
+
+    // The restored games go on as the original one.
+    MoveTrainers(original, 4, 300);
+    MoveTrainers(restored, 4, 300);
+    MoveTrainers(replaced, 4, 300);
+    ASSERT_EQUAL(Describe(original), Describe(restored));
+    ASSERT_EQUAL(Describe(original), Describe(replaced));
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestSnapshotRestoreInvalidFile() {
+    PokemonGo original(BuildWorld());
+    AddTrainers(original, 234122);
+    MoveTrainers(original, 1, 100);
+    original.Snapshot(SNAPSHOT_PATH);
+    ifstream input(SNAPSHOT_PATH, ios::binary);
+    string contents((istreambuf_iterator<char>(input)),
+                    istreambuf_iterator<char>());
+    input.close();
+
+    PokemonGo pokemon_go(BuildWorld());
+    AddTrainers(pokemon_go, 2);
+    string description = Describe(pokemon_go);
+    ASSERT_THROW(SnapshotIOException,
+                 pokemon_go.Restore("no_such_snapshot.bin"));
+    string corrupted = contents;
+    corrupted[corrupted.size() / 2] ^= 1;
+    ofstream(SNAPSHOT_PATH, ios::binary) << corrupted;
+    ASSERT_THROW(SnapshotInvalidFileException,
+                 pokemon_go.Restore(SNAPSHOT_PATH));
+    ofstream(SNAPSHOT_PATH, ios::binary) << contents.substr(0, 100);
+    ASSERT_THROW(SnapshotInvalidFileException,
+                 pokemon_go.Restore(SNAPSHOT_PATH));
+    ofstream(SNAPSHOT_PATH, ios::binary) << contents;
+    PokemonGo other_world(BuildWorld(LOCATIONS_NUM - 1));
+    ASSERT_THROW(SnapshotInvalidFileException,
+                 other_world.Restore(SNAPSHOT_PATH));
+    ASSERT_EQUAL(description, Describe(pokemon_go));
+    ASSERT_THROW(SnapshotIOException,
+                 original.Snapshot("no_such_directory/snapshot.bin"));
+
+    // A write that fails leaves the previous snapshot whole.
+    PokemonGo written(BuildWorld());
+    written.Restore(SNAPSHOT_PATH);
+    MoveTrainers(original, 5, 100);
+    ASSERT_EQUAL(0, mkdir(SNAPSHOT_TEMPORARY_PATH, 0700));
+    ASSERT_THROW(SnapshotIOException, original.Snapshot(SNAPSHOT_PATH));
+    ASSERT_EQUAL(0, rmdir(SNAPSHOT_TEMPORARY_PATH));
+    PokemonGo kept(BuildWorld());
+    kept.Restore(SNAPSHOT_PATH);
+    ASSERT_EQUAL(Describe(written), Describe(kept));
+    original.Snapshot(SNAPSHOT_PATH);
+    ASSERT_FALSE(ifstream(SNAPSHOT_TEMPORARY_PATH).good());
+    remove(SNAPSHOT_PATH);
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestSnapshotRestore);
+    RUN_TEST(TestSnapshotRestoreInvalidFile);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+#include <list>
+#include <string>
+#include <vector>
+#include "test_utils.h"
+#include "../starbucks.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Makes a trainer arrive at and leave a Starbucks. Returns the species the
+// trainer caught there, or "" if the trainer caught nothing, and releases the
+// caught Pokemon so the next visit catches into an empty collection.
+static string Visit(Starbucks& starbucks, Trainer& trainer) {
+    starbucks.Arrive(trainer);
+    starbucks.Leave(trainer);
+    if (!trainer.HasPokemons()) {
+        return "";
+    }
+    string species = trainer.GetStrongestPokemon().Species();
+    trainer.KillStrongestPokemon();
+    return species;
+}
+//------------------------------------------------------------------------------
+bool TestStarbucksRefillEmpty() {
+    Starbucks starbucks("shani", list<Pokemon>());
+    Trainer ash("Ash", RED);
+    ASSERT_EQUAL("", Visit(starbucks, ash));
+    starbucks.Refill(vector<Pokemon>({Pokemon("Pikachu", 2.5, 1),
+                                      Pokemon("Charmander", 3.45, 1),
+                                      Pokemon("Squirtle", 4, 1)}));
+    // Every arrival catches exactly one Pokemon, the first in the queue.
+    ASSERT_EQUAL("Pikachu", Visit(starbucks, ash));
+    ASSERT_EQUAL("Charmander", Visit(starbucks, ash));
+    ASSERT_EQUAL("Squirtle", Visit(starbucks, ash));
+    ASSERT_EQUAL("", Visit(starbucks, ash));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestStarbucksRefillAfterWaiting() {
+    Starbucks starbucks("amado", list<Pokemon>({Pokemon("Bulbasaur", 2, 1),
+                                                Pokemon("Mew", 10, 1)}));
+    starbucks.Refill(vector<Pokemon>({Pokemon("Pikachu", 1, 1)}));
+    starbucks.Refill(vector<Pokemon>({Pokemon("Squirtle", 4, 1),
+                                      Pokemon("Charmander", 3, 1)}));
+    Trainer ash("Ash", RED);
+    Trainer gary("Gary", BLUE);
+    // The refills queue after the Pokemons already waiting, in their order.
+    ASSERT_EQUAL("Bulbasaur", Visit(starbucks, ash));
+    ASSERT_EQUAL("Mew", Visit(starbucks, gary));
+    ASSERT_EQUAL("Pikachu", Visit(starbucks, ash));
+    ASSERT_EQUAL("Squirtle", Visit(starbucks, gary));
+    ASSERT_EQUAL("Charmander", Visit(starbucks, ash));
+    ASSERT_EQUAL("", Visit(starbucks, gary));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestStarbucksCatchAboveLevel() {
+    Starbucks starbucks("shani", list<Pokemon>());
+    starbucks.Refill(vector<Pokemon>({Pokemon("Mew", 10, 3),
+                                      Pokemon("Pikachu", 2.5, 1)}));
+    Trainer ash("Ash", RED);
+    // A Pokemon above the level of the trainer stays first in the queue and
+    // the Pokemons behind it wait.
+    ASSERT_EQUAL("", Visit(starbucks, ash));
+    ASSERT_EQUAL("", Visit(starbucks, ash));
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestStarbucksRefillEmpty);
+    RUN_TEST(TestStarbucksRefillAfterWaiting);
+    RUN_TEST(TestStarbucksCatchAboveLevel);
+    return 0;
+}
@@ -26,6 +26,35 @@ bool TestTrainerGetStrongestPokemon() {
 bool TestTrainerKillStrongestPokemon() {
     Trainer ash("Ash", RED);
     ASSERT_THROW(TrainerNoPokemonsFoundException, ash.KillStrongestPokemon());
+    Pokemon pikachu("Pikachu", 15.0, 1);
+    Pokemon raichu("Raichu", 30.0, 1);
+    Pokemon pichu("Pichu", 30.0, 1);
+    ASSERT_TRUE(ash.TryToCatch(pikachu));
+    ASSERT_TRUE(ash.TryToCatch(raichu));
+    ASSERT_TRUE(ash.TryToCatch(pichu));
+    ASSERT_EQUAL(30.0, ash.GetStrongestPokemon().HitPower());
+    ASSERT_NO_THROW(ash.KillStrongestPokemon());
+    ASSERT_EQUAL(30.0, ash.GetStrongestPokemon().HitPower());
+    ASSERT_NO_THROW(ash.KillStrongestPokemon());
+    ASSERT_EQUAL(15.0, ash.GetStrongestPokemon().HitPower());
+    ASSERT_NO_THROW(ash.KillStrongestPokemon());
+    ASSERT_THROW(TrainerNoPokemonsFoundException, ash.GetStrongestPokemon());
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestTrainerCatchAfterKill() {
+    Trainer ash("Ash", RED);
+    Pokemon pikachu("Pikachu", 15.0, 1);
+    Pokemon raichu("Raichu", 30.0, 1);
+    ASSERT_TRUE(ash.TryToCatch(pikachu));
+    for (int i = 0; i < 1000000; ++i) {
+        ASSERT_TRUE(ash.TryToCatch(raichu));
+        ASSERT_EQUAL(30.0, ash.GetStrongestPokemon().HitPower());
+        ASSERT_NO_THROW(ash.KillStrongestPokemon());
+    }
+    ASSERT_EQUAL(15.0, ash.GetStrongestPokemon().HitPower());
+    ASSERT_NO_THROW(ash.KillStrongestPokemon());
+    ASSERT_THROW(TrainerNoPokemonsFoundException, ash.KillStrongestPokemon());
     return true;
 }
 //------------------------------------------------------------------------------
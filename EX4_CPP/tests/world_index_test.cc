@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <queue>
+#include <sstream>
+#include "test_utils.h"
+#include "../pokemon_go.h"
+#include "../exceptions.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+static const int TEAMS_NUM = RED + 1;
+static const int COLUMNS = 6;
+static const int ROWS = 5;
+static const int TRAINERS_NUM = 60;
+typedef mtm::KGraph<std::string,Location*,4>::const_iterator World_Itr;
+//------------------------------------------------------------------------------
+static string Name(int location) {
+    return "l" + to_string(location);
+}
+//------------------------------------------------------------------------------
+// Builds a grid with a gym in every third location and a hole in the middle
+// row, so some locations are reached around the hole.
+static World* BuildGrid() {
+    World* world = new World();
+    for (int i = 0; i < COLUMNS * ROWS; ++i) {
+        istringstream input((i % 3 == 0 ? "GYM " : "POKESTOP ") + Name(i));
+        input >> *world;
+        bool is_hole = i / COLUMNS == ROWS / 2 && i % COLUMNS != 0;
+        if (i % COLUMNS != 0 && !is_hole) {
+            world->Connect(Name(i - 1), Name(i), EAST, WEST);
+        }
+        if (i >= COLUMNS && !is_hole) {
+            world->Connect(Name(i - COLUMNS), Name(i), SOUTH, NORTH);
+        }
+    }
+    return world;
+}
+//------------------------------------------------------------------------------
+// Returns the distance in moves of every location reachable from a location,
+// walking the world graph itself.
+static map<string,int> Distances(const World& world, const string& start) {
+    map<string,int> distances = {{start, 0}};
+    queue<string> locations;
+    locations.push(start);
+    while (!locations.empty()) {
+        string current = locations.front();
+        locations.pop();
+        for (int dir = NORTH; dir <= WEST; ++dir) {
+            World_Itr world_itr = world.BeginAt(current);
+            world_itr.Move(dir);
+            try {
+                if (distances.insert({*world_itr, distances[current] + 1})
+                        .second) {
+                    locations.push(*world_itr);
+                }
+            }
+            catch (mtm::KGraphIteratorReachedEnd) {}
+        }
+    }
+    return distances;
+}
+//------------------------------------------------------------------------------
+bool TestGetTrainersWithin() {
+    World* world = BuildGrid();
+    PokemonGo pokemon_go(world);
+    srand(234122);
+    for (int i = 0; i < TRAINERS_NUM; ++i) {
+        pokemon_go.AddTrainer("trainer" + to_string(i), (Team)(i % TEAMS_NUM),
+                              Name(rand() % (COLUMNS * ROWS)));
+    }
+    for (int start = 0; start < COLUMNS * ROWS; ++start) {
+        map<string,int> distances = Distances(*world, Name(start));
+        ASSERT_TRUE(pokemon_go.GetTrainersIn(Name(start)) ==
+                    pokemon_go.GetTrainersWithin(Name(start), 0));
+        for (int radius = 0; radius <= COLUMNS + ROWS; ++radius) {
+            vector<Trainer*> expected;
+            for (int location = 0; location < COLUMNS * ROWS; ++location) {
+                map<string,int>::iterator it = distances.find(Name(location));
+                if (it == distances.end() || it->second > radius) continue;
+                const vector<Trainer*>& trainers =
+                        pokemon_go.GetTrainersIn(Name(location));
+                expected.insert(expected.end(), trainers.begin(),
+                                trainers.end());
+            }
+            vector<Trainer*> found =
+                    pokemon_go.GetTrainersWithin(Name(start), radius);
+            // Nearest locations first.
+            for (size_t i = 1; i < found.size(); ++i) {
+                ASSERT_TRUE(distances[found[i - 1]->Location()] <=
+                            distances[found[i]->Location()]);
+            }
+            sort(expected.begin(), expected.end());
+            sort(found.begin(), found.end());
+            ASSERT_TRUE(expected == found);
+        }
+    }
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestGetTrainersWithinOrder() {
+    World* world = new World();
+    for (const char* line : {"GYM a", "GYM b", "POKESTOP c", "GYM d"}) {
+        istringstream input(line);
+        input >> *world;
+    }
+    world->Connect("a", "b", EAST, WEST);
+    world->Connect("a", "c", NORTH, SOUTH);
+    world->Connect("c", "d", NORTH, SOUTH);
+    PokemonGo pokemon_go(world);
+    pokemon_go.AddTrainer("ash", RED, "b");
+    pokemon_go.AddTrainer("misty", BLUE, "c");
+    pokemon_go.AddTrainer("brock", YELLOW, "a");
+    pokemon_go.AddTrainer("gary", RED, "c");
+    pokemon_go.AddTrainer("oak", BLUE, "d");
+    string names;
+    for (Trainer* trainer : pokemon_go.GetTrainersWithin("a", 1)) {
+        names += trainer->GetName() + " ";
+    }
+    ASSERT_EQUAL("brock misty gary ash ", names);
+    ASSERT_EQUAL(5, (int)pokemon_go.GetTrainersWithin("a", 2).size());
+    ASSERT_EQUAL(5, (int)pokemon_go.GetTrainersWithin("b", 100).size());
+    ASSERT_THROW(PokemonGoLocationNotFoundException,
+                 pokemon_go.GetTrainersWithin("technion", 1));
+    ASSERT_THROW(PokemonGoInvalidArgsException,
+                 pokemon_go.GetTrainersWithin("a", -1));
+    return true;
+}
+//------------------------------------------------------------------------------
+bool TestGetNearestGym() {
+    World* world = BuildGrid();
+    PokemonGo pokemon_go(world);
+    ASSERT_THROW(PokemonGoGymNotFoundException,
+                 pokemon_go.GetNearestGym(Name(0), RED));
+    // l0, l3, l6, ... are gyms.
+    pokemon_go.AddTrainer("ash", RED, Name(3));
+    pokemon_go.AddTrainer("misty", BLUE, Name(27));
+    pokemon_go.AddTrainer("brock", RED, Name(24));
+    pokemon_go.AddTrainer("gary", RED, Name(1));
+    ASSERT_EQUAL(Name(3), pokemon_go.GetNearestGym(Name(0), RED));
+    ASSERT_EQUAL(Name(3), pokemon_go.GetNearestGym(Name(3), RED));
+    ASSERT_EQUAL(Name(24), pokemon_go.GetNearestGym(Name(25), RED));
+    ASSERT_EQUAL(Name(27), pokemon_go.GetNearestGym(Name(0), BLUE));
+    ASSERT_THROW(PokemonGoGymNotFoundException,
+                 pokemon_go.GetNearestGym(Name(0), YELLOW));
+    ASSERT_THROW(PokemonGoLocationNotFoundException,
+                 pokemon_go.GetNearestGym("technion", RED));
+    pokemon_go.MoveTrainer("ash", EAST);
+    ASSERT_EQUAL(Name(24), pokemon_go.GetNearestGym(Name(5), RED));
+    return true;
+}
+//------------------------------------------------------------------------------
+int main() {
+    RUN_TEST(TestGetTrainersWithin);
+    RUN_TEST(TestGetTrainersWithinOrder);
+    RUN_TEST(TestGetNearestGym);
+    return 0;
+}
+//------------------------------------------------------------------------------
@@ -11,15 +11,11 @@ static const int BASE_SCORE = 0;
 static const int BASE_LEVEL = 1;
 static const int WIN_BONUS = 2;
 static const int LOSS_PENALTY = -1;
-typedef map<int,Pokemon>::const_iterator Map_Iterator;
+typedef mtm::SlotMap<Pokemon>::const_iterator Pokemons_Iterator;
 
-#define MAP_FOREACH(itr_type,itr,map_name) \
-        for (map<itr_type,Pokemon>::iterator itr = map_name.begin(); \
-             itr!=map_name.end() ; ++itr)
-
-#define MAP_FOREACH_CONST(itr_type,itr,map_name) \
-        for (map<itr_type,Pokemon>::const_iterator itr = map_name.begin(); \
-             itr!=map_name.end() ; ++itr)
+#define POKEMONS_FOREACH_CONST(itr,pokemons_name) \
+        for (Pokemons_Iterator itr = pokemons_name.Begin(); \
+             itr!=pokemons_name.End() ; ++itr)
 // -------------------------------------------------------------------------- //
 //                             CONSTRUCTORS                                   //
 // -------------------------------------------------------------------------- //
@@ -43,28 +39,15 @@ Pokemon& Trainer::GetStrongestPokemon() {
 }
 //------------------------------------------------------------------------------
 const Pokemon& Trainer::GetStrongestPokemon() const {
-    if (pokemons.empty()) {
-        throw TrainerNoPokemonsFoundException();
-    }
-    Map_Iterator strongest_itr = pokemons.begin();
-    MAP_FOREACH_CONST(int,iterator,this->pokemons) {
-        if (iterator->second > strongest_itr->second) {
-            strongest_itr = iterator;
-        }
-    }
-    return strongest_itr->second;
+    return *pokemons.Find(GetStrongestPokemonId());
 }
 //------------------------------------------------------------------------------
 void Trainer::KillStrongestPokemon() {
-    Pokemon& strongest_pokemon = GetStrongestPokemon();
-    int pokemon_id = -1;
-    MAP_FOREACH(int,iterator,this->pokemons) {
-        if (strongest_pokemon == iterator->second) {
-            pokemon_id = iterator->first;
-            break;
-        }
-    }
-    this->pokemons.erase(pokemon_id);
+    RemovePokemon(GetStrongestPokemonId());
+}
+//------------------------------------------------------------------------------
+bool Trainer::HasPokemons() const {
+    return !this->pokemons.Empty();
 }
 //------------------------------------------------------------------------------
 bool Trainer::IsAlly(const Trainer& trainer) const {
@@ -79,18 +62,18 @@ bool Trainer::TryToCatch(Pokemon& pokemon) {
     if (pokemon.Level() > this->level) {
         return false;
     }
-    this->pokemons.insert({this->pokemons.size()+1,pokemon});
+    AddPokemon(pokemon);
     return true;
 }
 // -------------------------------------------------------------------------- //
 //                                OPERATORS                                   //
 // -------------------------------------------------------------------------- //
 bool Trainer::operator==(const Trainer& rhs) const {
-    if (this->pokemons.empty() && rhs.pokemons.empty()) {
+    if (this->pokemons.Empty() && rhs.pokemons.Empty()) {
         return true;
-    } else if (this->pokemons.empty() && !rhs.pokemons.empty()) {
+    } else if (this->pokemons.Empty() && !rhs.pokemons.Empty()) {
         return false;
-    } else if (!(this->pokemons.empty()) && rhs.pokemons.empty()) {
+    } else if (!(this->pokemons.Empty()) && rhs.pokemons.Empty()) {
         return false;
     }
     const Pokemon& trainer1_strongest = this->GetStrongestPokemon();
@@ -103,11 +86,11 @@ bool Trainer::operator!=(const Trainer& rhs) const {
 }
 //------------------------------------------------------------------------------
 bool Trainer::operator>(const Trainer& rhs) const {
-    if (!this->pokemons.empty() && rhs.pokemons.empty()) {
+    if (!this->pokemons.Empty() && rhs.pokemons.Empty()) {
         return true;
-    } else if (this->pokemons.empty() && !rhs.pokemons.empty()) {
+    } else if (this->pokemons.Empty() && !rhs.pokemons.Empty()) {
         return false;
-    } else if (this->pokemons.empty() && rhs.pokemons.empty()) {
+    } else if (this->pokemons.Empty() && rhs.pokemons.Empty()) {
         return false;
     } else {
         const Pokemon &trainer1_strongest = this->GetStrongestPokemon();
@@ -132,7 +115,7 @@ bool Trainer::operator>=(const Trainer& rhs) const {
 }
 //------------------------------------------------------------------------------
 ostream& mtm::pokemongo::operator<<(std::ostream& output, const Trainer& trainer) {
-    if (trainer.pokemons.empty()) {
+    if (trainer.pokemons.Empty()) {
         throw TrainerNoPokemonsFoundException();
     }
     string team;
@@ -143,8 +126,8 @@ ostream& mtm::pokemongo::operator<<(std::ostream& output, const Trainer& trainer
     }
     output << trainer.name << " ("
            << trainer.level << ") " << team << endl;
-    MAP_FOREACH_CONST (int,pokemon_iterator,trainer.pokemons) {
-        output << pokemon_iterator->second << endl;
+    POKEMONS_FOREACH_CONST (pokemon_iterator,trainer.pokemons) {
+        output << *pokemon_iterator << endl;
     }
     return output;
 }
@@ -157,17 +140,25 @@ void Trainer::BattleReward(Trainer& other) {
     other.score += LOSS_PENALTY;
 }
 //------------------------------------------------------------------------------
-int Trainer::GetPokemonMapIndex(const Pokemon& pokemon) {
-    MAP_FOREACH_CONST(int,pokemon_iterator,this->pokemons) {
-        if (&pokemon == &pokemon_iterator->second) {
-            return pokemon_iterator->first;
-        }
+Trainer::PokemonId Trainer::GetStrongestPokemonId() const {
+    if (strength_index.empty()) {
+        throw TrainerNoPokemonsFoundException();
     }
-    return -1;
+    return strength_index.begin()->second;
+}
+//------------------------------------------------------------------------------
+void Trainer::AddPokemon(const Pokemon& pokemon) {
+    PokemonId id = this->pokemons.Insert(pokemon);
+    this->strength_index.insert({pokemon.HitPower(),id});
 }
 //------------------------------------------------------------------------------
-void Trainer::RemovePokemon(Pokemon& pokemon) {
-    this->pokemons.erase(GetPokemonMapIndex(pokemon));
+void Trainer::RemovePokemon(const PokemonId& id) {
+    const Pokemon* pokemon = this->pokemons.Find(id);
+    if (pokemon == nullptr) {
+        return;
+    }
+    this->strength_index.erase({pokemon->HitPower(),id});
+    this->pokemons.Remove(id);
 }
 //------------------------------------------------------------------------------
 void Trainer::DetermineByColor(Trainer& trainer1, Trainer& trainer2) {
@@ -184,36 +175,38 @@ void Trainer::DetermineByColor(Trainer& trainer1, Trainer& trainer2) {
 }
 //------------------------------------------------------------------------------
 void Trainer::Battle(Trainer& rival) {
-    if (this->pokemons.empty()) {
+    if (this->pokemons.Empty()) {
         rival.BattleReward(*this);
         return;
     }
-    if (rival.pokemons.empty()) {
+    if (rival.pokemons.Empty()) {
         this->BattleReward(rival);
         return;
     }
-    Pokemon& strongest_self = GetStrongestPokemon();
-    Pokemon& strongest_rival = rival.GetStrongestPokemon();
-    if (this->items.size() != 0) {
-        Item &oldest_item_self = *(this->items.front());
-        oldest_item_self.useItem(strongest_self);
+    PokemonId strongest_self_id = GetStrongestPokemonId();
+    PokemonId strongest_rival_id = rival.GetStrongestPokemonId();
+    Pokemon& strongest_self = *this->pokemons.Find(strongest_self_id);
+    Pokemon& strongest_rival = *rival.pokemons.Find(strongest_rival_id);
+    if (!this->items.empty()) {
+        this->items.front().useItem(strongest_self);
     }
-    if (rival.items.size() != 0) {
-        Item& oldest_item_rival = *(rival.items.front());
-        oldest_item_rival.useItem(strongest_rival);
+    if (!rival.items.empty()) {
+        rival.items.front().useItem(strongest_rival);
     }
     bool is_dead_self = strongest_self.Hit(strongest_rival);
     bool is_dead_rival = strongest_rival.Hit(strongest_self);
+    bool is_self_stronger = strongest_self > strongest_rival;
+    bool is_rival_stronger = strongest_self < strongest_rival;
     if (is_dead_self) {
-        this->RemovePokemon(strongest_self);
+        this->RemovePokemon(strongest_self_id);
     }
     if (is_dead_rival) {
-        rival.RemovePokemon(strongest_rival);
+        rival.RemovePokemon(strongest_rival_id);
     }
-    if (strongest_self > strongest_rival) {
+    if (is_self_stronger) {
         this->BattleReward(rival);
         return;
-    } else if (strongest_self < strongest_rival) {
+    } else if (is_rival_stronger) {
         rival.BattleReward(*this);
         return;
     } else {
@@ -234,10 +227,14 @@ int Trainer::Level() const {
     return this->level;
 }
 //------------------------------------------------------------------------------
-list<Item*> Trainer::GetItems() const {
+const deque<Item>& Trainer::GetItems() const {
     return this->items;
 }
 //------------------------------------------------------------------------------
+void Trainer::AddItem(const Item& item) {
+    this->items.push_back(item);
+}
+//------------------------------------------------------------------------------
 bool Trainer::IsGymLeader() const {
     return this->is_a_gym_leader;
 }
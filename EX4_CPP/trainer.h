@@ -3,11 +3,14 @@
 
 #include <iostream>
 #include <string>
+#include <deque>
 #include <map>
-#include <list>
+#include <set>
+#include <utility>
 #include "pokemon.h"
 #include "exceptions.h"
 #include "item.h"
+#include "slot_map.h"
 
 namespace mtm {
 namespace pokemongo {
@@ -22,6 +25,22 @@ typedef enum {
 class Trainer {
 
 private:
+  // Id of a Pokemon owned by the trainer. Ids are never reused and order
+  // Pokemons by the time they were caught.
+  typedef SlotMap<Pokemon>::Id PokemonId;
+
+  // Key of a Pokemon in the strength index: its hit power and its id.
+  typedef std::pair<double,PokemonId> StrengthKey;
+
+  // Orders Pokemons from strongest to weakest. Pokemons of equal strength are
+  // ordered by their id, i.e. from least recently caught to most recently.
+  struct StrongerFirst {
+    bool operator()(const StrengthKey& lhs, const StrengthKey& rhs) const {
+      if (lhs.first != rhs.first) return lhs.first > rhs.first;
+      return lhs.second < rhs.second;
+    }
+  };
+
   std::string name;
   std::string location;
   Team team;
@@ -29,13 +48,14 @@ private:
   int score;
   bool has_won_last_battle;
   bool is_a_gym_leader;
-  std::map<int,Pokemon> pokemons;
-  std::list<Item*> items;
+  SlotMap<Pokemon> pokemons;
+  std::set<StrengthKey,StrongerFirst> strength_index;
+  std::deque<Item> items;
 
   void BattleReward(Trainer& other);
-  void CheckIfDead(Pokemon& pokemon);
-  void RemovePokemon(Pokemon& pokemon);
-  int GetPokemonMapIndex(const Pokemon& pokemon);
+  void AddPokemon(const Pokemon& pokemon);
+  void RemovePokemon(const PokemonId& id);
+  PokemonId GetStrongestPokemonId() const;
   static void DetermineByColor(Trainer& trainer1, Trainer& trainer2);
 //------------------------------------------------------------------------------
  public:
@@ -62,6 +82,11 @@ private:
   // @throw TrainerNoPokemonsException if trainer has no Pokemons.
   void KillStrongestPokemon();
 
+  // Checks whether the trainer owns any Pokemons.
+  //
+  // @return true iff the trainer owns at least one Pokemon.
+  bool HasPokemons() const;
+
   // Comparison operators for trainers. Trainers are compared as described in
   // the exercise sheet.
   //
@@ -112,17 +137,26 @@ private:
   // @return the output stream to which the data is printed.
   friend std::ostream& operator<<(std::ostream& output, const Trainer& trainer);
 
+  // Saves and restores the state of trainers.
+  friend class SnapshotFile;
+
   void Battle(Trainer& other);
   int Score() const;
   int Level() const;
-  std::list<Item*> GetItems() const;
+  const std::deque<Item>& GetItems() const;
+
+  // Gives the trainer an item. Items are used in battle from the least
+  // recently received to the most recently received.
+  //
+  // @param item the item to give.
+  void AddItem(const Item& item);
   bool IsGymLeader() const;
   bool HasWonLastBattle() const;
   void SetLocation(const std::string& location);
   void SetAsGymLeader();
   void UnsetAsGymLeader();
   const std::string& Location() const;
-  std::string GetName() { return this->name; }
+  const std::string& GetName() const { return this->name; }
 };
 
 std::ostream& operator<<(std::ostream& output, const Trainer& trainer);
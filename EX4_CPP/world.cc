@@ -55,9 +55,8 @@ void World::handleStarbucksLine(std::istream& input, string& current_word) {
         Pokemon pokemon(pokemon_species,pokemon_cp,pokemon_level);
         pokemons.push_back(pokemon);
     }
-    Location* new_location = new Starbucks(location_name,pokemons);
-    locations_to_free.push_back(location_name);
-    this->Insert(location_name,new_location);
+    starbucks.emplace_back(location_name,pokemons);
+    this->Insert(location_name,&starbucks.back());
 }
 //------------------------------------------------------------------------------
 void World::handlePokestopLine(std::istream& input, string& current_word) {
@@ -65,7 +64,7 @@ void World::handlePokestopLine(std::istream& input, string& current_word) {
     int item_level;
     input >> current_word;
     location_name = current_word;
-    std::list<Item*> items;
+    std::vector<Item> items;
     if (isLocationAlreadyExist(*this,location_name)) {
         throw WorldLocationNameAlreadyUsed();
     }
@@ -75,17 +74,15 @@ void World::handlePokestopLine(std::istream& input, string& current_word) {
         if (!IsValidNumber(current_word)) throw WorldInvalidInputLineException();
         item_level = stoi(current_word);
         if (item_name == "CANDY") {
-            Candy candy(item_level);
-            items.push_back(new Candy(item_level));
+            items.push_back(Candy(item_level));
         } else if (item_name == "POTION") {
-            items.push_back(new Potion(item_level));
+            items.push_back(Potion(item_level));
         } else {
             throw WorldInvalidInputLineException();
         }
     }
-    Location* new_location = new Pokestop(location_name,items);
-    locations_to_free.push_back(location_name);
-    this->Insert(location_name,new_location);
+    pokestops.emplace_back(location_name,items);
+    this->Insert(location_name,&pokestops.back());
 }
 //------------------------------------------------------------------------------
 void World::handleGymLine(std::istream& input, string& current_word) {
@@ -95,9 +92,23 @@ void World::handleGymLine(std::istream& input, string& current_word) {
     }
     input >> current_word;
     location_name = current_word;
-    Location* new_location = new Gym(location_name);
-    locations_to_free.push_back(location_name);
-    this->Insert(location_name,new_location);
+    gyms.emplace_back(location_name);
+    this->Insert(location_name,&gyms.back());
+}
+//------------------------------------------------------------------------------
+unique_ptr<Location> World::CopyOf(const Location& location) {
+    switch (location.Kind()) {
+        case GYM:
+            return unique_ptr<Location>(
+                    new Gym(static_cast<const Gym&>(location)));
+        case POKESTOP:
+            return unique_ptr<Location>(
+                    new Pokestop(static_cast<const Pokestop&>(location)));
+        case STARBUCKS:
+            return unique_ptr<Location>(
+                    new Starbucks(static_cast<const Starbucks&>(location)));
+    }
+    return nullptr;
 }
 //------------------------------------------------------------------------------
 istream& mtm::pokemongo::operator>>(std::istream& input, World& world) {
@@ -1,8 +1,10 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <deque>
 #include <iostream>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include "pokestop.h"
 #include "starbucks.h"
@@ -23,7 +25,12 @@ class World : public KGraph<std::string,Location*,4> {
 
  private:
 
-  std::vector<std::string> locations_to_free;
+  // The locations of the world, one container per kind. The graph maps every
+  // location name to the address of its element, which a deque never moves.
+  std::deque<Gym> gyms;
+  std::deque<Pokestop> pokestops;
+  std::deque<Starbucks> starbucks;
+
   void handleGymLine(std::istream& string_stream, std::string& current_word);
   void handleStarbucksLine(std::istream& string_stream, std::string& current_word);
   void handlePokestopLine(std::istream& string_stream, std::string& current_word);
@@ -33,13 +40,14 @@ public:
   World();
   
   // A destructor.
-  ~World() {
-    for (std::vector<std::string>::iterator it = locations_to_free.begin();
-            it != locations_to_free.end(); ++it) {
-      delete(this->operator[](*it));
-    }
-  }
-  
+  ~World() = default;
+
+  // Returns a copy of a location of the world, of the location's kind.
+  //
+  // @param location a location of the world.
+  // @return the copy.
+  static std::unique_ptr<Location> CopyOf(const Location& location);
+
   // Input iterator. Scans a single line from the input stream. The line can be
   // one of the following three options:
   //
@@ -68,6 +76,12 @@ public:
   //        the given name in the world.
   friend std::istream& operator>>(std::istream& input, World& world);
 
+  // Saves and restores the state of the locations of the world.
+  friend class SnapshotFile;
+
+  // Indexes the locations of the world and the connections between them.
+  friend class WorldIndex;
+
   // Disable copy constructor.
   World(const World& world) = delete;
 
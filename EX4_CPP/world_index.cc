@@ -0,0 +1,145 @@
+// -------------------------------------------------------------------------- //
+//                             INCLUDES & DEFINES                             //
+// -------------------------------------------------------------------------- //
+#include <algorithm>
+#include "world_index.h"
+
+using namespace mtm::pokemongo;
+using namespace std;
+
+typedef mtm::KGraph<std::string,Location*,4>::const_iterator World_Itr;
+
+const int WorldIndex::DIRECTIONS_NUM;
+const uint32_t WorldIndex::NO_LOCATION;
+// -------------------------------------------------------------------------- //
+//                             AUX FUNCTIONS                                  //
+// -------------------------------------------------------------------------- //
+namespace {
+    // The buffers of the searches of a thread. A location was visited by the
+    // current search iff its stamp is the epoch of the search, so the stamps
+    // are cleared only when the epoch wraps around.
+    struct SearchBuffers {
+        vector<uint32_t> stamps;
+        uint32_t epoch = 0;
+        vector<uint32_t> queue;
+    };
+
+    SearchBuffers& searchBuffers() {
+        static thread_local SearchBuffers buffers;
+        return buffers;
+    }
+}
+// -------------------------------------------------------------------------- //
+//                             CONSTRUCTORS                                   //
+// -------------------------------------------------------------------------- //
+WorldIndex::WorldIndex(const World& world) {
+    size_t size = world.nodes_.size();
+    names.reserve(size);
+    locations.reserve(size);
+    numbers.reserve(size);
+    for (const pair<const string,World::Node*>& node : world.nodes_) {
+        numbers[node.first] = (uint32_t)names.size();
+        names.push_back(&node.first);
+        locations.push_back(world[node.first]);
+    }
+    neighbours.assign(DIRECTIONS_NUM * size, NO_LOCATION);
+    World_Itr end = world.End();
+    for (size_t i = 0; i < size; ++i) {
+        World_Itr location_itr = world.BeginAt(*names[i]);
+        for (int dir = 0; dir < DIRECTIONS_NUM; ++dir) {
+            World_Itr world_itr(location_itr);
+            world_itr.Move(dir);
+            if (world_itr != end) {
+                neighbours[DIRECTIONS_NUM * i + dir] = numbers[*world_itr];
+            }
+        }
+    }
+}
+// -------------------------------------------------------------------------- //
+//                                FUNCTIONS                                   //
+// -------------------------------------------------------------------------- //
+uint32_t WorldIndex::NumberOf(const std::string& location) const {
+    unordered_map<string,uint32_t>::const_iterator it = numbers.find(location);
+    if (it == numbers.end()) {
+        throw PokemonGoLocationNotFoundException();
+    }
+    return it->second;
+}
+//------------------------------------------------------------------------------
+template <typename Visit>
+uint32_t WorldIndex::Search(uint32_t start, int radius, Visit visit) const {
+    SearchBuffers& buffers = searchBuffers();
+    vector<uint32_t>& stamps = buffers.stamps;
+    vector<uint32_t>& queue = buffers.queue;
+    if (stamps.size() < locations.size()) {
+        stamps.resize(locations.size(), 0);
+    }
+    if (++buffers.epoch == 0) {
+        fill(stamps.begin(), stamps.end(), 0);
+        buffers.epoch = 1;
+    }
+    uint32_t epoch = buffers.epoch;
+    queue.clear();
+    queue.push_back(start);
+    stamps[start] = epoch;
+    // The locations at the current distance end at queue[distance_end].
+    size_t distance_end = 1;
+    int distance = 0;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        if (head == distance_end) {
+            distance++;
+            distance_end = queue.size();
+        }
+        uint32_t current = queue[head];
+        if (visit(current)) {
+            return current;
+        }
+        if (distance == radius) continue;
+        const uint32_t* next = &neighbours[DIRECTIONS_NUM * current];
+        for (int dir = 0; dir < DIRECTIONS_NUM; ++dir) {
+            if (next[dir] != NO_LOCATION && stamps[next[dir]] != epoch) {
+                stamps[next[dir]] = epoch;
+                queue.push_back(next[dir]);
+            }
+        }
+    }
+    return NO_LOCATION;
+}
+//------------------------------------------------------------------------------
+vector<Trainer*> WorldIndex::TrainersWithin(const std::string& location,
+                                            int radius) const {
+    uint32_t start = NumberOf(location);
+    if (radius < 0) {
+        throw PokemonGoInvalidArgsException();
+    }
+    vector<Trainer*> trainers;
+    Search(start, radius, [&](uint32_t number) {
+        const vector<Trainer*>& location_trainers =
+                locations[number]->GetTrainers();
+        trainers.insert(trainers.end(), location_trainers.begin(),
+                        location_trainers.end());
+        return false;
+    });
+    return trainers;
+}
+//------------------------------------------------------------------------------
+const string& WorldIndex::NearestGym(const std::string& location,
+                                     const Team& team) const {
+    uint32_t gym = Search(NumberOf(location), -1, [&](uint32_t number) {
+        if (locations[number]->Kind() != GYM) {
+            return false;
+        }
+        const Trainer* leader =
+                static_cast<const Gym*>(locations[number])->GetLeader();
+        return leader != nullptr && leader->GetTeam() == team;
+    });
+    if (gym == NO_LOCATION) {
+        throw PokemonGoGymNotFoundException();
+    }
+    return *names[gym];
+}
+//------------------------------------------------------------------------------
+size_t WorldIndex::Size() const {
+    return locations.size();
+}
+//------------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+#ifndef WORLD_INDEX_H
+#define WORLD_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "world.h"
+
+namespace mtm {
+namespace pokemongo {
+
+// A dense index of the topology of a world for hop-distance queries. Every
+// location gets a number, and the index keeps the neighbours of every location
+// in every direction, so a search walks arrays instead of looking up names in
+// the graph.
+//
+// The index is built once and is not updated: the world must not be connected,
+// disconnected or added to while the index is in use. The locations themselves
+// (their trainers, gym leaders, etc.) may change. Queries only read the index,
+// and every thread keeps its own search buffers, so any number of threads may
+// query an index at once, provided no thread changes the locations.
+class WorldIndex {
+ public:
+  static const int DIRECTIONS_NUM = 4;
+
+  // Indexes the locations of a world and the connections between them.
+  //
+  // @param world the world.
+  explicit WorldIndex(const World& world);
+
+  // Disable copy and assignment.
+  WorldIndex(const WorldIndex&) = delete;
+  WorldIndex& operator=(const WorldIndex&) = delete;
+
+  // Returns the trainers at the locations at most radius moves away from a
+  // location, nearest locations first. Locations at the same distance are in
+  // the order a breadth-first search finds them, trying the directions from
+  // NORTH to WEST, and the trainers of every location are in the order of
+  // Location::GetTrainers.
+  //
+  // @param location the name of the location.
+  // @param radius the largest number of moves.
+  // @return the trainers.
+  // @throw PokemonGoLocationNotFoundException if the location does not exist.
+  // @throw PokemonGoInvalidArgsException if radius is negative.
+  std::vector<Trainer*> TrainersWithin(const std::string& location,
+                                       int radius) const;
+
+  // Returns the name of the gym led by a trainer of a team which is the
+  // fewest moves away from a location. Gyms at the same distance are ordered
+  // as in TrainersWithin.
+  //
+  // @param location the name of the location.
+  // @param team the team.
+  // @return the name of the gym.
+  // @throw PokemonGoLocationNotFoundException if the location does not exist.
+  // @throw PokemonGoGymNotFoundException if no gym led by the team can be
+  //        reached from the location.
+  const std::string& NearestGym(const std::string& location,
+                                const Team& team) const;
+
+  // Returns the number of locations in the index.
+  size_t Size() const;
+
+ private:
+  static const uint32_t NO_LOCATION = UINT32_MAX;
+
+  std::vector<const std::string*> names;
+  std::vector<Location*> locations;
+  // neighbours[DIRECTIONS_NUM * i + dir] is the number of the location in
+  // direction dir of location i, or NO_LOCATION.
+  std::vector<uint32_t> neighbours;
+  std::unordered_map<std::string,uint32_t> numbers;
+
+  uint32_t NumberOf(const std::string& location) const;
+
+  // Visits the locations in breadth-first order, up to radius moves away
+  // (or all if radius is negative), until visit returns true. Returns the
+  // number of the location for which visit returned true, or NO_LOCATION.
+  template <typename Visit>
+  uint32_t Search(uint32_t start, int radius, Visit visit) const;
+};
+
+}  // namespace pokemongo
+}  // namespace mtm
+
+#endif  // WORLD_INDEX_H